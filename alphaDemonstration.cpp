@@ -10,6 +10,7 @@
 #include "source/simulation/Simulation.hpp"
 #include "source/simulation/circular_buffer.h"
 #include "source/simulation/simulation_state.h"
+#include "source/entity/decision_center/biology.hpp"
 
 
 /** Capture a lightweight SimulationState snapshot from the live simulation. */
@@ -21,8 +22,7 @@ static SimulationState capture_state(Simulation& sim, uint64_t tick) {
 
     Entity* primary = sim.get_primary_entity();
     if (primary) {
-        auto metrics = primary->biology_get_metrics();
-        state.averageAgentEnergy = metrics["Energy"];
+        state.averageAgentEnergy = primary->biology_view().metrics.energy;
         state.averageFitness     = 0.0;
     }
 
@@ -0,0 +1,500 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <iomanip>
+#include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <new>
+
+#include "source/simulation/Simulation.hpp"
+#include "source/simulation/circular_buffer.h"
+#include "source/simulation/simulation_state.h"
+#include "source/simulation/frame_renderer.h"
+#include "source/environment/Environment.h"
+#include "source/environment/PerlinNoise.hpp"
+#include "source/environment/resource_node.h"
+#include "source/entity/perception_movement/perception.hpp"
+#include "source/entity/perception_movement/movement.hpp"
+#include "source/entity/decision_center/brain.hpp"
+#include "source/entity/decision_center/biology.hpp"
+#include "source/entity/decision_center/biology_store.hpp"
+#include "source/entity/decision_center/mutate.hpp"
+#include "source/entity/decision_center/rng.hpp"
+
+/*Microbenchmarks for the per-tick hot paths:
+1. Every benchmark has fixed inputs (seeded RNG and rand()), so two runs of the same binary
+   measure the same work and runs across commits can be diffed.
+2. Each benchmark is calibrated to a batch that takes at least --min-time ms, then timed over
+   --samples batches; the JSON reports ns per operation (median, min, mean, stddev).
+3. JSON goes to stdout (or --out FILE), a readable table goes to stderr.
+4. operator new is replaced with a counting version, so every benchmark also reports heap
+   allocations per operation.
+*/
+
+using Clock = std::chrono::steady_clock;
+
+/** Heap allocations made by this process so far. */
+static std::atomic<uint64_t> allocation_count{0};
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+/** Keeps the optimizer from discarding a benchmark's result. */
+template <typename T>
+static inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/** Escapes quotes, backslashes and control characters for a JSON string. */
+static std::string json_escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", c);
+            out += code;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;        // Operations per sample
+    std::vector<double> ns_per_op;  // One entry per sample
+    double allocs_per_op = 0.0;     // Heap allocations per operation over all samples
+};
+
+struct BenchOptions {
+    std::string filter;
+    double min_time_ms = 20.0;
+    int samples = 7;
+};
+
+class BenchSuite {
+private:
+    BenchOptions _options;
+    std::vector<BenchResult> _results;
+
+public:
+    explicit BenchSuite(const BenchOptions& options) : _options(options) {}
+
+    bool selected(const std::string& name) const {
+        return _options.filter.empty() || name.find(_options.filter) != std::string::npos;
+    }
+
+    /** Times op(); setup work belongs outside op, it is not measured. */
+    void run(const std::string& name, const std::function<void()>& op) {
+        if (!selected(name)) {
+            return;
+        }
+        // Calibrate (this doubles as warmup): double the batch until it takes at least
+        // min_time_ms, then trim it to roughly min_time_ms
+        uint64_t iterations = 1;
+        const double target_ns = _options.min_time_ms * 1e6;
+        double ns = 0.0;
+        while (iterations < (1ull << 30)) {
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < iterations; ++i) op();
+            ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            if (ns >= target_ns) {
+                iterations = std::max<uint64_t>(1, static_cast<uint64_t>(iterations * target_ns / ns));
+                break;
+            }
+            iterations *= 2;
+        }
+
+        BenchResult result;
+        result.name = name;
+        result.iterations = iterations;
+        uint64_t allocations = 0;
+        for (int s = 0; s < _options.samples; ++s) {
+            const uint64_t allocated = allocation_count.load(std::memory_order_relaxed);
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < iterations; ++i) op();
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            allocations += allocation_count.load(std::memory_order_relaxed) - allocated;
+            result.ns_per_op.push_back(ns / iterations);
+        }
+        result.allocs_per_op = static_cast<double>(allocations) / (static_cast<double>(iterations) * _options.samples);
+
+        std::vector<double> sorted = result.ns_per_op;
+        std::sort(sorted.begin(), sorted.end());
+        std::fprintf(stderr, "%-48s %14.1f ns/op  %8.2f allocs/op  (min %.1f, %llu ops x %d)\n", name.c_str(),
+                     sorted[sorted.size() / 2], result.allocs_per_op, sorted.front(),
+                     static_cast<unsigned long long>(iterations), _options.samples);
+        _results.push_back(std::move(result));
+    }
+
+    void write_json(std::ostream& out, const std::string& label) const {
+        out << "{\n";
+        out << std::fixed << std::setprecision(1);
+        out << "  \"label\": \"" << json_escape(label) << "\",\n";
+#if defined(__clang__)
+        out << "  \"compiler\": \"clang " << __clang_major__ << "." << __clang_minor__ << "\",\n";
+#elif defined(__GNUC__)
+        out << "  \"compiler\": \"gcc " << __GNUC__ << "." << __GNUC_MINOR__ << "\",\n";
+#else
+        out << "  \"compiler\": \"unknown\",\n";
+#endif
+#ifdef NDEBUG
+        out << "  \"assertions\": false,\n";
+#else
+        out << "  \"assertions\": true,\n";
+#endif
+        out << "  \"timestamp\": " << static_cast<long long>(std::time(nullptr)) << ",\n";
+        out << "  \"min_time_ms\": " << _options.min_time_ms << ",\n";
+        out << "  \"benchmarks\": [";
+        for (size_t r = 0; r < _results.size(); ++r) {
+            const BenchResult& res = _results[r];
+            std::vector<double> sorted = res.ns_per_op;
+            std::sort(sorted.begin(), sorted.end());
+            double mean = 0.0;
+            for (double v : sorted) mean += v;
+            mean /= sorted.size();
+            double var = 0.0;
+            for (double v : sorted) var += (v - mean) * (v - mean);
+            double stddev = sorted.size() > 1 ? std::sqrt(var / (sorted.size() - 1)) : 0.0;
+
+            out << (r ? ",\n" : "\n");
+            out << "    {\"name\": \"" << json_escape(res.name) << "\", \"iterations\": " << res.iterations
+                << ", \"samples\": " << sorted.size()
+                << ", \"ns_per_op\": {\"median\": " << sorted[sorted.size() / 2]
+                << ", \"min\": " << sorted.front() << ", \"mean\": " << mean
+                << ", \"stddev\": " << stddev << "}"
+                << ", \"allocs_per_op\": " << std::setprecision(3) << res.allocs_per_op << std::setprecision(1) << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+};
+
+/** Seeds resources the way Simulation::seed_resources does, at roughly `count` nodes. */
+static void fill_resources(ResourceManager& manager, int count, int side) {
+    manager.clear();
+    for (int n = 0; n < count; ++n) {
+        Position pos(rng::next_int(side), rng::next_int(side));
+        if (manager.getResourceAtPosition(pos)) continue;
+        manager.createResource(pos, static_cast<ResourceType>(rng::next_int(2)), rng::unit(), rng::next_int(2) == 0);
+    }
+}
+
+static void print_usage(const char* prog) {
+    std::cout
+        << "Usage: " << prog << " [options]\n"
+        << "\nOptions:\n"
+        << "  --filter TEXT     Only run benchmarks whose name contains TEXT\n"
+        << "  --min-time MS     Minimum time per sample                (default: 20)\n"
+        << "  --samples N       Timed samples per benchmark            (default: 7)\n"
+        << "  --out FILE        Write JSON to FILE instead of stdout\n"
+        << "  --label TEXT      Label stored in the JSON (e.g. a commit hash)\n"
+        << "  --help            Show this help message\n";
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    std::string out_path;
+    std::string label;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            options.min_time_ms = std::stod(argv[++i]);
+        } else if (arg == "--samples" && i + 1 < argc) {
+            options.samples = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--out" && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (arg == "--label" && i + 1 < argc) {
+            label = argv[++i];
+        } else if (arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Setup code logs to cout; keep it out of the JSON
+    std::streambuf* original = std::cout.rdbuf();
+    std::ostringstream discard;
+    std::cout.rdbuf(discard.rdbuf());
+
+    // Fixed inputs: terrain types come from rand(), everything else from rng
+    std::srand(1);
+    rng::seed(1);
+    BenchSuite suite(options);
+
+    // ---- Brain::decide ----
+    for (const std::vector<int>& sizes : std::vector<std::vector<int>>{{28, 8, 8, 6}, {128, 64, 64, 6}, {128, 200, 200, 6}, {128, 200, 200, Simulation::BRAIN_OUTPUTS}}) {
+        std::string shape;
+        for (size_t l = 0; l < sizes.size(); ++l) shape += (l ? "-" : "") + std::to_string(sizes[l]);
+        Brain brain(sizes);
+        std::vector<double> input(sizes[0]);
+        for (double& v : input) v = rng::unit();
+        suite.run("brain_decide/" + shape, [&] { int d = brain.decide(input); keep(d); });
+    }
+
+    // ---- Perception on a 32x32 environment with ~10% resource tiles ----
+    Environment environment(32, 32);
+    PerlinNoise2d perlin(1234, 0.025, 1.0, 8);
+    for (int x = 0; x < 32; ++x)
+        for (int y = 0; y < 32; ++y)
+            environment.setTileValue(Vector2d(x, y), perlin.SampleLayered(Vector2d(x, y)), 0);
+    ResourceManager resources;
+    fill_resources(resources, 102, 32);
+    Perception perception;
+    for (int radius : {2, 4}) {
+        suite.run("perception/perceive_local_tiles/r" + std::to_string(radius), [&] {
+            auto in = Perception::perceive_local_tiles(16, 16, environment, radius);
+            keep(in);
+        });
+    }
+    for (const char* type : {"Food", "Terrain Efficiency 1"}) {
+        suite.run(std::string("perception/extract_of_type/") + type, [&] {
+            auto values = perception.extract_tile_values_in_radius_of_type(16, 16, environment, 2, resources, type);
+            keep(values);
+        });
+    }
+
+    // ---- Simulation-owned paths ----
+    Simulation sim;
+    sim.initialize();
+    auto founder = std::make_unique<Entity>();
+    {
+        Entity* primary = sim.get_primary_entity();
+        founder->set_brain(std::make_shared<Brain>(*primary->get_brain()));
+        founder->set_biology(std::make_shared<Biology>(*primary->get_biology()));
+    }
+
+    {
+        FrameRenderer renderer;
+        suite.run("render/simulation_frame/32", [&] {
+            sim.render_frame(renderer);
+            const std::string& bytes = renderer.compose_full();
+            keep(bytes);
+        });
+    }
+
+    std::vector<double> tiles(28);
+    for (double& v : tiles) v = rng::unit();
+    for (int ignore : {1, 12, 24}) {
+        suite.run("filter_perception/ignore" + std::to_string(ignore), [&] {
+            auto filtered = sim.filter_perception(tiles, ignore);
+            keep(filtered);
+        });
+    }
+
+    // ---- ResourceManager at increasing density ----
+    for (int count : {100, 1000, 10000}) {
+        const int side = static_cast<int>(std::sqrt(count * 10.0));
+        ResourceManager manager;
+        fill_resources(manager, count, side);
+        int probe = 0;
+        suite.run("resources/get_at_position/n" + std::to_string(count), [&] {
+            probe = (probe + 7919) % (side * side);
+            ResourceNode* node = manager.getResourceAtPosition(Position(probe % side, probe / side));
+            keep(node);
+        });
+        suite.run("resources/find_in_range_r5/n" + std::to_string(count), [&] {
+            probe = (probe + 7919) % (side * side);
+            auto found = manager.findResourcesInRange(Position(probe % side, probe / side), 5);
+            keep(found);
+        });
+        suite.run("resources/find_nearest/n" + std::to_string(count), [&] {
+            probe = (probe + 7919) % (side * side);
+            ResourceNode* node = manager.findNearestResource(Position(probe % side, probe / side), 0);
+            keep(node);
+        });
+    }
+
+    // ---- Movement: the legacy vector-returning step, the POD step, and a batched SoA pass ----
+    {
+        const Movement::Grid grid = Movement::Grid::make(32, 32);
+        int x = 5, y = 9, turn = 0;
+        double energy = 1.0;
+        suite.run("movement/execute_wraparound", [&] {
+            turn = (turn + 1) & 7;
+            Movement::Action action = Movement::direction_to_action(static_cast<Movement::Direction>(turn), 0);
+            std::vector<int> coords = Movement::execute_movement_wraparound(x, y, action, 32, 32, energy);
+            keep(coords);
+        });
+        suite.run("movement/step_wraparound", [&] {
+            turn = (turn + 1) & 7;
+            Movement::Step step = Movement::step_wraparound(x, y, static_cast<Movement::Direction>(turn), grid, energy, 0);
+            x = step.x;
+            y = step.y;
+            keep(step);
+        });
+    }
+    for (int side : {32, 100}) {
+        const size_t count = 10000;
+        const Movement::Grid grid = Movement::Grid::make(side, side);
+        std::vector<int> xs(count), ys(count);
+        std::vector<double> energy(count, 1e9);
+        std::vector<uint8_t> directions(count);
+        for (size_t i = 0; i < count; ++i) {
+            xs[i] = static_cast<int>(i * 7919 % side);       // Fixed pattern; leaves the rng stream alone
+            ys[i] = static_cast<int>(i * 104729 % side);
+            directions[i] = static_cast<uint8_t>(i * 31 % Movement::DIRECTION_COUNT);
+        }
+        suite.run("movement/apply_moves_10k/" + std::to_string(side), [&] {
+            size_t moved = Movement::apply_moves(xs.data(), ys.data(), energy.data(), directions.data(), count, grid, 0.1);
+            keep(moved);
+        });
+    }
+
+    // ---- Metabolism for 10k creatures: Biology::update per object vs one BiologyStore::tick ----
+    {
+        const size_t count = 10000;
+        std::vector<Biology> objects(count, Biology(true));
+        for (size_t i = 0; i < count; ++i) {
+            objects[i].set_efficiency("Mass", 0.3 + 0.4 * static_cast<double>(i % 97) / 97.0);
+        }
+        std::vector<Biology> bound(objects);
+        BiologyStore store;
+        for (auto& biology : bound) {
+            store.bind(&biology);
+        }
+        suite.run("biology/update_10k", [&] {
+            for (auto& biology : objects) {
+                biology.add_energy(1.0);
+                biology.update();
+            }
+            keep(objects.back().get_health());
+            discard.str("");
+        });
+        suite.run("biology/store_tick_10k", [&] {
+            for (size_t row = 0; row < count; ++row) {
+                store.energy(row) += 1.0;
+            }
+            size_t dead = store.tick();
+            keep(dead);
+        });
+    }
+
+    // ---- Per-tick biology queries: the map-returning debug adapters vs BiologyView ----
+    {
+        Entity& entity = *founder;
+        suite.run("biology/map_queries", [&] {
+            double sum = entity.biology_get_metrics()["Energy"] + entity.biology_get_metrics()["Health"]
+                + entity.biology_get_metrics()["Water"] + entity.biology_get_genetic_value("Vision")
+                + entity.biology_get_genetic_value("Mass");
+            keep(sum);
+        });
+        suite.run("biology/view_queries", [&] {
+            const BiologyView view = entity.biology_view();
+            double sum = view.metrics.energy + view.metrics.health + view.metrics.water
+                + view.genes[GENE_VISION] + view.genes[GENE_MASS];
+            keep(sum);
+        });
+    }
+
+    // ---- PerlinNoise2d::SampleLayered (8 octaves, as Simulation::initialize uses) ----
+    {
+        int step = 0;
+        suite.run("perlin/sample_layered/8oct", [&] {
+            step = (step + 1) & 1023;
+            double v = perlin.SampleLayered(Vector2d(step & 31, step >> 5));
+            keep(v);
+        });
+    }
+
+    // ---- FrameRenderer at 256x256: full frames and deltas with ~1% of cells changing ----
+    {
+        const int side = 256;
+        FrameRenderer renderer;
+        renderer.resize(side, side);
+        for (int y = 0; y < side; ++y)
+            for (int x = 0; x < side; ++x) {
+                double v = perlin.SampleLayered(Vector2d(x, y));
+                uint8_t c = static_cast<uint8_t>(std::clamp(static_cast<int>((v + 2.0) / 4.0 * 255), 0, 255));
+                renderer.set(x, y, FrameCell{c, static_cast<uint8_t>(255 - c), static_cast<uint8_t>(255 - c), FrameCell::SHADE});
+            }
+        suite.run("render/compose_full/256", [&] {
+            const std::string& bytes = renderer.compose_full();
+            keep(bytes);
+        });
+        renderer.compose_delta();
+        int frame = 0;
+        suite.run("render/compose_delta_1pct/256", [&] {
+            ++frame;
+            for (int n = 0; n < side * side / 100; ++n) {
+                int cell = (n * 7919 + frame * 104729) % (side * side);
+                renderer.set(cell % side, cell / side, FrameCell{static_cast<uint8_t>(frame), 0, 0, FrameCell::SOLID});
+            }
+            const std::string& bytes = renderer.compose_delta();
+            keep(bytes);
+        });
+    }
+
+    // ---- CircularBuffer::push ----
+    {
+        CircularBuffer<SimulationState> buffer(1000);
+        SimulationState state;
+        suite.run("circular_buffer/push", [&] {
+            ++state.tick;
+            buffer.push(state);
+        });
+    }
+
+    // ---- mutate_vector ----
+    for (size_t n : {size_t{1000}, size_t{66000}}) {
+        std::vector<double> genome(n, 0.5);
+        suite.run("mutate_vector/n" + std::to_string(n), [&] {
+            auto mutated = mutate_vector(genome);
+            keep(mutated);
+        });
+    }
+
+    // ---- Simulation::tick, restarting the entity when it dies ----
+    {
+        sim.seed_resources();
+        sim.set_primary_entity(*founder);
+        suite.run("simulation/tick", [&] {
+            if (sim.tick(0) == -1) {
+                sim.set_primary_entity(*founder);
+            }
+            discard.str("");
+        });
+    }
+
+    std::cout.rdbuf(original);
+
+    if (out_path.empty()) {
+        suite.write_json(std::cout, label);
+    } else {
+        std::ofstream out(out_path);
+        suite.write_json(out, label);
+        std::cerr << "Wrote " << out_path << std::endl;
+    }
+    return 0;
+}
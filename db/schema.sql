@@ -50,7 +50,7 @@ CREATE TABLE IF NOT EXISTS simulation_agent_states (
     energy_spent    DOUBLE PRECISION NOT NULL DEFAULT 0.0,
     offspring       INTEGER         NOT NULL DEFAULT 0,
     fitness         DOUBLE PRECISION NOT NULL DEFAULT 0.0,
-    -- Genome stored as compressed binary (zlib deflate)
+    -- Genome stored as compressed binary (codec in simulation_saves.genome_codec)
     genome_data     BYTEA,
     genome_length   INTEGER         NOT NULL DEFAULT 0   -- uncompressed byte count
 );
@@ -129,3 +129,46 @@ CREATE TABLE IF NOT EXISTS auto_save_config (
 INSERT INTO auto_save_config (interval_ticks, max_auto_saves, enabled, slot_prefix, last_auto_save_tick)
 SELECT 100, 5, TRUE, 'autosave', 0
 WHERE NOT EXISTS (SELECT 1 FROM auto_save_config);
+
+-- ============================================================
+-- Genome codecs
+-- genome_codec maps to GenomeCodecType (0 none, 1 zlib, 2 zstd);
+-- NULL marks saves written before codecs existed (plain zlib blobs)
+-- ============================================================
+ALTER TABLE simulation_saves ADD COLUMN IF NOT EXISTS genome_codec SMALLINT;
+
+-- Shared dictionary trained from one save's genomes, needed to decode its agent rows
+CREATE TABLE IF NOT EXISTS simulation_genome_dictionaries (
+    save_id         INTEGER         PRIMARY KEY
+                        REFERENCES simulation_saves(id) ON DELETE CASCADE,
+    dictionary      BYTEA           NOT NULL
+);
+
+-- ============================================================
+-- Genome lineage
+-- A child's genome_data may hold a GenomeDelta against its parent_id's
+-- genome (genome_is_delta); is_lineage rows are dead ancestors kept
+-- only as delta bases
+-- ============================================================
+ALTER TABLE simulation_agent_states ADD COLUMN IF NOT EXISTS parent_id       BIGINT;
+ALTER TABLE simulation_agent_states ADD COLUMN IF NOT EXISTS generation      INTEGER NOT NULL DEFAULT 0;
+ALTER TABLE simulation_agent_states ADD COLUMN IF NOT EXISTS genome_is_delta BOOLEAN NOT NULL DEFAULT FALSE;
+ALTER TABLE simulation_agent_states ADD COLUMN IF NOT EXISTS is_lineage      BOOLEAN NOT NULL DEFAULT FALSE;
+
+-- ============================================================
+-- Full-run history: HistoryStore's columnar blocks, one row per block
+-- (delta-of-delta ints + XOR-packed doubles, see history_store.h)
+-- ============================================================
+CREATE TABLE IF NOT EXISTS simulation_history_blocks (
+    id              SERIAL          PRIMARY KEY,
+    save_id         INTEGER         NOT NULL
+                        REFERENCES simulation_saves(id) ON DELETE CASCADE,
+    block_index     INTEGER         NOT NULL,
+    first_tick      BIGINT          NOT NULL,
+    last_tick       BIGINT          NOT NULL,
+    tick_count      INTEGER         NOT NULL,
+    data            BYTEA           NOT NULL
+);
+
+CREATE INDEX IF NOT EXISTS idx_history_blocks_save_tick
+    ON simulation_history_blocks (save_id, first_tick);
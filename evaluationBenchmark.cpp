@@ -0,0 +1,136 @@
+#include <iostream>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+#include "source/simulation/Simulation.hpp"
+#include "source/simulation/evolution.h"
+#include "source/entity/decision_center/rng.hpp"
+#include "source/entity/entity_cpp/fitness_calculator.h"
+
+/*Fixed vs adaptive trial budgets on the same populations:
+1. Seeds a population, checkpoints it, and loads the checkpoint into a second engine so both
+   evaluators start from the same entities; the RNG is rewound between the two evaluations so
+   they also start from the same RNG state.
+2. Scores it once with every entity running every trial and once with successive halving.
+3. Re-scores every entity with many more trials as a reference and reports the reference
+   fitness of the parents each evaluator would have selected.
+*/
+
+static void print_usage(const char* prog) {
+    std::cout
+        << "Usage: " << prog << " [options]\n"
+        << "\nOptions:\n"
+        << "  --seed S          RNG seed                              (default: 1)\n"
+        << "  --rounds N        Populations compared                  (default: 3)\n"
+        << "  --population N    Entities per population               (default: 100)\n"
+        << "  --trials N        Fixed-budget trials per entity        (default: 3)\n"
+        << "  --max-ticks N     Tick cap per trial                    (default: 10000)\n"
+        << "  --reference N     Trials behind the reference fitness   (default: 20)\n"
+        << "  --help            Show this help message\n";
+}
+
+/** Mean reference fitness of the entities an evaluator would keep. */
+static double selected_quality(const std::vector<double>& fitness, const std::vector<double>& reference, size_t keep) {
+    std::vector<size_t> picked = FitnessCalculator::selectTopK(fitness.data(), fitness.size(), keep);
+    double sum = 0.0;
+    for (size_t j : picked) {
+        sum += reference[j];
+    }
+    return picked.empty() ? 0.0 : sum / picked.size();
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t seed = 1;
+    int rounds = 3;
+    int reference_trials = 20;
+    EvolutionConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--rounds" && i + 1 < argc) {
+            rounds = std::stoi(argv[++i]);
+        } else if (arg == "--population" && i + 1 < argc) {
+            config.population = std::stoi(argv[++i]);
+        } else if (arg == "--trials" && i + 1 < argc) {
+            config.trials = std::stoi(argv[++i]);
+        } else if (arg == "--max-ticks" && i + 1 < argc) {
+            config.max_ticks = std::stoi(argv[++i]);
+        } else if (arg == "--reference" && i + 1 < argc) {
+            reference_trials = std::stoi(argv[++i]);
+        } else if (arg == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    rng::seed(seed);
+    Simulation sim;
+    sim.initialize();
+
+    EvolutionConfig adaptive_config = config;
+    adaptive_config.adaptive_trials = true;
+    const std::string snapshot = (std::filesystem::temp_directory_path() / "evaluation_benchmark.ckpt").string();
+
+    long long fixed_ticks = 0, adaptive_ticks = 0;
+    size_t keep = 0;
+    double fixed_quality = 0.0, adaptive_quality = 0.0, oracle_quality = 0.0;
+
+    std::printf("\n%-6s %12s %12s %8s %10s %10s %10s\n",
+                "round", "fixed ticks", "adapt ticks", "saved", "fixed q", "adapt q", "oracle q");
+    for (int round = 0; round < rounds; ++round) {
+        rng::seed(seed + round);
+        EvolutionEngine fixed(sim, config);
+        fixed.seed_population();
+        fixed.save_checkpoint(snapshot);
+
+        EvolutionEngine adaptive(sim, adaptive_config);
+        adaptive.load_checkpoint(snapshot);
+
+        const std::string start_state = rng::save_state();
+        fixed.evaluate();
+        rng::load_state(start_state);
+        adaptive.evaluate();
+
+        // Reference fitness: same entities, many more trials
+        const auto& population = fixed.get_population();
+        std::vector<double> reference(population.size());
+        for (size_t j = 0; j < population.size(); ++j) {
+            long long total = 0;
+            for (int m = 0; m < reference_trials; ++m) {
+                total += fixed.run_trial(*population[j]);
+            }
+            reference[j] = static_cast<double>(total) / reference_trials;
+        }
+
+        keep = fixed.contested_count();
+        const double fq = selected_quality(fixed.get_fitness(), reference, keep);
+        const double aq = selected_quality(adaptive.get_fitness(), reference, keep);
+        const double oq = selected_quality(reference, reference, keep);
+        const long long ft = fixed.get_evaluation_stats().ticks;
+        const long long at = adaptive.get_evaluation_stats().ticks;
+        std::printf("%-6d %12lld %12lld %7.1f%% %10.2f %10.2f %10.2f\n",
+                    round + 1, ft, at, 100.0 * (ft - at) / ft, fq, aq, oq);
+
+        fixed_ticks += ft;
+        adaptive_ticks += at;
+        fixed_quality += fq / rounds;
+        adaptive_quality += aq / rounds;
+        oracle_quality += oq / rounds;
+    }
+    std::filesystem::remove(snapshot);
+
+    std::printf("%-6s %12lld %12lld %7.1f%% %10.2f %10.2f %10.2f\n",
+                "all", fixed_ticks, adaptive_ticks, 100.0 * (fixed_ticks - adaptive_ticks) / fixed_ticks,
+                fixed_quality, adaptive_quality, oracle_quality);
+    std::cout << "q = mean " << reference_trials << "-trial fitness of the top " << keep
+              << " entities each evaluator selects" << std::endl;
+    return 0;
+}
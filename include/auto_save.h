@@ -76,5 +76,6 @@ private:
     int    doSave(const SimulationSavePayload& payload);  // Actual save logic
     string nextSlotName();                                // Picks the next slot in rotation
 
-    DBConnector& db() const { return *m_sm->m_db; }  // Borrowed from SaveManager
+    // Leased from SaveManager's pool for the duration of one statement
+    DBConnectionPool::Lease db() const { return m_sm->m_pool->acquire(); }
 };
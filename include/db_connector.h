@@ -8,6 +8,10 @@
 #include <string>
 #include <stdexcept>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_set>
 #include <libpq-fe.h>
 
 using namespace std;
@@ -49,6 +53,8 @@ struct PGResultGuard {
     int rows() const { return res ? PQntuples(res) : 0; }   // Rows from a SELECT
     int cols() const { return res ? PQnfields(res) : 0; }   // Column count
 
+    bool isNull(int row, int col) const { return !res || PQgetisnull(res, row, col); }
+
     // Text value at (row, col), returns "" for SQL NULL
     string val(int row, int col) const {
         if (!res || PQgetisnull(res, row, col)) return "";
@@ -71,21 +77,26 @@ struct DBConnectionParams {
     string user     = "postgres";
     string password = "";
 
+    int poolSize      = 4;      // Max connections a DBConnectionPool will open
+    int pipelineDepth = 64;     // Statements queued before a pipeline sync is forced
+
     string toConnectionString() const;  // Build the libpq keyword=value string
 
     // Pull values from ALIFE_DB_HOST / PORT / NAME / USER / PASS
+    // plus ALIFE_DB_POOL_SIZE / ALIFE_DB_PIPELINE_DEPTH
     // Falls back to the defaults above if a var isn't set
     static DBConnectionParams fromEnv();
 };
 
 /**
  * DBConnector - One psql connection, opens on construction, closes on destruction
- * Everything else (SaveManager, AutoSave) borrows a shared_ptr to this
+ * SaveManager and AutoSave lease these out of a DBConnectionPool
  */
 class DBConnector {
 public:
     explicit DBConnector(const DBConnectionParams& params);
     explicit DBConnector(const string& connectionString);
+    DBConnector(const DBConnectionParams& params, const string& connectionString);  // Settings from params, connect with the string
     ~DBConnector();
 
     DBConnector(const DBConnector&) = delete;
@@ -96,6 +107,10 @@ public:
 
     bool isConnected() const;
     void reconnect();   // Try to re-establish a lost connection
+    bool isBroken() const { return m_broken; }  // abortPipeline couldn't reset the session; don't reuse
+
+    const DBConnectionParams& params() const { return m_params; }
+    const string& connectionString() const { return m_connStr; }
 
     // Run a plain SQL string — wrap result in PGResultGuard immediately
     PGresult* exec(const string& sql);
@@ -110,10 +125,45 @@ public:
                                 const int* paramLengths,
                                 const int* paramFormats);
 
+    // Named prepared statements — PQprepare'd lazily the first time a name is used
+    // on this connection, then only the parameters go over the wire.
+    // The cache is dropped on reconnect() and rebuilt on demand.
+    PGresult* execPrepared(const string& name, const string& sql, const vector<string>& params);
+    PGresult* execPreparedBinary(const string& name,
+                                 const string& sql,
+                                 int nParams,
+                                 const char* const* paramValues,
+                                 const int* paramLengths,
+                                 const int* paramFormats);
+    bool isPrepared(const string& name) const { return m_prepared.count(name) > 0; }
+
     void beginTransaction();
     void commitTransaction();
     void rollbackTransaction();   // Best-effort, won't throw
 
+    // Pipeline mode — queued statements go out without waiting on each result.
+    // Results are only checked at sync points (every pipelineDepth statements,
+    // or on syncPipeline / endPipeline). Falls back to plain blocking calls
+    // when libpq was built without pipelining.
+    void beginPipeline();
+    void queueParams(const string& sql, const vector<string>& params);
+    void queueParamsBinary(const string& sql,
+                           int nParams,
+                           const char* const* paramValues,
+                           const int* paramLengths,
+                           const int* paramFormats);
+    void queuePrepared(const string& name, const string& sql, const vector<string>& params);
+    void queuePreparedBinary(const string& name,
+                             const string& sql,
+                             int nParams,
+                             const char* const* paramValues,
+                             const int* paramLengths,
+                             const int* paramFormats);
+    void syncPipeline();    // Send a sync and check every queued result, throws on first error
+    void endPipeline();     // Sync, then leave pipeline mode
+    void abortPipeline();   // Best-effort drain + exit, won't throw (use before rollback); marks the connector broken if it can't reset
+    bool inPipeline() const { return m_inPipeline; }
+
     void applySchema(const string& schemaSql);          // Run a raw SQL schema string
     void applySchemaFile(const string& filePath);       // Read a .sql file and run it
 
@@ -124,6 +174,78 @@ private:
     DBConnectionParams m_params;
     string             m_connStr;
 
+    bool               m_inPipeline = false;
+    bool               m_broken = false;
+    // One entry per statement sent since the last sync: the statement name for
+    // a queued PQsendPrepare, empty for an ordinary query
+    vector<string>     m_pipelineQueue;
+
+    unordered_set<string> m_prepared;           // Statement names live on this session
+    unordered_set<string> m_preparePending;     // Sent in the open pipeline, not confirmed yet
+
     void connect();
     void checkResult(PGresult* res, const string& context) const;
+    void afterQueue(const string& preparedName = "");  // Track a queued statement, sync at pipelineDepth
+    void prepare(const string& name, const string& sql);
+    void queuePrepare(const string& name, const string& sql);
+    PGresult* runPrepared(const string& name, const string& sql, int nParams,
+                          const char* const* paramValues, const int* paramLengths,
+                          const int* paramFormats);
+};
+
+/**
+ * DBConnectionPool - Small fixed-size pool of DBConnectors
+ * Connections open lazily up to params.poolSize; acquire() blocks when all are leased.
+ * Lets readers (listSaves, load) run alongside an in-flight auto-save on another thread.
+ */
+class DBConnectionPool {
+public:
+    // RAII lease — hands the connection back to the pool on scope exit
+    class Lease {
+    public:
+        Lease(DBConnectionPool* pool, shared_ptr<DBConnector> conn)
+            : m_pool(pool), m_conn(move(conn)) {}
+        ~Lease() { release(); }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Lease(Lease&& o) noexcept : m_pool(o.m_pool), m_conn(move(o.m_conn)) { o.m_pool = nullptr; }
+        Lease& operator=(Lease&& o) noexcept {
+            if (this != &o) { release(); m_pool = o.m_pool; m_conn = move(o.m_conn); o.m_pool = nullptr; }
+            return *this;
+        }
+
+        DBConnector* operator->() const { return m_conn.get(); }
+        DBConnector& operator*()  const { return *m_conn; }
+
+    private:
+        DBConnectionPool*       m_pool = nullptr;
+        shared_ptr<DBConnector> m_conn;
+
+        void release();
+    };
+
+    explicit DBConnectionPool(const DBConnectionParams& params);
+    explicit DBConnectionPool(shared_ptr<DBConnector> single);  // Wrap one existing connection
+
+    DBConnectionPool(const DBConnectionPool&) = delete;
+    DBConnectionPool& operator=(const DBConnectionPool&) = delete;
+
+    Lease acquire();    // Blocks until a connection is free, opens a new one if under poolSize
+
+    size_t capacity() const { return m_capacity; }
+    size_t openCount() const;   // Connections opened so far
+
+private:
+    DBConnectionParams              m_params;
+    string                          m_connStr;      // What new connections open with
+    size_t                          m_capacity = 1;
+    vector<shared_ptr<DBConnector>> m_all;      // Every connection we own
+    vector<shared_ptr<DBConnector>> m_idle;     // Ones not currently leased
+    size_t                          m_opening = 0;  // Handshakes in progress
+    mutable mutex                   m_mutex;
+    condition_variable              m_cv;
+
+    void giveBack(shared_ptr<DBConnector> conn);    // Drops broken connectors instead of idling them
 };
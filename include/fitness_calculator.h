@@ -7,6 +7,10 @@
 
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <vector>
 
 using namespace std;
 
@@ -32,6 +36,21 @@ public:
                                    double energyGained, double energySpent, uint32_t offspring,
                                    const FitnessWeights& weights = FitnessWeights());
     
+    // Whole population in one pass over SoA arrays, out[i] = calculateFitness(...[i])
+    // Branch-free with fastLog() so the loop vectorizes; |out - scalar| < 1e-9
+    static void calculateFitnessBatch(const double* currentEnergy, const double* maxEnergy,
+                                      const uint64_t* age, const double* energyGained,
+                                      const double* energySpent, const uint32_t* offspring,
+                                      double* out, size_t count,
+                                      const FitnessWeights& weights = FitnessWeights());
+    
+    // Indices of the k highest scores, best first — nth_element + sort of k, not a full sort
+    static vector<size_t> selectTopK(const double* fitness, size_t count, size_t k);
+    
+    // Natural log for x >= 1 from the exponent bits + odd polynomial, no libm call
+    // Max abs error 7.1e-10 on [1, 100] (measured; the log is only ever taken of 1..100 here)
+    static double fastLog(double x);
+    
     // Individual fitness components (all return 0.0-1.0)
     static double energyScore(double currentEnergy, double maxEnergy);
     static double survivalScore(uint64_t age);  // Logarithmic scaling
@@ -44,6 +63,10 @@ public:
 
 private:
     static constexpr double SURVIVAL_LOG_BASE = 100.0;
+    static constexpr double SURVIVAL_SATURATION_AGE = 99.0;          // log(100)/log(100) = 1, clamped above
+    static constexpr double REPRODUCTION_SATURATION_OFFSPRING = 9.0; // log(10)/log(10) = 1
+    
+    static double smallUintToDouble(uint64_t v);   // v < 2^52, via the exponent trick (vectorizes)
 };
 
 // Implementation
@@ -59,6 +82,81 @@ inline double FitnessCalculator::calculateFitness(double currentEnergy, double m
                       reproductionScore(offspring) * weights.reproductionWeight, 0.0, 1.0);
 }
 
+inline double FitnessCalculator::smallUintToDouble(uint64_t v) {
+    // 2^52 + v has v in its mantissa bits exactly
+    uint64_t bits = 0x4330000000000000ull | v;
+    double d;
+    memcpy(&d, &bits, sizeof d);
+    return d - 4503599627370496.0;
+}
+
+inline double FitnessCalculator::fastLog(double x) {
+    // Split x = m * 2^e with m in [sqrt(1/2), sqrt(2)) straight from the bit pattern
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof bits);
+    uint64_t e = (bits - 0x3FE6A09E667F3BCDull) >> 52;     // Unbiased exponent, x >= 1 so e >= 0
+    uint64_t mbits = bits - (e << 52);
+    double m;
+    memcpy(&m, &mbits, sizeof m);
+    
+    // log(m) = 2*atanh(t), t = (m-1)/(m+1) in [-0.172, 0.172] — five odd terms keep the error under 7.1e-10
+    double t  = (m - 1.0) / (m + 1.0);
+    double t2 = t * t;
+    double p  = t * (2.0 + t2 * (2.0 / 3.0 + t2 * (2.0 / 5.0 + t2 * (2.0 / 7.0 + t2 * (2.0 / 9.0)))));
+    return smallUintToDouble(e) * 0.69314718055994530942 + p;
+}
+
+inline void FitnessCalculator::calculateFitnessBatch(const double* currentEnergy, const double* maxEnergy,
+                                                     const uint64_t* age, const double* energyGained,
+                                                     const double* energySpent, const uint32_t* offspring,
+                                                     double* out, size_t count,
+                                                     const FitnessWeights& weights) {
+    const double invLogSurvival = 1.0 / log(SURVIVAL_LOG_BASE);
+    const double invLogTen      = 1.0 / log(10.0);
+    
+    // Same math as the scalar components, with every branch turned into a select.
+    // Ages and offspring past saturation clamp to 1.0 anyway, so they're capped before the log.
+    // Ages must be < 2^52 ticks for the integer-to-double trick.
+    for (size_t i = 0; i < count; ++i) {
+        double maxE   = maxEnergy[i];
+        double energy = currentEnergy[i] / (maxE > 0.0 ? maxE : 1.0);
+        energy = maxE > 0.0 ? std::clamp(energy, 0.0, 1.0) : 0.0;
+        
+        double a = std::min(smallUintToDouble(age[i]), SURVIVAL_SATURATION_AGE);
+        double survival = std::min(fastLog(a + 1.0) * invLogSurvival, 1.0);
+        
+        // (g/s) / (g/s + 1) == g / (g + s) for s > 0 — one division instead of two
+        double gained = energyGained[i], spent = energySpent[i];
+        double total  = gained + spent;
+        double share  = gained / (total != 0.0 ? total : 1.0);
+        double efficiency = spent > 0.0 ? (total != 0.0 ? std::clamp(share, 0.0, 1.0) : 0.0)
+                                        : (gained > 0.0 ? 1.0 : 0.0);
+        
+        double o = std::min(smallUintToDouble(offspring[i]), REPRODUCTION_SATURATION_OFFSPRING);
+        double reproduction = std::min(fastLog(o + 1.0) * invLogTen, 1.0);
+        
+        out[i] = std::clamp(energy * weights.energyWeight +
+                            survival * weights.survivalWeight +
+                            efficiency * weights.efficiencyWeight +
+                            reproduction * weights.reproductionWeight, 0.0, 1.0);
+    }
+}
+
+inline vector<size_t> FitnessCalculator::selectTopK(const double* fitness, size_t count, size_t k) {
+    k = std::min(k, count);
+    vector<size_t> idx(count);
+    for (size_t i = 0; i < count; ++i) idx[i] = i;
+    
+    // Ties go to the lower index so results don't depend on the partition order
+    auto better = [fitness](size_t a, size_t b) {
+        return fitness[a] > fitness[b] || (fitness[a] == fitness[b] && a < b);
+    };
+    if (k < count) std::nth_element(idx.begin(), idx.begin() + k, idx.end(), better);
+    idx.resize(k);
+    std::sort(idx.begin(), idx.end(), better);
+    return idx;
+}
+
 inline double FitnessCalculator::energyScore(double currentEnergy, double maxEnergy) {
     // Linear ratio: full energy = 1.0, empty = 0.0
     return maxEnergy <= 0.0 ? 0.0 : std::clamp(currentEnergy / maxEnergy, 0.0, 1.0);
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+using namespace std;
+
+// Stored in simulation_saves.genome_codec — never renumber
+enum class GenomeCodecType : uint8_t {
+    None = 0,
+    Zlib = 1,
+    Zstd = 2
+};
+
+// Thrown when a codec isn't compiled in or a blob won't round-trip
+struct GenomeCodecError : public runtime_error {
+    explicit GenomeCodecError(const string& msg)
+        : runtime_error("GenomeCodecError: " + msg) {}
+};
+
+/**
+ * GenomeCodec - Pluggable compressor for agent genome blobs
+ * One instance keeps its compression context (and dictionary) alive across calls,
+ * so a whole population goes through a single warmed-up stream instead of paying
+ * setup cost per genome. Blobs stay individually decodable, one per agent row.
+ * Not thread-safe — give each saving thread its own instance.
+ */
+class GenomeCodec {
+public:
+    static constexpr size_t kMinDictSamples = 4;  // Below this a dictionary isn't worth storing
+
+    // level 0 picks the codec's fast default (zlib 1, zstd 1)
+    static unique_ptr<GenomeCodec> create(GenomeCodecType type, int level = 0);
+    static bool            isAvailable(GenomeCodecType type);  // Compiled into this build?
+    static GenomeCodecType bestAvailable();                     // zstd > zlib > none
+    static const char*     name(GenomeCodecType type);
+
+    virtual ~GenomeCodec() = default;
+    virtual GenomeCodecType type() const = 0;
+
+    // Build a shared dictionary from sample genomes, empty if there's too little to go on.
+    // maxBytes 0 lets the codec pick its own cap. The same bytes must be handed to
+    // setDictionary() on the decoding side.
+    virtual vector<uint8_t> trainDictionary(const vector<const vector<uint8_t>*>& samples,
+                                            size_t maxBytes = 0) const;
+    virtual void setDictionary(const vector<uint8_t>& dict) { m_dict = dict; }
+    const vector<uint8_t>& dictionary() const { return m_dict; }
+
+    virtual vector<uint8_t> compress(const uint8_t* data, size_t len) = 0;
+    // rawLen is the stored uncompressed size — 0 means unknown, output grows as needed
+    virtual vector<uint8_t> decompress(const uint8_t* data, size_t len, size_t rawLen) = 0;
+
+    vector<uint8_t> compress(const vector<uint8_t>& data) { return compress(data.data(), data.size()); }
+    vector<uint8_t> decompress(const vector<uint8_t>& data, size_t rawLen = 0) {
+        return decompress(data.data(), data.size(), rawLen);
+    }
+
+    // Whole population through this one context — output[i] decodes to *genomes[i]
+    vector<vector<uint8_t>> compressBatch(const vector<const vector<uint8_t>*>& genomes);
+
+protected:
+    vector<uint8_t> m_dict;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "genome_codec.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * GenomeDelta - Sparse diff of a child genome against the parent it was copied from
+ * Works on 8-byte words (one brain weight), so a child whose mutations touched 2% of
+ * its weights encodes to roughly 2% of its size. Format:
+ *   version byte, varint childLen, varint changedWords,
+ *   changedWords x (varint gap-from-last-index, 8 raw bytes),
+ *   childLen % 8 raw tail bytes
+ */
+struct GenomeDelta {
+    static constexpr size_t  kWordBytes = 8;
+    static constexpr uint8_t kVersion   = 1;
+
+    // Empty result = the delta would be >= maxBytes, store the full genome instead
+    static vector<uint8_t> encode(const vector<uint8_t>& parent,
+                                  const vector<uint8_t>& child,
+                                  size_t maxBytes = SIZE_MAX);
+
+    // Rebuild the child — throws GenomeCodecError on a malformed delta
+    static vector<uint8_t> apply(const vector<uint8_t>& parent, const vector<uint8_t>& delta);
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "circular_buffer.h"
+#include "simulation_state.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+using namespace std;
+
+// Per-tick numbers HistoryStore can roll up and range-query
+enum class HistoryMetric : uint8_t {
+    TotalEnergy = 0,
+    TotalResources,
+    AgentCount,
+    AverageAgentEnergy,
+    AverageFitness,
+    AverageHealth,
+    AverageWater
+};
+constexpr size_t kHistoryMetricCount = 7;
+
+// One point of a range query — a single tick at level 0, a rollup bucket above that
+struct HistorySample {
+    uint64_t firstTick = 0;
+    uint64_t lastTick  = 0;
+    uint32_t ticks     = 0;     // Raw ticks folded into this point
+    double   min       = 0.0;
+    double   max       = 0.0;
+    double   mean      = 0.0;
+};
+
+/**
+ * HistoryStore - Whole-run SimulationState history in three tiers
+ *   hot    the last N ticks in a CircularBuffer, same as before
+ *   cold   every tick in columnar blocks (delta-of-delta ints, XOR-packed doubles)
+ *   rollup min/max/mean per metric over 10 and 100 ticks
+ * push() only appends to the open block and bumps rollup accumulators, so it's O(1)
+ * no matter how long the run gets. Queries read the one level they need.
+ */
+class HistoryStore {
+public:
+    static constexpr size_t kRollupFactor = 10;     // Each level folds 10 points of the one below
+    static constexpr size_t kLevels       = 3;      // Raw, 10x, 100x
+
+    explicit HistoryStore(size_t hotCapacity = 1000, size_t blockTicks = 1024);
+
+    void push(const SimulationState& s);            // Ticks must be increasing
+    void clear();
+
+    const CircularBuffer<SimulationState>& hot() const { return m_hot; }
+    size_t   size() const { return m_total; }       // Ticks recorded since the last clear()
+    bool     empty() const { return m_total == 0; }
+    uint64_t firstTick() const { return m_firstTick; }
+    uint64_t lastTick() const { return m_lastTick; }
+
+    // Full rows for [fromTick, toTick] — straight from the hot ring when it covers the range
+    vector<SimulationState> range(uint64_t fromTick, uint64_t toTick) const;
+
+    // One metric over [fromTick, toTick] at the finest level returning <= maxPoints points
+    vector<HistorySample> query(HistoryMetric metric, uint64_t fromTick, uint64_t toTick,
+                                size_t maxPoints = 1000) const;
+    size_t levelFor(uint64_t fromTick, uint64_t toTick, size_t maxPoints) const;
+
+    // Encoded blocks for persistence — sealed blocks first, then the open one if non-empty
+    size_t          blockCount() const;
+    vector<uint8_t> encodedBlock(size_t index) const;
+    void            blockBounds(size_t index, uint64_t& firstTick, uint64_t& lastTick,
+                                uint32_t& count) const;
+    static vector<SimulationState> decodeBlock(const vector<uint8_t>& bytes);
+    size_t          compressedBytes() const;        // Cold tier footprint
+
+private:
+    struct ColumnWriter {
+        vector<uint8_t> bytes;
+        int      bitsFree  = 0;     // Unused low bits in bytes.back()
+        uint64_t prev      = 0;     // Last raw value (ints) or bit pattern (doubles)
+        int64_t  prevDelta = 0;
+        int      prevLead  = -1;    // XOR window of the previous double, -1 = none yet
+        int      prevTrail = 0;
+    };
+
+    struct Block {
+        uint64_t firstTick = 0;
+        uint64_t lastTick  = 0;
+        uint32_t count     = 0;
+        vector<ColumnWriter> columns;
+    };
+
+    struct Rollup {
+        uint64_t firstTick = 0;
+        uint64_t lastTick  = 0;
+        uint32_t ticks     = 0;
+        uint32_t children  = 0;     // Points of the level below folded in so far
+        array<double, kHistoryMetricCount> min{};
+        array<double, kHistoryMetricCount> max{};
+        array<double, kHistoryMetricCount> sum{};
+    };
+
+    CircularBuffer<SimulationState> m_hot;
+    size_t        m_blockTicks;
+    vector<Block> m_sealed;
+    Block         m_open;
+    array<vector<Rollup>, kLevels> m_rollups;       // [0] unused — level 0 is the raw blocks
+    array<Rollup, kLevels>         m_pending;       // Open bucket per level
+
+    size_t   m_total     = 0;
+    uint64_t m_firstTick = 0;
+    uint64_t m_lastTick  = 0;
+
+    const Block& blockAt(size_t index) const;
+    void resetBlock(Block& b) const;
+    void appendToBlock(Block& b, const SimulationState& s);
+    void foldRollup(size_t level, const Rollup& child);
+    static vector<uint8_t> encode(const Block& b);
+    static vector<double>   decodeMetric(const Block& b, HistoryMetric metric, vector<uint64_t>& ticks);
+    static vector<SimulationState> decodeRows(const Block& b);
+};
@@ -9,6 +9,9 @@
 #include "simulation_state.h"
 #include "resource_node.h"
 #include "circular_buffer.h"
+#include "genome_codec.h"
+#include "genome_delta.h"
+#include "history_store.h"
 
 #include <string>
 #include <vector>
@@ -30,8 +33,10 @@ struct AgentSaveData {
     double   energySpent  = 0.0;
     uint32_t offspring    = 0;
     double   fitness      = 0.0;
+    int64_t  parentId     = -1;     // agentId of the brain parent, -1 for founders
+    uint32_t generation   = 0;      // Reproductions since the founder
 
-    vector<uint8_t> genomeBytes;    // Raw genome, SaveManager compresses before storing
+    vector<uint8_t> genomeBytes;    // Raw genome, SaveManager compresses before storing (see GenomeCodec)
 };
 
 // Everything needed to fully reconstruct a simulation — passed to save() and filled by load()
@@ -42,6 +47,9 @@ struct SimulationSavePayload {
     double   realTimestamp = 0.0;               // Seconds since epoch
 
     vector<AgentSaveData> agents;
+    // Dead ancestors still needed as delta bases for the live agents' genomes.
+    // Saved alongside the agents and handed back here on load, never as live agents.
+    vector<AgentSaveData> lineage;
     vector<ResourceNode*> resources;            // Non-owning pointers
 
     int32_t worldWidth  = 0;
@@ -50,6 +58,8 @@ struct SimulationSavePayload {
 
     // Optionally include the circular buffer so recent tick history gets persisted too
     const CircularBuffer<SimulationState>* stateHistory = nullptr;
+    // Or the whole run — stored as its compressed blocks, read back with loadHistory()
+    const HistoryStore* history = nullptr;
 };
 
 // What gets returned when you list available saves
@@ -71,11 +81,14 @@ struct SaveSlotInfo {
  * SaveManager - Writes and reads full simulation state to/from PostgreSQL
  * Handles agents, resources, environment, and circular buffer history
  * Existing save slots are replaced (delete + re-insert) in a single transaction
+ * Every call leases its own connection, so reads can overlap a save on another thread
  */
 class SaveManager {
 public:
-    // Shared DB connection — SaveManager borrows it, doesn't own it
+    // Single shared DB connection — wrapped in a pool of one, calls are serialised
     explicit SaveManager(shared_ptr<DBConnector> db);
+    // Connection pool — concurrent callers each get their own connection
+    explicit SaveManager(shared_ptr<DBConnectionPool> pool);
     ~SaveManager() = default;
 
     SaveManager(const SaveManager&) = delete;
@@ -88,27 +101,46 @@ public:
     bool load(const string& slotName, SimulationSavePayload& out);  // false if not found
     bool deleteSave(const string& slotName);                        // false if not found
 
+    // Replays a save's history blocks overlapping [fromTick, toTick] into out (cleared first)
+    bool loadHistory(const string& slotName, HistoryStore& out,
+                     uint64_t fromTick = 0, uint64_t toTick = UINT64_MAX);
+
     vector<SaveSlotInfo> listSaves() const;      // All slots, newest first
     vector<SaveSlotInfo> listAutoSaves() const;  // Auto-saves only, newest first
     bool slotExists(const string& slotName) const;
 
-    // Compress/decompress genome bytes with zlib (no-op if zlib not compiled in)
+    // Codec for genomes written by later saves — defaults to the best one compiled in.
+    // Loads always use whatever codec the save was written with.
+    void setGenomeCodec(GenomeCodecType type, int level = 0);
+    GenomeCodecType genomeCodec() const { return m_codecType; }
+
+    // Children are stored as a sparse delta against their parent's genome, except every
+    // Nth generation which is stored in full to bound load-time delta chains (0 = never delta)
+    static constexpr uint32_t kDefaultFullGenomeInterval = 16;
+    void setFullGenomeInterval(uint32_t generations);
+
+    // One-off zlib blob, no dictionary — the format pre-codec saves used (no-op without zlib)
     static vector<uint8_t> compressBytes(const vector<uint8_t>& data);
     static vector<uint8_t> decompressBytes(const vector<uint8_t>& data,
                                             size_t expectedUncompressedSize = 0);
-    static bool compressionEnabled();   // True if ALIFE_USE_ZLIB was defined at build
+    static bool compressionEnabled();   // True if zlib or zstd was compiled in
 
 private:
-    shared_ptr<DBConnector> m_db;
-
-    int  upsertSaveSlot(const SimulationSavePayload& payload, bool isAutoSave);
-    void saveAgents     (int saveId, const vector<AgentSaveData>& agents);
-    void saveResources  (int saveId, const vector<ResourceNode*>& resources);
-    void saveEnvironment(int saveId, const SimulationSavePayload& payload);
-    void saveHistory    (int saveId, const CircularBuffer<SimulationState>* hist);
-
-    void loadAgents   (int saveId, vector<AgentSaveData>& outAgents);
-    void loadResources(int saveId, SimulationSavePayload& out);
+    shared_ptr<DBConnectionPool> m_pool;
+    GenomeCodecType              m_codecType  = GenomeCodec::bestAvailable();
+    int                          m_codecLevel = 0;     // 0 = codec's fast default
+    uint32_t                     m_fullGenomeEvery = kDefaultFullGenomeInterval;
+
+    // Slot row goes out synchronously (we need its id); child rows are pipelined
+    int  upsertSaveSlot(DBConnector& db, const SimulationSavePayload& payload, bool isAutoSave);
+    void saveAgents     (DBConnector& db, int saveId, const SimulationSavePayload& payload);  // Agents + lineage, deltas, dictionary
+    void saveResources  (DBConnector& db, int saveId, const vector<ResourceNode*>& resources);
+    void saveEnvironment(DBConnector& db, int saveId, const SimulationSavePayload& payload);
+    void saveHistory    (DBConnector& db, int saveId, const CircularBuffer<SimulationState>* hist);
+    void saveHistoryBlocks(DBConnector& db, int saveId, const HistoryStore& history);
+
+    void loadAgents   (DBConnector& db, int saveId, GenomeCodec* codec, SimulationSavePayload& out);
+    void loadResources(DBConnector& db, int saveId, SimulationSavePayload& out);
 
     static string       resourceTypeToString(ResourceType t);
     static ResourceType resourceTypeFromInt(int v);
@@ -116,5 +148,5 @@ private:
     // Same as save() but lets AutoSave mark the slot as an auto-save
     int saveInternal(const SimulationSavePayload& payload, bool isAutoSave);
 
-    friend class AutoSave;  // AutoSave needs access to saveInternal and m_db
+    friend class AutoSave;  // AutoSave needs access to saveInternal and m_pool
 };
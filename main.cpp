@@ -10,11 +10,20 @@
 #include <numeric>
 #include <memory>
 #include <vector>
+#include <atomic>
+#include <functional>
+#include <sstream>
 #include "source/simulation/Simulation.hpp"
 #include "source/simulation/circular_buffer.h"
 #include "source/simulation/simulation_state.h"
 #include "source/entity/decision_center/biology.hpp"
 #include "source/entity/decision_center/brain.hpp"
+#include "source/simulation/evolution.h"
+#include "source/simulation/islands.h"
+#include "source/simulation/profiler.h"
+#include "source/simulation/replay.h"
+#include "source/simulation/frame_export.h"
+#include "source/entity/decision_center/rng.hpp"
 
 
 /** Capture a lightweight SimulationState snapshot from the live simulation. */
@@ -22,23 +31,14 @@ static SimulationState capture_state(Simulation& sim, uint64_t tick) {
     SimulationState state;
     state.tick      = tick;
     state.timestamp = static_cast<double>(std::time(nullptr));
-    state.agentCount = static_cast<uint32_t>(sim.get_entity_count());
-
-    Entity* primary = sim.get_primary_entity();
-    if (primary) {
-        auto metrics = primary->biology_get_metrics();
-        state.averageAgentEnergy = metrics["Energy"];
-        state.averageFitness     = 0.0;
-    }
-
-    state.totalResources = 0;
-    state.totalEnergy    = 0.0;
+    apply_population_stats(sim.compute_population_stats(), state);
     return state;
 }
 
 /** Write every entry currently in the circular buffer to a plain-text file. */
 static void save_buffer_to_file(const CircularBuffer<SimulationState>& buffer,
                                 const std::string& filepath) {
+    PROFILE_SCOPE("persist/autosave_write");
     std::ofstream out(filepath);
     if (!out.is_open()) {
         std::cerr << "[AUTOSAVE] Failed to open " << filepath << std::endl;
@@ -55,12 +55,61 @@ static void save_buffer_to_file(const CircularBuffer<SimulationState>& buffer,
             << " | Agents: "    << s.agentCount
             << " | Avg Energy: " << s.averageAgentEnergy
             << " | Avg Fitness: " << s.averageFitness
+            << " | Avg Health: " << s.averageHealth
+            << " | Avg Water: " << s.averageWater
             << " | Resources: " << s.totalResources
             << " | Total Energy: " << s.totalEnergy
             << "\n";
     }
 }
 
+/**
+ * Autosave on its own thread. The tick loop only pushes snapshots into a lock-free ring;
+ * this side drains them into its own history buffer and does the file I/O, so a slow
+ * disk never stalls a tick. With writeProfile the phase timings so far are rewritten to
+ * saveDir/profile.txt at every autosave.
+ */
+static void autosave_worker(SpscCircularBuffer<SimulationState>& snapshots,
+                            const std::atomic<bool>& done,
+                            size_t bufferCapacity, int autosaveInterval,
+                            const std::string& saveDir, bool writeProfile,
+                            bool& diedEarly, int& autosaveCount) {
+    CircularBuffer<SimulationState> history(bufferCapacity);
+    SimulationState s;
+    uint64_t savedInterval = 0;     // Last tick / autosaveInterval that was saved
+
+    while (true) {
+        bool finished = done.load(std::memory_order_acquire);
+        while (snapshots.pop(s)) {
+            history.push(s);
+            // Save on the first snapshot of each new interval, so a dropped snapshot on the
+            // exact multiple only delays that interval's autosave instead of losing it
+            const uint64_t interval = s.tick / static_cast<uint64_t>(autosaveInterval);
+            if (interval > savedInterval) {
+                savedInterval = interval;
+                ++autosaveCount;
+                std::string path = saveDir + "/autosave_tick_" + std::to_string(s.tick) + ".txt";
+                save_buffer_to_file(history, path);
+                if (writeProfile)
+                    profiler::write_report(saveDir + "/profile.txt");
+                std::cout << "[AUTOSAVE] tick " << s.tick << " -> " << path
+                          << "  (buffer: " << history.size() << "/" << history.capacity() << ")\n";
+            }
+        }
+        if (finished) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    if (diedEarly && !history.empty()) {
+        std::string path = saveDir + "/autosave_final_tick_"
+                         + std::to_string(history.latest().tick) + ".txt";
+        save_buffer_to_file(history, path);
+        if (writeProfile)
+            profiler::write_report(saveDir + "/profile.txt");
+        std::cout << "[AUTOSAVE] Final save -> " << path << std::endl;
+    }
+}
+
 /** Print CLI information. */
 static void print_usage(const char* prog) {
     std::cout
@@ -70,25 +119,42 @@ static void print_usage(const char* prog) {
         << "  --autosave K      Autosave every K ticks, 0=off      (default: 0)\n"
         << "  --buffer-size N   Circular buffer capacity            (default: 1000)\n"
         << "  --save-dir DIR    Directory for autosave files        (default: saves/)\n"
+        << "  --profile         Print per-phase timings on exit (and to SAVE_DIR/profile.txt on autosave)\n"
+        << "  --trace FILE      Write a Chrome trace-event JSON of every timed scope on exit\n"
+        << "  --watch           Run --ticks headless with a live view of the world\n"
+        << "  --fps F           Frame rate cap for --watch              (default: 60)\n"
+        << "\nFrame export (plain runs, --watch, and each generation's best entity with --evolve;\n"
+        << "not with --record, --replay or --islands):\n"
+        << "  --export TARGET   Directory for frame_NNNNNN.ppm files, or a .mp4/.mkv/.webm/.mov/.gif piped to ffmpeg\n"
+        << "  --export-every N  Export every Nth tick                   (default: 1)\n"
+        << "  --export-scale S  Pixels per tile                         (default: 8)\n"
+        << "  --export-png      Write PNG frames instead of PPM\n"
+        << "  --export-threads N  Rasterizer threads, 0 = all cores     (default: 0)\n"
+        << "\nRecord / replay (fixed workloads, divergence checks):\n"
+        << "  --record FILE     Run --ticks headless from --seed and log every decision to FILE\n"
+        << "  --replay FILE     Re-run a recorded log and stop at the first tick that differs\n"
+        << "  --hash-every K    State hash interval when recording    (default: 1)\n"
+        << "\nEvolution (non-interactive):\n"
+        << "  --evolve              Run the evolution loop headless\n"
+        << "  --generations N       Generations to run                  (default: 100)\n"
+        << "  --population N        Entities per generation             (default: 100)\n"
+        << "  --selection NAME      truncation | tournament | rank      (default: truncation)\n"
+        << "  --truncation-frac F   Top fraction kept by truncation     (default: 0.1)\n"
+        << "  --tournament-size K   Entrants per tournament             (default: 3)\n"
+        << "  --trials N            Runs averaged per entity            (default: 3)\n"
+        << "  --max-ticks N         Tick cap per trial                  (default: 10000)\n"
+        << "  --adaptive            Successive-halving trial budgets    (default: off)\n"
+        << "  --reinvest F          Skipped ticks re-spent at cutoff    (default: 0.5)\n"
+        << "  --seed S              RNG seed                            (default: clock)\n"
+        << "  --checkpoint-every K  Checkpoint every K generations, 0=off (default: 0)\n"
+        << "  --checkpoint-dir DIR  Directory for evolution.ckpt        (default: checkpoints/)\n"
+        << "  --resume              Continue from DIR/evolution.ckpt if it exists\n"
+        << "  --islands N           Populations in separate processes   (default: 1)\n"
+        << "  --migrate-every M     Generations between migrations      (default: 5)\n"
+        << "  --migrants K          Best entities sent per migration    (default: 2)\n"
         << "  --help            Show this help message\n";
 }
 
-/** Clone an entity with independent Brain and Biology ownership. */
-static std::unique_ptr<Entity> clone_entity(const Entity& src) {
-    auto clone = std::make_unique<Entity>();
-    clone->set_coordinates(src.get_coordinates());
-
-    if (src.get_brain()) {
-        clone->set_brain(std::make_shared<Brain>(*src.get_brain()));
-    }
-
-    if (src.get_biology()) {
-        clone->set_biology(std::make_shared<Biology>(*src.get_biology()));
-    }
-
-    return clone;
-}
-
 /*Runs a simulation that does the following:
 1. runs a simulation over 100 generations (with the same environment each time)
 2. In each simulation picks the top 10% performing individuals and breeds them with each other to create the next generation
@@ -102,81 +168,28 @@ void alphaDemonstration(){
     std::cout << "\nSimulation setup complete with "
               << sim.get_entity_count() << " entity!" << std::endl;
 
-    // ---- Initialise circular buffer for state history ----
-    CircularBuffer<SimulationState> stateHistory(1000);
-    std::cout << "Circular buffer initialised (capacity: 1000)" << std::endl;
-    
-    int numGenerations = 100;
-    int childrenInGenerations = 100;
-    int numTicksMax = 10000;
-    std::vector<std::unique_ptr<Entity>> entities(childrenInGenerations);
-    std::vector<double> fitness_history(childrenInGenerations, 0.0);
-    for (int i = 0; i < numGenerations; i++){
+    EvolutionConfig config;     // 100 generations x 100 children, top 10%, 3 trials
+    EvolutionEngine engine(sim, config);
+    engine.seed_population();
+
+    for (int i = 0; i < config.generations; i++){
         std::cout << "\n=== Generation " << (i + 1) << " ===" << std::endl;
-        if (i == 0) {
-            for (int j = 0; j < childrenInGenerations; j++) {
-                sim.set_primary_entity_random();
-                Entity* sampled = sim.get_primary_entity();
-                if (!sampled) {
-                    throw std::runtime_error("Failed to sample initial entity");
-                }
-                entities[j] = clone_entity(*sampled);
-            }
-        } else {
-            // zip fitness history and entities together, sort by fitness, and select parents from the top 10
-            std::vector<std::pair<double, int>> fitness_entity_pairs;
-            for (int j = 0; j < childrenInGenerations; j++){
-                fitness_entity_pairs.push_back(std::make_pair(fitness_history[j], j));
-            }
-            std::sort(fitness_entity_pairs.begin(), fitness_entity_pairs.end(),
-                [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
-                    return a.first > b.first; // Sort in descending order of fitness
-                });
-            int top_10_percent = std::max(1, childrenInGenerations / 10);
-            std::vector<int> parents;
-            for (int j = 0; j < top_10_percent; j++){
-                parents.push_back(fitness_entity_pairs[j].second);
-            }
-            // Breed new generation from parents
-            for (int j = 0; j < childrenInGenerations; j++){
-                Entity* parent1 = entities[parents[rand() % top_10_percent]].get();
-                Entity* parent2 = entities[parents[rand() % top_10_percent]].get();
-                Entity* child = sim.reproduce(parent1, parent2);
-                entities[j] = clone_entity(*child);
-                fitness_history[j] = 0.0; // reset fitness history for the new generation
-            }
+        if (i > 0) {
+            engine.breed_next_generation();
         }
-        for (int j = 0; j < childrenInGenerations; j++){
-            // Average performance across multiple sims
-            int total = 0;
-            for (int m=0;m<3;m++){
-                sim.seed_resources(); // OOPS I had forgotten to reseed resources, so entities were just starving to death every generation later on
-                int ticks = 0;
-                sim.set_primary_entity(*entities[j]);
-                while(ticks < numTicksMax){
-                   // cout << "Generation " << (i + 1) << ", Entity " << (j + 1) << ", Tick " << ticks << "\n";
-                    stateHistory.push(capture_state(sim, static_cast<uint64_t>(i + 1)));
-                    int result = sim.tick(0);
-                    if(result == -1 || ticks == numTicksMax-1){
-                        total += ticks;
-                        cout << "Entity " << (j + 1) << " fitness: " << ticks << "\n";
-                        break;
-                    }
-                    ticks++;
-                }
-            }
-            fitness_history[j] = total/3;
+        engine.evaluate();
+        const std::vector<double>& fitness_history = engine.get_fitness();
+        for (size_t j = 0; j < fitness_history.size(); j++){
+            cout << "Entity " << (j + 1) << " fitness: " << fitness_history[j] << "\n";
         }
-        cout << "Generation " << (i + 1) << " average fitness: " << std::accumulate(fitness_history.begin(), fitness_history.end(), 0.0) / childrenInGenerations << "\n";
+        cout << "Generation " << (i + 1) << " average fitness: " << engine.mean_fitness() << "\n";
         if((i+1) % 5== 0 || i == 0){
             cout << "Do you want to see the top performer of this generation? (y/n)\n";
             char input;
             cin >> input;
             if(input == 'y' || input == 'Y'){
-                int max_index = static_cast<int>(
-                    std::distance(fitness_history.begin(), std::max_element(fitness_history.begin(), fitness_history.end()))
-                );
-                Entity* top_performer = entities[max_index].get();
+                size_t max_index = engine.best_index();
+                Entity* top_performer = engine.get_population()[max_index].get();
                 cout << "Top performer fitness: " << fitness_history[max_index] << "\n";
                 // Output genes and run a mock simulation
                 sim.seed_resources(); // Reseed resources for fair demonstration
@@ -210,7 +223,161 @@ void alphaDemonstration(){
     }
 }
 
-int runSimulation(int numTicks, int autosaveInterval, size_t bufferCapacity, const std::string& saveDir){
+/** Prints how many frames were exported and what they cost, and closes the video pipe. */
+static int finish_export(FrameExporter* exporter) {
+    if (!exporter)
+        return 0;
+    bool ok = exporter->finish();
+    std::cout << "Exported " << exporter->frames() << " frames (" << exporter->width() << "x" << exporter->height()
+              << ", " << (exporter->frames() > 0 ? 1000.0 * exporter->seconds() / exporter->frames() : 0.0)
+              << " ms/frame)" << std::endl;
+    if (!ok)
+        std::cerr << "ffmpeg reported an error" << std::endl;
+    return ok ? 0 : 1;
+}
+
+/** Headless evolution run: no prompts, one summary line per generation. */
+int runEvolution(const EvolutionConfig& config, bool resume, FrameExporter* exporter = nullptr){
+    Simulation sim;
+    sim.initialize();
+
+    EvolutionEngine engine(sim, config);
+    if (resume && std::filesystem::exists(config.checkpoint_path)) {
+        engine.load_checkpoint(config.checkpoint_path);
+        std::cout << "Resumed " << engine.get_population().size() << " entities at generation "
+                  << (engine.get_generation() + 1) << " from " << config.checkpoint_path << std::endl;
+    } else if (resume) {
+        std::cout << "No checkpoint at " << config.checkpoint_path << ", starting fresh" << std::endl;
+    }
+    std::cout << "Evolving " << engine.get_config().population << " entities for " << config.generations
+              << " generations (" << selection_method_name(config.selection) << " selection, "
+              << config.trials << " trials x " << config.max_ticks << " ticks)" << std::endl;
+    // With an exporter, each generation's best entity gets one filmed run on the engine's own
+    // simulation. Trials reset the world anyway, and the RNG state is put back, so the
+    // evolution itself is unchanged.
+    std::function<void(EvolutionEngine&)> showcase;
+    if (exporter) {
+        showcase = [&](EvolutionEngine& e) {
+            const std::string rngState = rng::save_state();
+            sim.seed_resources();
+            sim.set_primary_entity(*e.get_population()[e.best_index()]);
+            for (int t = 1; t <= config.max_ticks; ++t) {
+                bool dead = sim.tick(0) == -1;
+                exporter->on_tick(sim, t);
+                if (dead)
+                    break;
+            }
+            rng::load_state(rngState);
+        };
+    }
+    engine.run(std::cout, showcase);
+
+    size_t best = engine.best_index();
+    std::cout << "Best entity " << engine.get_population()[best]->get_id()
+              << " (generation " << engine.get_population()[best]->get_generation()
+              << ") fitness: " << engine.get_fitness()[best] << std::endl;
+    return 0;
+}
+
+/** Prints the phase report and writes the trace, whichever were asked for. */
+static void finish_profiling(bool report, const std::string& tracePath) {
+    if (report) {
+        std::cout << "\n=== Profile ===" << std::endl;
+        profiler::report(std::cout);
+    }
+    if (!tracePath.empty()) {
+        if (profiler::write_chrome_trace(tracePath))
+            std::cout << "Trace written to " << tracePath << std::endl;
+        else
+            std::cerr << "Could not write trace to " << tracePath << std::endl;
+    }
+}
+
+/**
+ * Live view: ticks headless and redraws only the cells that changed, one write per frame.
+ * A dead entity is replaced so the view keeps running.
+ */
+int runWatch(int numTicks, double fps, FrameExporter* exporter = nullptr){
+    Simulation sim;
+    {
+        std::ostringstream quiet;
+        std::streambuf* original = std::cout.rdbuf(quiet.rdbuf());
+        sim.initialize();
+        std::cout.rdbuf(original);
+    }
+    FrameRenderer renderer;
+    const auto frameTime = std::chrono::duration<double>(fps > 0.0 ? 1.0 / fps : 0.0);
+    std::cout << "\033[2J\033[H\033[?25l" << std::flush;     // Clear, home, hide cursor
+
+    auto start = std::chrono::steady_clock::now();
+    auto nextFrame = start;
+    size_t bytes = 0;
+    int respawns = 0;
+    std::string frame;
+    for (int i = 0; i < numTicks; ++i) {
+        if (sim.tick(0) == -1) {
+            std::ostringstream quiet;
+            std::streambuf* original = std::cout.rdbuf(quiet.rdbuf());
+            sim.set_primary_entity_random();
+            std::cout.rdbuf(original);
+            ++respawns;
+        }
+        if (exporter)
+            exporter->on_tick(sim, i + 1);
+        sim.render_frame(renderer);
+        frame = renderer.compose_delta();
+        frame += "Tick " + std::to_string(i + 1) + "/" + std::to_string(numTicks) + "  respawns "
+               + std::to_string(respawns) + "  cells " + std::to_string(renderer.changed_cells()) + "    \n";
+        std::cout.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+        std::cout.flush();
+        bytes += frame.size();
+
+        nextFrame += std::chrono::duration_cast<std::chrono::steady_clock::duration>(frameTime);
+        std::this_thread::sleep_until(nextFrame);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "\033[?25h" << numTicks << " frames in " << seconds << " s ("
+              << (seconds > 0.0 ? numTicks / seconds : 0.0) << " fps, "
+              << (numTicks > 0 ? bytes / numTicks : 0) << " bytes/frame)" << std::endl;
+    return 0;
+}
+
+/** Records a seeded headless run to path. */
+int runRecord(const std::string& path, int numTicks, uint32_t seed, uint32_t hashEvery){
+    auto start = std::chrono::steady_clock::now();
+    ReplayLog log = record_run(numTicks, seed, hashEvery);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    save_replay(path, log);
+    size_t respawns = std::count_if(log.ticks.begin(), log.ticks.end(),
+                                    [](uint8_t t) { return (t & ReplayLog::REPLAY_RESPAWNED) != 0; });
+    std::cout << "Recorded " << log.ticks.size() << " ticks (seed " << seed << ", " << respawns
+              << " respawns, " << log.hashes.size() << " state hashes) in " << seconds << " s -> " << path << std::endl;
+    return 0;
+}
+
+/** Replays the log at path; exit status 1 when the run diverges from it. */
+int runReplay(const std::string& path){
+    ReplayLog log;
+    try {
+        log = load_replay(path);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    ReplayResult result = verify_replay(log);
+    if (result.diverged_at >= 0) {
+        std::cout << "Replay diverged at tick " << result.diverged_at << " of " << log.ticks.size()
+                  << ": " << result.reason << std::endl;
+        return 1;
+    }
+    std::cout << "Replay matched " << result.ticks_run << " ticks (seed " << log.seed << ", "
+              << log.hashes.size() << " state hashes) in " << result.seconds << " s, "
+              << (result.seconds > 0.0 ? result.ticks_run / result.seconds : 0.0) << " ticks/s" << std::endl;
+    return 0;
+}
+
+int runSimulation(int numTicks, int autosaveInterval, size_t bufferCapacity, const std::string& saveDir,
+                  bool profileAutosave = false, FrameExporter* exporter = nullptr){
 // ---- Initialise simulation ----
     Simulation sim;
     sim.initialize();
@@ -222,58 +389,68 @@ int runSimulation(int numTicks, int autosaveInterval, size_t bufferCapacity, con
     std::cout << "Circular buffer initialised (capacity: "
               << bufferCapacity << ")" << std::endl;
 
+    // ---- Autosave thread fed through a lock-free snapshot ring ----
+    int autosaveCount = 0;
+    bool diedEarly = false;
+    std::atomic<bool> autosaveDone{false};
+    SpscCircularBuffer<SimulationState> snapshots(bufferCapacity);
+    std::thread autosaveThread;
+
     if (autosaveInterval > 0) {
         std::filesystem::create_directories(saveDir);
         std::cout << "Autosave enabled every " << autosaveInterval
                   << " tick(s) -> " << saveDir << "/" << std::endl;
+        autosaveThread = std::thread(autosave_worker, std::ref(snapshots), std::cref(autosaveDone),
+                                     bufferCapacity, autosaveInterval, std::cref(saveDir), profileAutosave,
+                                     std::ref(diedEarly), std::ref(autosaveCount));
     }
 
     // ---- Main simulation loop ----
-    int autosaveCount = 0;
-
     for (int i = 0; i < numTicks; ++i) {
         std::cout << "\n=== Tick " << (i + 1) << " ===" << std::endl;
         int result = sim.tick();
+        if (exporter)
+            exporter->on_tick(sim, i + 1);
 
-        stateHistory.push(capture_state(sim, static_cast<uint64_t>(i + 1)));
-
-        // Autosave check
-        if (autosaveInterval > 0 && (i + 1) % autosaveInterval == 0) {
-            ++autosaveCount;
-            std::string path = saveDir + "/autosave_tick_"
-                             + std::to_string(i + 1) + ".txt";
-            save_buffer_to_file(stateHistory, path);
-            std::cout << "[AUTOSAVE] tick " << (i + 1)
-                      << " -> " << path
-                      << "  (buffer: " << stateHistory.size()
-                      << "/" << stateHistory.capacity() << ")" << std::endl;
+        {
+            PROFILE_SCOPE("persist/snapshot");
+            SimulationState state = capture_state(sim, static_cast<uint64_t>(i + 1));
+            stateHistory.push(state);
+            if (autosaveInterval > 0)
+                snapshots.push(state);      // Never blocks; counted in dropped() if the writer lags
         }
 
         if (result == -1) {
             std::cout << "Entity died at tick " << (i + 1) << "." << std::endl;
-            if (autosaveInterval > 0) {
-                std::string path = saveDir + "/autosave_final_tick_"
-                                 + std::to_string(i + 1) + ".txt";
-                save_buffer_to_file(stateHistory, path);
-                std::cout << "[AUTOSAVE] Final save -> " << path << std::endl;
-            }
+            diedEarly = true;
             break;
         }
     }
 
+    if (autosaveThread.joinable()) {
+        autosaveDone.store(true, std::memory_order_release);   // Also publishes diedEarly
+        autosaveThread.join();
+    }
+
     // Print a summary to the console
     std::cout << "\n=== Simulation Complete ===" << std::endl;
     std::cout << "State history: " << stateHistory.size()
               << "/" << stateHistory.capacity() << " entries" << std::endl;
 
-    if (autosaveInterval > 0)
+    if (autosaveInterval > 0) {
         std::cout << "Total autosaves written: " << autosaveCount << std::endl;
+        if (snapshots.dropped() > 0)
+            std::cout << "Snapshots dropped (autosave fell behind): " << snapshots.dropped() << std::endl;
+    }
 
     if (!stateHistory.empty()) {
         const auto& latest = stateHistory.latest();
         std::cout << "Latest state — Tick: " << latest.tick
                   << ", Agents: " << latest.agentCount
-                  << ", Avg Energy: " << latest.averageAgentEnergy << std::endl;
+                  << ", Avg Energy: " << latest.averageAgentEnergy
+                  << " [" << latest.minAgentEnergy << ", " << latest.maxAgentEnergy << "]"
+                  << ", Resources: " << latest.totalResources
+                  << " (" << latest.totalEnergy << " energy)" << std::endl;
     }
     return 0;
 }
@@ -284,6 +461,20 @@ int main(int argc, char* argv[]) {
     int         autosaveInterval = 0;       // 0 = autosave disabled
     size_t      bufferCapacity   = 1000;
     std::string saveDir          = "saves";
+    bool        evolve           = false;
+    bool        resume           = false;
+    std::string checkpointDir    = "checkpoints";
+    bool        profile          = false;
+    std::string tracePath;
+    std::string recordPath;
+    std::string replayPath;
+    bool        watch            = false;
+    double      fps              = 60.0;
+    uint32_t    hashEvery        = 1;       // state_hash() is incremental, so every tick is free
+    FrameExportConfig exportConfig;
+    uint32_t    seed             = static_cast<uint32_t>(std::time(nullptr));
+    EvolutionConfig evolution;
+    IslandConfig islands;
 
     // ---- Parse command-line arguments ----
     for (int i = 1; i < argc; ++i) {
@@ -296,6 +487,65 @@ int main(int argc, char* argv[]) {
             bufferCapacity = static_cast<size_t>(std::stoull(argv[++i]));
         } else if (arg == "--save-dir" && i + 1 < argc) {
             saveDir = argv[++i];
+        } else if (arg == "--profile") {
+            profile = true;
+        } else if (arg == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (arg == "--watch") {
+            watch = true;
+        } else if (arg == "--fps" && i + 1 < argc) {
+            fps = std::stod(argv[++i]);
+        } else if (arg == "--export" && i + 1 < argc) {
+            exportConfig.target = argv[++i];
+        } else if (arg == "--export-every" && i + 1 < argc) {
+            exportConfig.every = std::stoi(argv[++i]);
+        } else if (arg == "--export-scale" && i + 1 < argc) {
+            exportConfig.scale = std::stoi(argv[++i]);
+        } else if (arg == "--export-png") {
+            exportConfig.png = true;
+        } else if (arg == "--export-threads" && i + 1 < argc) {
+            exportConfig.threads = std::stoi(argv[++i]);
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--hash-every" && i + 1 < argc) {
+            hashEvery = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--evolve") {
+            evolve = true;
+        } else if (arg == "--generations" && i + 1 < argc) {
+            evolution.generations = std::stoi(argv[++i]);
+        } else if (arg == "--population" && i + 1 < argc) {
+            evolution.population = std::stoi(argv[++i]);
+        } else if (arg == "--selection" && i + 1 < argc) {
+            evolution.selection = parse_selection_method(argv[++i]);
+        } else if (arg == "--truncation-frac" && i + 1 < argc) {
+            evolution.truncation_fraction = std::stod(argv[++i]);
+        } else if (arg == "--tournament-size" && i + 1 < argc) {
+            evolution.tournament_size = std::stoi(argv[++i]);
+        } else if (arg == "--trials" && i + 1 < argc) {
+            evolution.trials = std::stoi(argv[++i]);
+        } else if (arg == "--max-ticks" && i + 1 < argc) {
+            evolution.max_ticks = std::stoi(argv[++i]);
+        } else if (arg == "--adaptive") {
+            evolution.adaptive_trials = true;
+        } else if (arg == "--reinvest" && i + 1 < argc) {
+            evolution.reinvest_fraction = std::stod(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+            rng::seed(seed);
+        } else if (arg == "--checkpoint-every" && i + 1 < argc) {
+            evolution.checkpoint_every = std::stoi(argv[++i]);
+        } else if (arg == "--checkpoint-dir" && i + 1 < argc) {
+            checkpointDir = argv[++i];
+        } else if (arg == "--resume") {
+            resume = true;
+        } else if (arg == "--islands" && i + 1 < argc) {
+            islands.islands = std::stoi(argv[++i]);
+        } else if (arg == "--migrate-every" && i + 1 < argc) {
+            islands.migrate_every = std::stoi(argv[++i]);
+        } else if (arg == "--migrants" && i + 1 < argc) {
+            islands.migrants = std::stoi(argv[++i]);
         } else if (arg == "--help") {
             print_usage(argv[0]);
             return 0;
@@ -305,6 +555,53 @@ int main(int argc, char* argv[]) {
             return 1;
         }
     }
+    // Only plain runs, --watch and single-population --evolve film anything; islands would
+    // also fork with the exporter's rasterizer threads alive
+    if (!exportConfig.target.empty()
+        && (!recordPath.empty() || !replayPath.empty() || (evolve && islands.islands > 1))) {
+        std::cerr << "--export can't be combined with --record, --replay or --islands\n";
+        print_usage(argv[0]);
+        return 1;
+    }
+    if ((profile || !tracePath.empty()) && !profiler::compiled_in()) {
+        std::cerr << "Built without ALIFE_PROFILE; --profile and --trace record nothing" << std::endl;
+    }
+    if (!tracePath.empty()) {
+        profiler::enable_trace();
+    }
+    std::unique_ptr<FrameExporter> exporter;
+    if (!exportConfig.target.empty()) {
+        try {
+            exporter = std::make_unique<FrameExporter>(exportConfig);
+        } catch (const std::exception& e) {
+            std::cerr << "Cannot export frames: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    if (watch) {
+        int code = runWatch(numTicks, fps, exporter.get());
+        code |= finish_export(exporter.get());
+        finish_profiling(profile, tracePath);
+        return code;
+    }
+    if (!recordPath.empty() || !replayPath.empty()) {
+        int code = !replayPath.empty() ? runReplay(replayPath) : runRecord(recordPath, numTicks, seed, hashEvery);
+        finish_profiling(profile, tracePath);
+        return code;
+    }
+    if (evolve) {
+        if (evolution.checkpoint_every > 0 || resume) {
+            std::filesystem::create_directories(checkpointDir);
+            evolution.checkpoint_path = checkpointDir + "/evolution.ckpt";
+        }
+        if (islands.islands > 1) {
+            return run_islands(evolution, islands, resume);     // Islands are separate processes; not profiled
+        }
+        int code = runEvolution(evolution, resume, exporter.get());
+        code |= finish_export(exporter.get());
+        finish_profiling(profile, tracePath);
+        return code;
+    }
     if (argc == 3 || (argc == 1 && std::string(argv[0]) == "--help")) {
         while (1)
         {
@@ -377,7 +674,10 @@ int main(int argc, char* argv[]) {
     }
 }
     else {
-        return runSimulation(numTicks, autosaveInterval, bufferCapacity, saveDir);
+        int code = runSimulation(numTicks, autosaveInterval, bufferCapacity, saveDir, profile, exporter.get());
+        code |= finish_export(exporter.get());
+        finish_profiling(profile, tracePath);
+        return code;
     }
 return 0;
 }
@@ -1,4 +1,6 @@
 #include "biology.hpp"
+#include "biology_store.hpp"
+#include "rng.hpp"
 #include <iostream>
 #include <iomanip>
 #include <random>
@@ -6,10 +8,6 @@
 #include <algorithm>
 #include "../../environment/Environment.h"
 
-// idk, this was a suggestion for implementing randomness.
-static std::random_device rd;
-static std::mt19937 gen(rd());
-static std::uniform_real_distribution<> dis(0.0, 1.0);
 
 Biology::Biology(bool debug)
     : _energy(1.0), _health(1.0), _water(1.0)
@@ -19,6 +17,67 @@ Biology::Biology(bool debug)
     {
         set_random_attributes();
     }
+    genes_changed();
+}
+
+Biology::Biology(const Biology& other)
+    : _energy(other.get_energy()), _health(other.get_health()), _water(other.get_water()),
+      _genetic_values(other._genetic_values), _genes(other._genes), x(other.x), y(other.y)
+{
+}
+
+Biology& Biology::operator=(const Biology& other)
+{
+    // Vitals and genes only; this object stays bound (or unbound) as it was
+    if (this != &other)
+    {
+        const double energy = other.get_energy();
+        const double health = other.get_health();
+        const double water = other.get_water();
+        _genetic_values = other._genetic_values;
+        x = other.x;
+        y = other.y;
+        energy_ref() = energy;
+        health_ref() = health;
+        water_ref() = water;
+        genes_changed();
+    }
+    return *this;
+}
+
+Biology::~Biology()
+{
+    if (_store)
+    {
+        _store->release(_row);
+    }
+}
+
+double& Biology::energy_ref()
+{
+    return _store ? _store->energy(_row) : _energy;
+}
+
+double& Biology::health_ref()
+{
+    return _store ? _store->health(_row) : _health;
+}
+
+double& Biology::water_ref()
+{
+    return _store ? _store->water(_row) : _water;
+}
+
+void Biology::genes_changed()
+{
+    for (int gene = 0; gene < GENE_COUNT; ++gene)
+    {
+        _genes[gene] = genetic_or_zero(GENE_NAMES[gene]);
+    }
+    if (_store)
+    {
+        _store->refresh_genes(_row);
+    }
 }
 
 // ==================== Initialization & Setup ====================
@@ -31,9 +90,10 @@ void Biology::set_random_attributes()
      */
     for (auto& pair : _genetic_values)
     {
-        double random_val = dis(gen);
+        double random_val = rng::unit();
         pair.second = random_val * random_val; 
     }
+    genes_changed();
 }
 
 
@@ -43,6 +103,7 @@ void Biology::set_genetic_vals(const std::unordered_map<std::string, double>& va
     Sets up the biology with passed in values for genome
     */
     _genetic_values = vals;
+    genes_changed();
 }
 
 
@@ -50,17 +111,22 @@ void Biology::set_genetic_vals(const std::unordered_map<std::string, double>& va
 
 double Biology::get_health() const
 {
-    return _health;
+    return _store ? _store->health(_row) : _health;
 }
 
 double Biology::get_energy() const
 {
-    return _energy;
+    return _store ? _store->energy(_row) : _energy;
 }
 
 double Biology::get_water() const
 {
-    return _water;
+    return _store ? _store->water(_row) : _water;
+}
+
+BiologyMetrics Biology::get_metrics() const
+{
+    return BiologyMetrics{get_health(), get_energy(), get_water()};
 }
 
 // Creates a map of the values, can be accessed like a python dicttionary
@@ -96,6 +162,7 @@ void Biology::set_coordinates(const Vector2d& coords)
 void Biology::set_efficiencies(const std::unordered_map<std::string, double>& vals)
 {
     _genetic_values = vals;
+    genes_changed();
 }
 
 // Sets specific genetic values
@@ -113,21 +180,25 @@ void Biology::set_efficiency(const std::string& type, double value)
     }
 
     it->second = value;
+    genes_changed();
 }
 
 void Biology::add_health(double val)
 {
-    _health = std::min(_health + val, 1.0);
+    double& health = health_ref();
+    health = std::min(health + val, 1.0);
 }
 
 void Biology::add_energy(double val)
 {
-    _energy = std::min(_energy + val, 1.0);
+    double& energy = energy_ref();
+    energy = std::min(energy + val, 1.0);
 }
 
 void Biology::add_water(double val)
 {
-    _water = std::min(_water + val, 1.0);
+    double& water = water_ref();
+    water = std::min(water + val, 1.0);
 }
 
 // ==================== Resource Consumption ====================
@@ -138,6 +209,14 @@ double Biology::eat_energy(double quantity)
      * Adjusts the energy stores obtained from eating based on the creature's
      * various efficiencies. Does some bs using mass to make bigger creatures more costly to maintain
      */
+    if (_store)
+    {
+        // Bound: the gene and the mass scale were looked up once when the genes were set
+        double amount = quantity * _store->genes(_row)[GENE_ENERGY_EFFICIENCY];
+        amount *= _store->eat_scale(_row);
+        add_energy(amount * FOOD_ENERGY_COEFFICIENT);
+        return amount;
+    }
     double amount = quantity * _genetic_values["Energy Efficiency"];
     amount *= std::pow(1.0 - _genetic_values["Mass"], 0.5);
     add_energy(amount * FOOD_ENERGY_COEFFICIENT);
@@ -150,7 +229,7 @@ double Biology::drink_water(double quantity)
      * Adjusts the water reserves a creature obtains from drinking based on
      * efficiency.
      */
-    double amount = quantity * _genetic_values["Water Efficiency"];
+    double amount = quantity * (_store ? _store->genes(_row)[GENE_WATER_EFFICIENCY] : _genetic_values["Water Efficiency"]);
     add_water(amount * FOOD_ENERGY_COEFFICIENT);
     return amount;
 }
@@ -174,30 +253,49 @@ double Biology::add_chemical(const std::string& chemical_type, double quantity)
 
 // ==================== Terrain & Movement ====================
 
-double Biology::movement_energy_drain(const std::string& terrain_type)
+double Biology::traversal_efficiency(const std::string& terrain_type) const
 {
     /**
-     * Drains energy based on the type of terrain the creature moved through.
-     * Falls back to default traversal efficiency if terrain type not found.
+     * 1 - the creature's efficiency on this terrain, falling back to the default
+     * traversal efficiency if the terrain type isn't a gene.
      */
-    double efficiency;
     auto it = _genetic_values.find(terrain_type);
-
     if (it == _genetic_values.end())
     {
-        // Use default traversal efficiency
-        efficiency = 1.0 - _genetic_values.at("Traversal Efficiency 1");
-    }
-    else
-    {
-        efficiency = 1.0 - it->second;
+        return 1.0 - _genetic_values.at("Traversal Efficiency 1");
     }
+    return 1.0 - it->second;
+}
+
+double Biology::genetic_or_zero(const std::string& gene) const
+{
+    auto it = _genetic_values.find(gene);
+    return it == _genetic_values.end() ? 0.0 : it->second;
+}
 
-    double amount = std::max(
-        efficiency * TERRAIN_ENERGY_COEFFICIENT * _genetic_values["Mass"],
+double Biology::movement_energy_cost(const std::string& terrain_type) const
+{
+    return std::max(
+        traversal_efficiency(terrain_type) * TERRAIN_ENERGY_COEFFICIENT * genetic_or_zero("Mass"),
         0.01
     );
+}
 
+double Biology::movement_water_cost(const std::string& terrain_type) const
+{
+    double water_efficiency = 1.0 - genetic_or_zero("Water Efficiency");
+    return std::max(
+        water_efficiency * traversal_efficiency(terrain_type) * TERRAIN_WATER_COEFFICIENT,
+        0.01
+    );
+}
+
+double Biology::movement_energy_drain(const std::string& terrain_type)
+{
+    /**
+     * Drains energy based on the type of terrain the creature moved through.
+     */
+    double amount = movement_energy_cost(terrain_type);
     add_energy(amount * -1);
     return amount;
 }
@@ -207,35 +305,16 @@ double Biology::movement_water_drain(const std::string& terrain_type)
     /**
      * Drains water based on the type of terrain navigated.
      */
-    double efficiency;
-    auto it = _genetic_values.find(terrain_type);
-
-    if (it == _genetic_values.end())
-    {
-        // Use default traversal efficiency
-        efficiency = 1.0 - _genetic_values.at("Traversal Efficiency 1");
-    }
-    else
-    {
-        efficiency = 1.0 - it->second;
-    }
-
-    double water_efficiency = 1.0 - _genetic_values["Water Efficiency"];
-    double amount = std::max(
-        water_efficiency * efficiency * TERRAIN_WATER_COEFFICIENT,
-        0.01
-    );
-
+    double amount = movement_water_cost(terrain_type);
     add_water(amount * -1);
     return amount;
 }
 
 // ==================== Life Cycle ====================
 
-double Biology::tick_energy_drain()
+double Biology::metabolic_total() const
 {
     /**
-     * Determines how much energy the creature loses every tick.
      * Based on the sum of genetic traits (excluding Mass).
      */
     double total = 0.0;
@@ -250,7 +329,16 @@ double Biology::tick_energy_drain()
 
     // Calculate the drain: sqrt of sum, divided by number of traits, adjusted for mass
     total = std::pow(total, 0.5) / static_cast<double>(_genetic_values.size());
-    total = total * (1.0 - std::pow(_genetic_values["Mass"], 2.0));
+    total = total * (1.0 - std::pow(genetic_or_zero("Mass"), 2.0));
+    return total;
+}
+
+double Biology::tick_energy_drain()
+{
+    /**
+     * Determines how much energy the creature loses every tick.
+     */
+    double total = metabolic_total();
     double drain = std::max(total * ENERGY_DRAIN_COEFFICIENT,.02);
     add_energy(drain * -1);
     return total;
@@ -262,9 +350,9 @@ double Biology::tick_health_drain()
      * Determines how much health the creature loses each tick.
      * Health is drained if energy falls below a mass-dependent threshold.
      */
-    if (_energy < 1.0 - _genetic_values["Mass"])
+    if (get_energy() < 1.0 - _genetic_values["Mass"])
     {
-        double difference = _genetic_values["Mass"] - _energy;
+        double difference = _genetic_values["Mass"] - get_energy();
         double drain = std::pow(difference, 2.0);
         add_health(drain * -1);
         return drain;
@@ -278,8 +366,8 @@ void Biology::update()
      * Updates the organism for a single game tick.
      * Clamps resources and applies per-tick drains.
      */
-    _energy = std::max(_energy, 0.0);
-    _water = std::max(_water, 0.0);
+    energy_ref() = std::max(get_energy(), 0.0);
+    water_ref() = std::max(get_water(), 0.0);
 
     std::cout << "Tick energy loss: " << tick_energy_drain() << std::endl;
     std::cout << "Tick Health loss: " << tick_health_drain() << std::endl;
@@ -290,7 +378,7 @@ bool Biology::check_death() const
     /**
      * Checks if the organism should be considered dead.
      */
-    return _health <= 0.0;
+    return get_health() <= 0.0;
 }
 
 // ==================== Display & Debugging ====================
@@ -313,7 +401,7 @@ void Biology::print_vals() const
      * Displays current resource levels.
      */
     std::cout << std::fixed << std::setprecision(6);
-    std::cout << "Current Health: " << _health << std::endl;
-    std::cout << "Current Energy: " << _energy << std::endl;
-    std::cout << "Current Water: " << _water << std::endl;
+    std::cout << "Current Health: " << get_health() << std::endl;
+    std::cout << "Current Energy: " << get_energy() << std::endl;
+    std::cout << "Current Water: " << get_water() << std::endl;
 }
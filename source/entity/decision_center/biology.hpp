@@ -1,12 +1,62 @@
 #ifndef BIOLOGY_HPP
 #define BIOLOGY_HPP
 
+#include <array>
+#include <cstddef>
 #include <unordered_map>
 #include <string>
 #include <memory>
 #include "biology_constants.hpp"
 #include "../../environment/MathVector.hpp"
 
+class BiologyStore;
+
+/**
+ * @struct BiologyMetrics
+ * @brief A creature's vitals, by value
+ */
+struct BiologyMetrics
+{
+    double health = 0.0;
+    double energy = 0.0;
+    double water = 0.0;
+};
+
+/**
+ * @class GeneSpan
+ * @brief Read-only view of a genome: GENE_COUNT values in GENE_NAMES order, indexed by GeneIndex
+ *
+ * Points into the Biology it came from, so it stays valid while that Biology is alive and
+ * sees later gene changes. Empty when taken from an entity without a biology.
+ */
+class GeneSpan
+{
+private:
+    const double* _data = nullptr;
+    size_t _size = 0;
+
+public:
+    GeneSpan() = default;
+    GeneSpan(const double* data, size_t size) : _data(data), _size(size) {}
+
+    double operator[](size_t gene) const { return _data[gene]; }
+    const double* begin() const { return _data; }
+    const double* end() const { return _data + _size; }
+    const double* data() const { return _data; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+};
+
+/**
+ * @struct BiologyView
+ * @brief Everything a per-tick caller reads from a biology, without allocating
+ */
+struct BiologyView
+{
+    BiologyMetrics metrics;
+    GeneSpan genes;
+};
+
 /**
  * @class Biology
  * @brief Represents the biological systems of a creature in the simulation
@@ -22,6 +72,23 @@ private:
     double _health;
     double _water;
     std::unordered_map<std::string, double> _genetic_values;
+    std::array<double, GENE_COUNT> _genes{};      // _genetic_values in GENE_NAMES order, missing genes as 0
+
+    // Set while bound to a BiologyStore row, which then holds the vitals instead of the
+    // three fields above
+    BiologyStore* _store = nullptr;
+    size_t _row = 0;
+
+    double traversal_efficiency(const std::string& terrain_type) const;
+    double genetic_or_zero(const std::string& gene) const;
+    double metabolic_total() const;      // tick_energy_drain's return value, without the drain
+
+    double& energy_ref();
+    double& health_ref();
+    double& water_ref();
+    void genes_changed();
+
+    friend class BiologyStore;
 
 public:
     /**
@@ -30,12 +97,23 @@ public:
      */
     explicit Biology(bool debug = false);
 
+    /**
+     * @brief Copies vitals and genes; the copy is never bound to a store
+     */
+    Biology(const Biology& other);
+    Biology& operator=(const Biology& other);
+
     int x;
     int y;
     /**
-     * @brief Destructor for Biology
+     * @brief Destructor for Biology; releases its store row if bound
+     */
+    ~Biology();
+
+    /**
+     * @brief True while a BiologyStore row holds this creature's vitals
      */
-    ~Biology() = default;
+    bool is_bound() const { return _store != nullptr; }
 
     // ==================== Initialization & Setup ====================
 
@@ -67,6 +145,21 @@ public:
      */
     double get_water() const;
 
+    /**
+     * @brief Returns health, energy and water in one struct
+     */
+    BiologyMetrics get_metrics() const;
+
+    /**
+     * @brief Returns the genome as a span in GENE_NAMES order
+     */
+    GeneSpan get_genes() const { return GeneSpan(_genes.data(), _genes.size()); }
+
+    /**
+     * @brief Returns metrics and genes together; neither allocates
+     */
+    BiologyView view() const { return BiologyView{get_metrics(), get_genes()}; }
+
     /**
      * @brief Returns all genetic values (efficiencies)
      * @return A map containing all genetic trait values
@@ -149,6 +242,22 @@ public:
 
     // ==================== Terrain & Movement ====================
 
+    /**
+     * @brief Energy one step onto a terrain type costs, without applying it
+     * @param terrain_type The terrain type identifier
+     * @return The amount movement_energy_drain would drain
+     * @throws std::out_of_range if the default traversal efficiency gene is missing
+     */
+    double movement_energy_cost(const std::string& terrain_type) const;
+
+    /**
+     * @brief Water one step onto a terrain type costs, without applying it
+     * @param terrain_type The terrain type identifier
+     * @return The amount movement_water_drain would drain
+     * @throws std::out_of_range if the default traversal efficiency gene is missing
+     */
+    double movement_water_cost(const std::string& terrain_type) const;
+
     /**
      * @brief Calculates energy drain from moving through a terrain type
      * @param terrain_type The terrain type identifier
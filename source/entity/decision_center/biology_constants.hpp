@@ -16,6 +16,21 @@ const std::string TERRAIN_1 = "Traversal Efficiency 1";
 const std::string TERRAIN_2 = "Traversal Efficiency 2";
 const std::string TERRAIN_3 = "Traversal Efficiency 3";
 
+// Dense gene order, for per-creature gene arrays (BiologyStore rows)
+enum GeneIndex
+{
+    GENE_ENERGY_EFFICIENCY, GENE_WATER_EFFICIENCY, GENE_MASS, GENE_VISION,
+    GENE_CHEM_1, GENE_CHEM_2, GENE_CHEM_3, GENE_CHEM_4,
+    GENE_TRAVERSAL_1, GENE_TRAVERSAL_2, GENE_TRAVERSAL_3,
+    GENE_COUNT
+};
+
+constexpr const char* GENE_NAMES[GENE_COUNT] = {
+    "Energy Efficiency", "Water Efficiency", "Mass", "Vision",
+    "Chem 1", "Chem 2", "Chem 3", "Chem 4",
+    "Traversal Efficiency 1", "Traversal Efficiency 2", "Traversal Efficiency 3"
+};
+
 /**
  * @brief Returns the default genetic values for a creature
  * @return An unordered_map with default genetic trait values
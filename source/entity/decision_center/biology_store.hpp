@@ -0,0 +1,107 @@
+#ifndef BIOLOGY_STORE_HPP
+#define BIOLOGY_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "biology_constants.hpp"
+
+class Biology;
+
+/**
+ * @class BiologyStore
+ * @brief Population-level metabolism state in structure-of-arrays form
+ *
+ * Each row holds one creature's energy, health and water, its genes in GENE_NAMES order,
+ * and the per-tick constants derived from them (tick drain, starvation threshold, eating
+ * scale). A Biology bound to a row keeps no vitals of its own: its getters and setters go
+ * through to the row, so the row is the only copy. tick() runs clamping, energy drain,
+ * health drain and the death check for the whole population as one branch-free loop over
+ * the columns.
+ */
+class BiologyStore
+{
+private:
+    // Hot columns, one entry per row
+    std::vector<double> _energy;
+    std::vector<double> _health;
+    std::vector<double> _water;
+    std::vector<double> _tick_drain;        // Energy lost per tick, from the genes
+    std::vector<double> _mass;
+    std::vector<double> _starve_below;      // 1 - Mass: energy under this drains health
+    std::vector<uint8_t> _dead;
+
+    // Cold data
+    std::vector<double> _genes;             // [row * GENE_COUNT + gene]
+    std::vector<double> _eat_scale;         // sqrt(1 - Mass), applied to everything eaten
+    std::vector<Biology*> _owners;          // nullptr for placeholder and released rows
+
+    friend class Biology;
+
+    /**
+     * @brief Forgets a row's owner when that Biology is destroyed while bound
+     */
+    void release(size_t row) { _owners[row] = nullptr; }
+
+public:
+    BiologyStore() = default;
+    ~BiologyStore();
+
+    BiologyStore(const BiologyStore&) = delete;
+    BiologyStore& operator=(const BiologyStore&) = delete;
+
+    /**
+     * @brief Appends a row with the biology's vitals and genes and binds the biology to it
+     * @param biology Biology to bind, or nullptr for a placeholder row that never dies
+     * @return The new row's index
+     * @throws std::logic_error if the biology is already bound to a store
+     */
+    size_t bind(Biology* biology);
+
+    /**
+     * @brief Rebuilds a row's genes and derived constants from its owner
+     * Called by Biology whenever a bound biology's genes change
+     */
+    void refresh_genes(size_t row);
+
+    /**
+     * @brief Writes every row's vitals back to its owner, unbinds it and empties the store
+     */
+    void clear();
+
+    size_t size() const { return _energy.size(); }
+
+    /**
+     * @brief One metabolism tick for every row
+     *
+     * Same arithmetic as Biology::update: energy and water are clamped at 0, the tick drain
+     * is taken from energy, then health drops by (Mass - energy)^2 if energy is under
+     * 1 - Mass. Gains are clamped at 1.
+     * @return Number of rows with health <= 0 afterwards
+     */
+    size_t tick();
+
+    bool dead(size_t row) const { return _dead[row] != 0; }
+
+    double& energy(size_t row) { return _energy[row]; }
+    double& health(size_t row) { return _health[row]; }
+    double& water(size_t row) { return _water[row]; }
+    double energy(size_t row) const { return _energy[row]; }
+    double health(size_t row) const { return _health[row]; }
+    double water(size_t row) const { return _water[row]; }
+    double eat_scale(size_t row) const { return _eat_scale[row]; }
+
+    /**
+     * @brief Whole vitals columns, size() values each, for population-wide passes
+     */
+    const double* energy_column() const { return _energy.data(); }
+    const double* health_column() const { return _health.data(); }
+    const double* water_column() const { return _water.data(); }
+
+    /**
+     * @brief A row's genes, GENE_COUNT values in GENE_NAMES order
+     */
+    const double* genes(size_t row) const { return &_genes[row * GENE_COUNT]; }
+};
+
+#endif
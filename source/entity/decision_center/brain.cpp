@@ -4,7 +4,9 @@
 #include <random>
 #include <ctime>
 #include <algorithm>
+#include <cstring>
 #include "brain.hpp"
+#include "rng.hpp"
 
 // Hyperbolic Tangent (tanh) Activation Function
 // maps any real output to between [-1, 1]
@@ -26,9 +28,11 @@ double relu(double x) {
 
 // Dot Product Function [adapted heavily from https://www.educative.io/answers/dot-product-of-two-vectors-in-cpp]
 // computes the sum of element-wise products of two vectors.
+// a shorter vector counts as zero-padded (narrow-vision perception is shorter than the input layer).
 double dot_product(std::vector<double> v1, std::vector<double> v2) {
     double result = 0;
-    for (int i = 0; i < v1.size(); ++i) {
+    size_t n = std::min(v1.size(), v2.size());
+    for (size_t i = 0; i < n; ++i) {
         result += v1[i] * v2[i];
     }
     return result;
@@ -44,30 +48,48 @@ double dot_product(std::vector<double> v1, std::vector<double> v2) {
 ActivationLayerReLU::ActivationLayerReLU(int input_size, int output_size) {
     n_in = input_size;
     n_out = output_size;
-    weights.resize(input_size * output_size);
-    biases.resize(n_out);
-    std::mt19937 gen(std::time(nullptr)); // Seed with current time
+    weights = std::make_shared<std::vector<double>>(input_size * output_size);
+    biases = std::make_shared<std::vector<double>>(n_out);
+    std::mt19937& gen = rng::engine();
     std::uniform_real_distribution<double> dist(-1.0, 1.0);
 
 
-    for (double& b : biases) {
+    for (double& b : *biases) {
         b = dist(gen);
     }
 
-    for (double& w : weights) {
+    for (double& w : *weights) {
         w = dist(gen);
     }
 }
 
 //overwrite a RELU from passed in weights and biases
-void ActivationLayerReLU::ActivationLayerReLUOffsping(const std::vector<double>& weights, const std::vector<double>& biases) {
-    this->weights = weights;
-    this->biases = biases;
+// takes the vectors by value so callers can move a freshly mutated buffer in without a copy.
+void ActivationLayerReLU::ActivationLayerReLUOffsping(std::vector<double> weights, std::vector<double> biases) {
+    this->weights = std::make_shared<std::vector<double>>(std::move(weights));
+    this->biases = std::make_shared<std::vector<double>>(std::move(biases));
+}
+
+// copy-on-write: only the first write to a shared block pays for the copy
+std::vector<double>& ActivationLayerReLU::mutable_weights() {
+    if (weights.use_count() > 1) {
+        weights = std::make_shared<std::vector<double>>(*weights);
+    }
+    return *weights;
+}
+
+std::vector<double>& ActivationLayerReLU::mutable_biases() {
+    if (biases.use_count() > 1) {
+        biases = std::make_shared<std::vector<double>>(*biases);
+    }
+    return *biases;
 }
 // Forward Pass
 // computes weighted sum plus bias, then applies ReLU activation to each output neuron.
 std::vector<double> ActivationLayerReLU::forward(const std::vector<double>& input) {
     std::vector<double> output(n_out);
+    const std::vector<double>& weights = *this->weights;
+    const std::vector<double>& biases = *this->biases;
 
     for (int i = 0; i < n_out; ++i) {
         std::vector<double> weight_row(n_in);
@@ -84,12 +106,12 @@ std::vector<double> ActivationLayerReLU::forward(const std::vector<double>& inpu
 
 // returns the bias vector
 const std::vector<double>& ActivationLayerReLU::get_biases() const{
-    return biases;
+    return *biases;
 }
 
 // returns the flattened weight matrix (stored row-major)
 const std::vector<double>& ActivationLayerReLU::get_weights() const{
-    return weights;
+    return *weights;
 }
 
 
@@ -108,13 +130,19 @@ Brain::Brain(std::vector<int> layer_sizes) {
     }
 }
 
-// Argmax decision center
-int Brain::decide(const std::vector<double>& input) {
+// Output layer activations, for callers that read the outputs as several heads
+std::vector<double> Brain::evaluate(const std::vector<double>& input) {
     std::vector<double> current_output = input;
-    
+
     for (int i = 0; i < layers.size(); ++i) {
         current_output = layers[i].forward(current_output);
     }
+    return current_output;
+}
+
+// Argmax decision center
+int Brain::decide(const std::vector<double>& input) {
+    std::vector<double> current_output = evaluate(input);
 
     int max_index = std::max_element(current_output.begin(), current_output.end()) - current_output.begin();
     return max_index;
@@ -122,4 +150,49 @@ int Brain::decide(const std::vector<double>& input) {
 
 std::vector<ActivationLayerReLU>& Brain::get_layers() {
     return layers;
-}   
\ No newline at end of file
+}   
+
+// Genome Serialization
+// weights then biases for each layer, copied out as raw doubles.
+std::vector<uint8_t> Brain::serialize_genome() const {
+    size_t count = 0;
+    for (const auto& layer : layers) {
+        count += layer.get_weights().size() + layer.get_biases().size();
+    }
+
+    std::vector<uint8_t> bytes(count * sizeof(double));
+    uint8_t* out = bytes.data();
+    for (const auto& layer : layers) {
+        const std::vector<double>& w = layer.get_weights();
+        const std::vector<double>& b = layer.get_biases();
+        std::memcpy(out, w.data(), w.size() * sizeof(double));
+        out += w.size() * sizeof(double);
+        std::memcpy(out, b.data(), b.size() * sizeof(double));
+        out += b.size() * sizeof(double);
+    }
+    return bytes;
+}
+
+// Genome Deserialization
+// inverse of serialize_genome, the brain must already have the matching layer sizes.
+bool Brain::deserialize_genome(const std::vector<uint8_t>& bytes) {
+    size_t count = 0;
+    for (const auto& layer : layers) {
+        count += layer.get_weights().size() + layer.get_biases().size();
+    }
+    if (bytes.size() != count * sizeof(double)) {
+        return false;
+    }
+
+    const uint8_t* in = bytes.data();
+    for (auto& layer : layers) {
+        std::vector<double> w(layer.get_weights().size());
+        std::vector<double> b(layer.get_biases().size());
+        std::memcpy(w.data(), in, w.size() * sizeof(double));
+        in += w.size() * sizeof(double);
+        std::memcpy(b.data(), in, b.size() * sizeof(double));
+        in += b.size() * sizeof(double);
+        layer.ActivationLayerReLUOffsping(std::move(w), std::move(b));
+    }
+    return true;
+}
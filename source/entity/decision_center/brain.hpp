@@ -1,6 +1,8 @@
 #pragma once
 
 #include <vector>
+#include <cstdint>
+#include <memory>
 
 // Activation layer equations
 double relu(double x);
@@ -9,20 +11,26 @@ double sigmoid(double x);
 double dot_product(std::vector<double> v1, std::vector<double> v2);
 
 // Layer functions
+// weights and biases are copy-on-write blocks: copying a layer (and so a Brain) shares them,
+// and a block is only duplicated when a holder asks to write to it while it is shared.
 class ActivationLayerReLU {
 private:
-    std::vector<double> weights;
-    std::vector<double> biases;
+    std::shared_ptr<std::vector<double>> weights;
+    std::shared_ptr<std::vector<double>> biases;
     int n_in, n_out;
 
 public:
     ActivationLayerReLU(int input_size, int output_size);
-    void ActivationLayerReLUOffsping(const std::vector<double>& weights, const std::vector<double>& biases);
+    void ActivationLayerReLUOffsping(std::vector<double> weights, std::vector<double> biases);
     std::vector<double> forward(const std::vector<double>& input);
-    int get_weight_count() const { return weights.size(); }
-    int get_biases_count() const { return biases.size(); }
+    int get_weight_count() const { return weights->size(); }
+    int get_biases_count() const { return biases->size(); }
     const std::vector<double>& get_weights() const;
     const std::vector<double>& get_biases() const;
+    // writable blocks, duplicated first if another layer still shares them
+    std::vector<double>& mutable_weights();
+    std::vector<double>& mutable_biases();
+    bool shares_weights_with(const ActivationLayerReLU& other) const { return weights == other.weights; }
 };
 
 // Brain Class
@@ -35,7 +43,17 @@ private:
 public:
     Brain(std::vector<int> layer_sizes);
     int decide(const std::vector<double>& input);
+    // output layer activations; decide() is their argmax
+    std::vector<double> evaluate(const std::vector<double>& input);
     int get_layer_count() const { return layers.size(); }
     std::vector<ActivationLayerReLU>& get_layers();
     void set_layers(const std::vector<ActivationLayerReLU>& new_layers) { layers = new_layers; }
+
+    // Genome serialization
+    // flat dump of every layer's weights then biases (raw doubles, layer order).
+    // children of the same architecture line up with their parent byte for byte,
+    // so a save can store a child as the handful of weights that mutated.
+    std::vector<uint8_t> serialize_genome() const;
+    // overwrites weights/biases from serialize_genome() output; false if the size doesn't match this architecture
+    bool deserialize_genome(const std::vector<uint8_t>& bytes);
 };
\ No newline at end of file
@@ -9,7 +9,8 @@
 static long long entity_id_counter = 0;
 
 Entity::Entity()
-    : _biology(nullptr), _brain(nullptr), _location(nullptr), _id(entity_id_counter++)
+    : _biology(nullptr), _brain(nullptr), _location(nullptr), _id(entity_id_counter++),
+      _parent_id(-1), _generation(0), _age(0)
 {
 }
 
@@ -30,6 +31,42 @@ void Entity::set_location(const std::any& location)
     _location = location;
 }
 
+void Entity::set_lineage(long long parent_id, int generation)
+{
+    _parent_id = parent_id;
+    _generation = generation;
+}
+
+void Entity::increment_age()
+{
+    ++_age;
+}
+
+void Entity::assign_new_id()
+{
+    _id = entity_id_counter++;
+    _age = 0;
+}
+
+void Entity::restore_id(long long id)
+{
+    _id = id;
+    if (entity_id_counter <= id)
+    {
+        entity_id_counter = id + 1;
+    }
+}
+
+long long Entity::next_id()
+{
+    return entity_id_counter;
+}
+
+void Entity::set_next_id(long long id)
+{
+    entity_id_counter = id;
+}
+
 
 // ==================== Getters ====================
 
@@ -38,6 +75,21 @@ long long Entity::get_id() const
     return _id;
 }
 
+long long Entity::get_parent_id() const
+{
+    return _parent_id;
+}
+
+int Entity::get_generation() const
+{
+    return _generation;
+}
+
+long long Entity::get_age() const
+{
+    return _age;
+}
+
 std::shared_ptr<Biology> Entity::get_biology() const
 {
     return _biology;
@@ -80,6 +132,16 @@ int Entity::brain_get_decision(const std::vector<double>& inputs)
     return _brain->decide(inputs);
 }
 
+std::vector<double> Entity::brain_get_outputs(const std::vector<double>& inputs)
+{
+    if (_brain == nullptr)
+    {
+        std::cerr << "Warning: Where dat brain at?" << std::endl;
+        return {};
+    }
+    return _brain->evaluate(inputs);
+}
+
 // ==================== Biology Related Methods ====================
 
 // All below Presently untested in the simulation
@@ -207,6 +269,16 @@ void Entity::update_biology()
     _biology->update();
 }
 
+BiologyView Entity::biology_view() const
+{
+    if (_biology == nullptr)
+    {
+        std::cerr << "Warning: It has a face but a no body!" << std::endl;
+        return BiologyView{};
+    }
+    return _biology->view();
+}
+
 // Just a easy way to get all values I guess
 std::unordered_map<std::string, double> Entity::biology_get_metrics(bool display)
 {
@@ -218,15 +290,13 @@ std::unordered_map<std::string, double> Entity::biology_get_metrics(bool display
         return metrics;
     }
 
-    double health = _biology->get_health();
-    double energy = _biology->get_energy();
-    double water = _biology->get_water();
+    const BiologyMetrics values = _biology->get_metrics();
     
     if(display) _biology->print_vals();
     
-    metrics["Health"] = health;
-    metrics["Energy"] = energy;
-    metrics["Water"] = water;
+    metrics["Health"] = values.health;
+    metrics["Energy"] = values.energy;
+    metrics["Water"] = values.water;
     
     return metrics;
 }
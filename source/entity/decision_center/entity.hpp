@@ -11,6 +11,7 @@
 
 // Forward declarations
 class Biology;
+struct BiologyView;
 class Brain;
 
 /**
@@ -27,6 +28,9 @@ private:
     std::shared_ptr<Brain> _brain;
     std::any _location;  // Can hold any location type
     long long _id;
+    long long _parent_id;  // Entity whose brain this one was copied from, -1 for founders
+    int _generation;       // 0 for founders, parent's generation + 1 otherwise
+    long long _age;        // Ticks survived — the fitness score evolution runs select on
 
 public:
     /**
@@ -62,6 +66,40 @@ public:
      */
     void set_location(const std::any& location);
 
+    /**
+     * @brief Records which entity this one descends from
+     * @param parent_id ID of the entity whose brain was inherited, -1 for a founder
+     * @param generation Number of reproductions since the founder
+     */
+    void set_lineage(long long parent_id, int generation);
+
+    /**
+     * @brief Counts one more tick survived
+     */
+    void increment_age();
+
+    /**
+     * @brief Gives this entity the next unused ID and resets its age
+     * Used when a preallocated slot is refilled with a new individual
+     */
+    void assign_new_id();
+
+    /**
+     * @brief Gives this entity a previously issued ID (checkpoint restore)
+     * New IDs keep counting from past it, so restored and fresh entities never collide
+     */
+    void restore_id(long long id);
+
+    /**
+     * @brief The ID the next new entity will get
+     */
+    static long long next_id();
+
+    /**
+     * @brief Sets the ID the next new entity will get (checkpoint restore)
+     */
+    static void set_next_id(long long id);
+
     // ==================== Getters ====================
 
     /**
@@ -70,6 +108,24 @@ public:
      */
     long long get_id() const;
 
+    /**
+     * @brief Returns the ID of the brain parent
+     * @return The parent's ID, or -1 for a founder
+     */
+    long long get_parent_id() const;
+
+    /**
+     * @brief Returns how many reproductions separate this entity from its founder
+     * @return The generation number
+     */
+    int get_generation() const;
+
+    /**
+     * @brief Returns how many ticks this entity has survived
+     * @return The age in ticks
+     */
+    long long get_age() const;
+
     /**
      * @brief Returns the organism's biology
      * @return Shared pointer to the Biology object
@@ -97,6 +153,13 @@ public:
      */
     int brain_get_decision(const std::vector<double>& inputs);
 
+    /**
+     * @brief Runs the brain and returns its raw outputs
+     * @param inputs Input data vector for the brain
+     * @return Output layer activations, empty if there is no brain
+     */
+    std::vector<double> brain_get_outputs(const std::vector<double>& inputs);
+
 
     // ==================== Biology Related Methods ====================
 
@@ -193,13 +256,21 @@ public:
     void update_biology();
 
     /**
-     * @brief Gets the metrics of the organism's biology
+     * @brief Returns the biology's metrics and a span over its genes without allocating
+     * @return The view, or an empty one (zero metrics, no genes) if there is no biology
+     */
+    BiologyView biology_view() const;
+
+    /**
+     * @brief Gets the metrics of the organism's biology, for debug output
+     * Per-tick code reads biology_view().metrics instead, which doesn't allocate
      * @return A map containing Health, Energy, and Water values
      */
     std::unordered_map<std::string, double> biology_get_metrics(bool display=false);
 
     /**
-     * @brief Returns the genetic values of the organism
+     * @brief Prints and returns the genetic values of the organism, for debug output
+     * Per-tick code reads biology_view().genes instead, which doesn't allocate
      * @return A map containing the genetic values
      */
     std::unordered_map<std::string, double> biology_get_genetics();
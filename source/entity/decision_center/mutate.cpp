@@ -5,27 +5,60 @@
 #include <ctime>
 #include <algorithm>
 #include "mutate.hpp"
+#include "brain.hpp"
+#include "rng.hpp"
 #include <unordered_map>
 
-std::vector<double> mutate_vector(const std::vector<double>& original) {
-    std::vector<double> mutated = original;
-    std::mt19937 gen(std::time(nullptr));
-    std::uniform_real_distribution<double> mutation_dist(-0.1, 0.1); // Mutation changes value by up to ±0.05
-    std::uniform_real_distribution<double> chance_dist(0.0, 1.0); // For mutation chance
+namespace {
+// Visits the mutation sites of a size-n buffer; buffer() is only called once there's a hit,
+// so an untouched copy-on-write block is never materialized.
+template <typename Buffer>
+size_t mutate_sites(size_t n, double chance, Buffer buffer) {
+    if (n == 0 || chance <= 0.0) {
+        return 0;
+    }
+    std::mt19937& gen = rng::engine();
+    std::geometric_distribution<size_t> gap(std::min(chance, 1.0)); // Untouched values before the next site
+    std::uniform_real_distribution<double> mutation_dist(-0.1, 0.1); // Mutation changes value by up to ±0.1
+    std::uniform_real_distribution<double> chance_dist(0.0, 1.0);
 
-    for (double& val : mutated) {
-        double roll = chance_dist(gen);
-        if (roll < MUTATION_CHANCE) {
-            if (chance_dist(gen) < .2) {
-                val = chance_dist(gen); // 20% chance to completely randomize the value instead of just mutating it slightly
-            }
-            else{
-                val += mutation_dist(gen);
-                if (val > 1.0) val = 1.0;
-                if (val < 0.0) val = 0.0;
-            }
+    size_t i = gap(gen);
+    if (i >= n) {
+        return 0;
+    }
+    std::vector<double>& values = buffer();
+    size_t count = 0;
+    for (; i < n; i += gap(gen) + 1) {
+        double& val = values[i];
+        if (chance_dist(gen) < .2) {
+            val = chance_dist(gen); // 20% chance to completely randomize the value instead of just mutating it slightly
         }
+        else {
+            val += mutation_dist(gen);
+            if (val > 1.0) val = 1.0;
+            if (val < 0.0) val = 0.0;
+        }
+        ++count;
     }
+    return count;
+}
+}
+
+size_t mutate_in_place(std::vector<double>& values, double chance) {
+    return mutate_sites(values.size(), chance, [&]() -> std::vector<double>& { return values; });
+}
+
+size_t mutate_layer(ActivationLayerReLU& layer, double chance) {
+    size_t count = mutate_sites(layer.get_weights().size(), chance,
+                                [&]() -> std::vector<double>& { return layer.mutable_weights(); });
+    count += mutate_sites(layer.get_biases().size(), chance,
+                          [&]() -> std::vector<double>& { return layer.mutable_biases(); });
+    return count;
+}
+
+std::vector<double> mutate_vector(const std::vector<double>& original) {
+    std::vector<double> mutated = original;
+    mutate_in_place(mutated);
     return mutated;
 }
 
@@ -45,4 +78,4 @@ std::unordered_map<std::string, double> mutate_genetics(const std::unordered_map
         mutatedMap[keys[i]] = mutated_values[i];
     }
     return mutatedMap;
-}
\ No newline at end of file
+}
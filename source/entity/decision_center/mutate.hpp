@@ -1,3 +1,5 @@
+#pragma once
+
 #include <cmath>
 #include <vector>
 #include <numeric>
@@ -5,8 +7,20 @@
 #include <ctime>
 #include <algorithm>
 #include <unordered_map>
+#include <string>
+
+class ActivationLayerReLU;
 
 const double MUTATION_CHANCE = 0.02; // 1% chance to mutate each weight or bias
 
 std::vector<double> mutate_vector(const std::vector<double>& original);
-std::unordered_map<std::string, double> mutate_genetics(const std::unordered_map<std::string, double>& original);
\ No newline at end of file
+std::unordered_map<std::string, double> mutate_genetics(const std::unordered_map<std::string, double>& original);
+
+// Sparse mutation: each value still mutates independently with probability chance, but the
+// sites are reached by drawing the geometric gap to the next one, so the cost follows the
+// number of mutations (~chance * size) instead of the size. Returns how many values changed.
+size_t mutate_in_place(std::vector<double>& values, double chance = MUTATION_CHANCE);
+
+// Same per-site rule on a layer's weights and biases. A block nobody mutates stays shared
+// with whatever layer it was copied from (see ActivationLayerReLU copy-on-write).
+size_t mutate_layer(ActivationLayerReLU& layer, double chance = MUTATION_CHANCE);
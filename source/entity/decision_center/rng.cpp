@@ -0,0 +1,56 @@
+#include "rng.hpp"
+#include <ctime>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+namespace rng
+{
+    std::mt19937& engine()
+    {
+        // One engine per thread, so a worker mutating brains never contends with (or perturbs) another
+        thread_local std::mt19937 gen(static_cast<uint32_t>(std::time(nullptr)) ^
+                                      static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())));
+        return gen;
+    }
+
+    void seed(uint32_t value)
+    {
+        engine().seed(value);
+    }
+
+    int next_int(int bound)
+    {
+        return std::uniform_int_distribution<int>(0, bound - 1)(engine());
+    }
+
+    double unit()
+    {
+        return std::uniform_real_distribution<double>(0.0, 1.0)(engine());
+    }
+
+    double uniform(double lo, double hi)
+    {
+        return std::uniform_real_distribution<double>(lo, hi)(engine());
+    }
+
+    std::string save_state()
+    {
+        std::ostringstream out;
+        out << engine();
+        return out.str();
+    }
+
+    bool load_state(const std::string& state)
+    {
+        std::istringstream in(state);
+        std::mt19937 restored;
+        in >> restored;
+        if (in.fail())
+        {
+            return false;
+        }
+        engine() = restored;
+        return true;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef RNG_HPP
+#define RNG_HPP
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+/**
+ * @brief Seedable random source for everything evolution depends on
+ *
+ * Brain initialization, mutation, biology genetics, breeding and resource seeding all draw
+ * from this one engine, so a run is reproducible from its seed and can be checkpointed by
+ * saving the engine state next to the population. Each thread gets its own engine; seed(),
+ * save_state() and load_state() act on the calling thread's.
+ */
+namespace rng
+{
+    /**
+     * @brief This thread's engine, seeded from the clock and thread id until seed() is called
+     */
+    std::mt19937& engine();
+
+    /**
+     * @brief Reseeds this thread's engine
+     */
+    void seed(uint32_t value);
+
+    /**
+     * @brief Uniform integer in [0, bound), bound must be > 0
+     */
+    int next_int(int bound);
+
+    /**
+     * @brief Uniform double in [0, 1)
+     */
+    double unit();
+
+    /**
+     * @brief Uniform double in [lo, hi)
+     */
+    double uniform(double lo, double hi);
+
+    /**
+     * @brief Engine state as text (std::mt19937 stream format)
+     */
+    std::string save_state();
+
+    /**
+     * @brief Restores a state from save_state()
+     * @return false if the text isn't a valid engine state; the engine is left unchanged
+     */
+    bool load_state(const std::string& state);
+}
+
+#endif
@@ -0,0 +1,148 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "tests/doctest.h"
+#include "biology.hpp"
+#include "biology_constants.hpp"
+#include "biology_store.hpp"
+#include <memory>
+#include <vector>
+
+// ==================== Binding ====================
+
+TEST_SUITE("BiologyStore - Binding")
+{
+    TEST_CASE("Bound biology reads and writes through its row")
+    {
+        BiologyStore store;
+        Biology guy(true);
+        size_t row = store.bind(&guy);
+
+        CHECK(guy.is_bound());
+        CHECK(store.energy(row) == doctest::Approx(guy.get_energy()));
+
+        guy.add_energy(-0.3);
+        CHECK(store.energy(row) == doctest::Approx(0.7));
+
+        store.water(row) = 0.25;
+        CHECK(guy.get_water() == doctest::Approx(0.25));
+    }
+
+    TEST_CASE("Genes are stored in GENE_NAMES order")
+    {
+        BiologyStore store;
+        Biology guy(true);
+        size_t row = store.bind(&guy);
+        auto values = guy.get_genetic_vals();
+
+        for (int gene = 0; gene < GENE_COUNT; ++gene)
+        {
+            CHECK(store.genes(row)[gene] == doctest::Approx(values[GENE_NAMES[gene]]));
+        }
+
+        guy.set_efficiency("Mass", 0.2);
+        CHECK(store.genes(row)[GENE_MASS] == doctest::Approx(0.2));
+    }
+
+    TEST_CASE("Binding twice throws")
+    {
+        BiologyStore store;
+        Biology guy(true);
+        store.bind(&guy);
+        CHECK_THROWS_AS(store.bind(&guy), std::logic_error);
+    }
+
+    TEST_CASE("Clear writes vitals back and unbinds")
+    {
+        BiologyStore store;
+        Biology guy(true);
+        size_t row = store.bind(&guy);
+        store.energy(row) = 0.4;
+        store.clear();
+
+        CHECK_FALSE(guy.is_bound());
+        CHECK(store.size() == 0);
+        CHECK(guy.get_energy() == doctest::Approx(0.4));
+    }
+
+    TEST_CASE("Copies of a bound biology are unbound")
+    {
+        BiologyStore store;
+        Biology guy(true);
+        store.bind(&guy);
+        Biology copy(guy);
+
+        CHECK_FALSE(copy.is_bound());
+        copy.add_energy(-0.5);
+        CHECK(guy.get_energy() == doctest::Approx(1.0));
+    }
+
+    TEST_CASE("Destroyed biology releases its row")
+    {
+        BiologyStore store;
+        {
+            Biology guy(true);
+            store.bind(&guy);
+        }
+        store.tick();
+        store.clear();
+        CHECK(store.size() == 0);
+    }
+}
+
+// ==================== Tick ====================
+
+TEST_SUITE("BiologyStore - Tick")
+{
+    TEST_CASE("Tick matches Biology::update")
+    {
+        BiologyStore store;
+        std::vector<std::unique_ptr<Biology>> bound;
+        std::vector<Biology> reference;
+        for (int i = 0; i < 16; ++i)
+        {
+            bound.push_back(std::make_unique<Biology>());
+            reference.push_back(*bound.back());
+            store.bind(bound.back().get());
+        }
+
+        for (int tick = 0; tick < 50; ++tick)
+        {
+            store.tick();
+            for (auto& biology : reference)
+            {
+                biology.update();
+            }
+        }
+
+        for (size_t i = 0; i < bound.size(); ++i)
+        {
+            CHECK(bound[i]->get_energy() == reference[i].get_energy());
+            CHECK(bound[i]->get_health() == reference[i].get_health());
+            CHECK(bound[i]->get_water() == reference[i].get_water());
+            CHECK(store.dead(i) == reference[i].check_death());
+        }
+    }
+
+    TEST_CASE("Starved rows die")
+    {
+        BiologyStore store;
+        Biology guy(true);
+        size_t row = store.bind(&guy);
+        store.energy(row) = 0.0;
+        store.health(row) = 0.05;
+
+        CHECK(store.tick() == 1);
+        CHECK(store.dead(row));
+        CHECK(guy.check_death());
+    }
+
+    TEST_CASE("Placeholder rows never die")
+    {
+        BiologyStore store;
+        size_t row = store.bind(nullptr);
+        for (int tick = 0; tick < 1000; ++tick)
+        {
+            store.tick();
+        }
+        CHECK_FALSE(store.dead(row));
+    }
+}
@@ -121,6 +121,39 @@ TEST_SUITE("Entity - Default Initialization")
         CHECK(genetics.find("Energy Efficiency") != genetics.end());
     }
 
+    TEST_CASE("Entity biology view matches the maps")
+    {
+        auto guy = std::make_shared<Biology>(true);
+        auto entity = std::make_shared<Entity>();
+        entity->set_biology(guy);
+        guy->add_energy(-0.25);
+
+        BiologyView view = entity->biology_view();
+        auto metrics = entity->biology_get_metrics();
+        auto genetics = guy->get_genetic_vals();
+
+        CHECK(view.metrics.energy == doctest::Approx(metrics["Energy"]));
+        CHECK(view.metrics.health == doctest::Approx(metrics["Health"]));
+        CHECK(view.metrics.water == doctest::Approx(metrics["Water"]));
+        REQUIRE(view.genes.size() == GENE_COUNT);
+        for (int gene = 0; gene < GENE_COUNT; ++gene)
+        {
+            CHECK(view.genes[gene] == doctest::Approx(genetics[GENE_NAMES[gene]]));
+        }
+
+        guy->set_efficiency("Vision", 0.9);
+        CHECK(view.genes[GENE_VISION] == doctest::Approx(0.9));
+    }
+
+    TEST_CASE("Entity without biology gives an empty view")
+    {
+        auto entity = std::make_shared<Entity>();
+        BiologyView view = entity->biology_view();
+
+        CHECK(view.genes.empty());
+        CHECK(view.metrics.energy == 0.0);
+    }
+
     TEST_CASE("Location setting and getting")
     {
         auto entity = std::make_shared<Entity>();
@@ -0,0 +1,184 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "tests/doctest.h"
+#include "mutate.hpp"
+#include "brain.hpp"
+#include "rng.hpp"
+#include <cmath>
+#include <vector>
+
+// ==================== Sparse Mutation Statistics ====================
+// Every value mutates independently with probability MUTATION_CHANCE, so over many calls
+// the count per call is Binomial(n, p) and hits spread evenly over the buffer.
+
+TEST_SUITE("Mutation - Sparse kernel")
+{
+    TEST_CASE("Mutation count matches Binomial(n, p)")
+    {
+        rng::seed(12345);
+        const size_t n = 5000;
+        const int calls = 2000;
+        const double p = MUTATION_CHANCE;
+        double sum = 0.0, sum_sq = 0.0;
+        for (int c = 0; c < calls; ++c)
+        {
+            std::vector<double> values(n, 0.5);
+            double k = static_cast<double>(mutate_in_place(values));
+            sum += k;
+            sum_sq += k * k;
+        }
+        double mean = sum / calls;
+        double variance = sum_sq / calls - mean * mean;
+        double expected_mean = n * p;
+        double expected_var = n * p * (1.0 - p);
+
+        // 5 standard errors of the sample mean / variance
+        CHECK(std::fabs(mean - expected_mean) < 5.0 * std::sqrt(expected_var / calls));
+        CHECK(std::fabs(variance - expected_var) < 5.0 * expected_var * std::sqrt(2.0 / calls));
+    }
+
+    TEST_CASE("Mutation sites are uniform over the buffer")
+    {
+        rng::seed(777);
+        const size_t n = 1000;
+        const int bins = 10;
+        std::vector<double> hits(bins, 0.0);
+        double total = 0.0;
+        for (int c = 0; c < 3000; ++c)
+        {
+            std::vector<double> values(n, -5.0);    // Any mutation moves a value into [0, 1]
+            mutate_in_place(values);
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (values[i] != -5.0)
+                {
+                    hits[i * bins / n] += 1.0;
+                    total += 1.0;
+                }
+            }
+        }
+        double chi_square = 0.0;
+        for (double h : hits)
+        {
+            double expected = total / bins;
+            chi_square += (h - expected) * (h - expected) / expected;
+        }
+        CHECK(total > 0.0);
+        CHECK(chi_square < 27.88);     // 99.9th percentile of chi-square with 9 degrees of freedom
+    }
+
+    TEST_CASE("About a fifth of the sites are reset rather than nudged")
+    {
+        rng::seed(4242);
+        std::vector<double> values(200000, 0.5);
+        size_t count = mutate_in_place(values);
+        size_t nudged = 0;
+        for (double v : values)
+        {
+            if (v != 0.5 && std::fabs(v - 0.5) <= 0.1)
+            {
+                ++nudged;
+            }
+        }
+        // Resets land in [0.4, 0.6] a fifth of the time, so nudged-looking sites ~ 0.8 + 0.2 * 0.2
+        double fraction = static_cast<double>(nudged) / count;
+        CHECK(fraction == doctest::Approx(0.84).epsilon(0.03));
+    }
+
+    TEST_CASE("Zero chance and empty buffers are untouched")
+    {
+        std::vector<double> values(100, 0.3);
+        CHECK(mutate_in_place(values, 0.0) == 0);
+        CHECK(values == std::vector<double>(100, 0.3));
+        std::vector<double> empty;
+        CHECK(mutate_in_place(empty) == 0);
+    }
+
+    TEST_CASE("Unmutated layer blocks stay shared with the parent")
+    {
+        rng::seed(99);
+        ActivationLayerReLU parent(4, 1);           // 4 weights, 1 bias
+        int shared = 0;
+        for (int c = 0; c < 200; ++c)
+        {
+            ActivationLayerReLU child = parent;
+            if (mutate_layer(child, 0.01) == 0)
+            {
+                CHECK(child.shares_weights_with(parent));
+                ++shared;
+            }
+        }
+        CHECK(shared > 150);                        // 0.99^5 of the time
+        CHECK(parent.get_weights().size() == 4);
+    }
+}
+
+// ==================== Copy-on-write Brains ====================
+
+TEST_SUITE("Mutation - Copy-on-write brains")
+{
+    TEST_CASE("Mutating a copied brain leaves the parent byte-identical")
+    {
+        rng::seed(7);
+        Brain parent({6, 5, 3});
+        const std::vector<uint8_t> before = parent.serialize_genome();
+
+        Brain child = parent;
+        for (size_t l = 0; l < child.get_layers().size(); ++l)
+        {
+            CHECK(child.get_layers()[l].shares_weights_with(parent.get_layers()[l]));
+            CHECK(&child.get_layers()[l].get_biases() == &parent.get_layers()[l].get_biases());
+        }
+
+        for (auto& layer : child.get_layers())
+        {
+            CHECK(mutate_layer(layer, 1.0) == static_cast<size_t>(layer.get_weight_count() + layer.get_biases_count()));
+        }
+
+        CHECK(parent.serialize_genome() == before);
+        CHECK(child.serialize_genome() != before);
+        for (size_t l = 0; l < child.get_layers().size(); ++l)
+        {
+            CAPTURE(l);
+            CHECK_FALSE(child.get_layers()[l].shares_weights_with(parent.get_layers()[l]));
+            CHECK(&child.get_layers()[l].get_biases() != &parent.get_layers()[l].get_biases());
+        }
+    }
+
+    TEST_CASE("Writing a genome into a copy leaves the parent byte-identical")
+    {
+        rng::seed(8);
+        Brain parent({4, 3, 2});
+        const std::vector<uint8_t> before = parent.serialize_genome();
+        const std::vector<uint8_t> other = Brain({4, 3, 2}).serialize_genome();
+
+        Brain child = parent;
+        REQUIRE(child.deserialize_genome(other));
+
+        CHECK(parent.serialize_genome() == before);
+        CHECK(child.serialize_genome() == other);
+        for (size_t l = 0; l < child.get_layers().size(); ++l)
+        {
+            CAPTURE(l);
+            CHECK_FALSE(child.get_layers()[l].shares_weights_with(parent.get_layers()[l]));
+            CHECK(&child.get_layers()[l].get_biases() != &parent.get_layers()[l].get_biases());
+        }
+    }
+
+    TEST_CASE("Only the written block is duplicated")
+    {
+        ActivationLayerReLU parent(3, 2);
+        const std::vector<double> weights = parent.get_weights();
+        const std::vector<double> biases = parent.get_biases();
+        ActivationLayerReLU child = parent;
+
+        child.mutable_biases()[0] += 1.0;
+        CHECK(child.shares_weights_with(parent));
+        CHECK(&child.get_biases() != &parent.get_biases());
+        CHECK(parent.get_weights() == weights);
+        CHECK(parent.get_biases() == biases);
+
+        child.mutable_weights()[0] += 1.0;
+        CHECK_FALSE(child.shares_weights_with(parent));
+        CHECK(parent.get_weights() == weights);
+    }
+}
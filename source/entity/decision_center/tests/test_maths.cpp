@@ -75,4 +75,22 @@ TEST_CASE("Brain and Decision Center Tests") {
     int decision_a = brain.decide(input2);
     int decision_b = brain.decide(input2);
     CHECK(decision_a == decision_b);
-}
\ No newline at end of file
+}
+TEST_CASE("Brain Genome Serialization Tests") {
+    Brain brain({5, 8, 8, 6});
+    std::vector<uint8_t> genome = brain.serialize_genome();
+    // (5*8 + 8) + (8*8 + 8) + (8*6 + 6) doubles
+    CHECK(genome.size() == 174 * sizeof(double));
+
+    // Round trip into a fresh brain of the same shape reproduces every weight
+    Brain copy({5, 8, 8, 6});
+    CHECK(copy.deserialize_genome(genome));
+    CHECK(copy.serialize_genome() == genome);
+    CHECK(copy.get_layers()[1].get_weights() == brain.get_layers()[1].get_weights());
+
+    // Wrong architecture is rejected and left untouched
+    Brain other({5, 4, 6});
+    std::vector<uint8_t> before = other.serialize_genome();
+    CHECK_FALSE(other.deserialize_genome(genome));
+    CHECK(other.serialize_genome() == before);
+}
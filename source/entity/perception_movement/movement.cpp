@@ -23,55 +23,12 @@ Movement::Action Movement::decide_movement(const std::vector<double>& logits) {
 }
 
 Movement::Action Movement::direction_to_action(Direction dir, double base_energy_cost) {
+    const int d = static_cast<unsigned>(dir) < DIRECTION_COUNT ? dir : STAY;
     Action action;
     action.direction = dir;
-    action.energy_cost = base_energy_cost;
-
-    switch (dir) {
-        case NORTH:
-            action.dx = 0;
-            action.dy = -1;
-            break;
-        case SOUTH:
-            action.dx = 0;
-            action.dy = 1;
-            break;
-        case WEST:
-            action.dx = -1;
-            action.dy = 0;
-            break;
-        case EAST:
-            action.dx = 1;
-            action.dy = 0;
-            break;
-        case NORTHEAST:
-            action.dx = 1;
-            action.dy = -1;
-            action.energy_cost = base_energy_cost * 1.414; // Diagonal costs more (sqrt(2))
-            break;
-        case NORTHWEST:
-            action.dx = -1;
-            action.dy = -1;
-            action.energy_cost = base_energy_cost * 1.414;
-            break;
-        case SOUTHEAST:
-            action.dx = 1;
-            action.dy = 1;
-            action.energy_cost = base_energy_cost * 1.414;
-            break;
-        case SOUTHWEST:
-            action.dx = -1;
-            action.dy = 1;
-            action.energy_cost = base_energy_cost * 1.414;
-            break;
-        case STAY:
-        default:
-            action.dx = 0;
-            action.dy = 0;
-            action.energy_cost = 0.0; // No energy cost for staying
-            break;
-    }
-
+    action.dx = DX[d];
+    action.dy = DY[d];
+    action.energy_cost = base_energy_cost * COST_FACTOR[d];
     return action;
 }
 
@@ -114,8 +71,7 @@ std::vector<int> Movement::execute_movement_wraparound(
     int env_width,
     int env_height,
     double& energy) {
-    
-    std::vector<int> prev_coords = {current_x, current_y};
+
     // Calculate new position
     int new_x = (current_x + action.dx) % env_width;
     int new_y = (current_y + action.dy) % env_height;
@@ -124,25 +80,86 @@ std::vector<int> Movement::execute_movement_wraparound(
     if (new_x < 0) new_x += env_width;
     if (new_y < 0) new_y += env_height;
 
-    // Check if new position is within bounds
-    if (new_x < 0 || new_x >= env_width || new_y < 0 || new_y >= env_height) {
-        // Invalid move - stay in place but still consume energy
-        energy -= action.energy_cost * 0.5; // Half energy cost for failed move
-        return prev_coords;
+    // Check if agent has enough energy
+    if (energy >= action.energy_cost) {
+        current_x = new_x;
+        current_y = new_y;
+        energy -= action.energy_cost;
     }
+    return {current_x, current_y};
+}
 
-    // Check if agent has enough energy
-    if (energy < action.energy_cost) {
-        // Not enough energy - cannot move
-        return prev_coords;
+size_t Movement::apply_moves(
+    int* xs,
+    int* ys,
+    double* energy,
+    const uint8_t* directions,
+    size_t count,
+    const Grid& grid,
+    double base_energy_cost) {
+
+    // Per-direction costs once, so the loop body is table loads and selects
+    double cost[DIRECTION_COUNT];
+    for (int d = 0; d < DIRECTION_COUNT; ++d) {
+        cost[d] = base_energy_cost * COST_FACTOR[d];
     }
 
-    // Execute the movement
-    current_x = new_x;
-    current_y = new_y;
-    energy -= action.energy_cost;
-    std::vector<int> new_coords = {current_x, current_y};
-    return new_coords;
+    size_t moved = 0;
+    if (grid.power_of_two()) {
+        for (size_t i = 0; i < count; ++i) {
+            const int d = directions[i] < DIRECTION_COUNT ? directions[i] : static_cast<int>(STAY);
+            const bool ok = energy[i] >= cost[d];
+            xs[i] = ok ? (xs[i] + DX[d]) & grid.mask_x : xs[i];
+            ys[i] = ok ? (ys[i] + DY[d]) & grid.mask_y : ys[i];
+            energy[i] -= ok ? cost[d] : 0.0;
+            moved += ok;
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            const int d = directions[i] < DIRECTION_COUNT ? directions[i] : static_cast<int>(STAY);
+            const bool ok = energy[i] >= cost[d];
+            xs[i] = ok ? wrap(xs[i] + DX[d], grid.width) : xs[i];
+            ys[i] = ok ? wrap(ys[i] + DY[d], grid.height) : ys[i];
+            energy[i] -= ok ? cost[d] : 0.0;
+            moved += ok;
+        }
+    }
+    return moved;
+}
+
+void Movement::resolve_moves(MoveBatch& batch, const Grid& grid, const uint8_t* terrain, double base_energy_cost) {
+    const size_t count = batch.size();
+    const int types = batch.terrain_types;
+    batch.moved.resize(count);
+    batch.energy_drain.resize(count);
+    batch.water_drain.resize(count);
+    batch.steps.resize(count);
+
+    // Tiles to walk per entry: 0 if the entry stays or can't afford its action cost
+    uint8_t* remaining = batch.steps.data();
+    for (size_t i = 0; i < count; ++i) {
+        const int d = batch.direction[i] < DIRECTION_COUNT ? batch.direction[i] : static_cast<int>(STAY);
+        const double cost = base_energy_cost * COST_FACTOR[d] * batch.speed[i];
+        const bool ok = batch.energy[i] >= cost;
+        batch.moved[i] = ok;
+        batch.energy_drain[i] = ok ? cost : 0.0;
+        batch.water_drain[i] = 0.0;
+        remaining[i] = (ok && d != STAY) ? batch.speed[i] : 0;
+    }
+
+    for (int s = 0; s < MAX_SPEED; ++s) {
+        for (size_t i = 0; i < count; ++i) {
+            const bool active = remaining[i] > s;
+            const int d = batch.direction[i] < DIRECTION_COUNT ? batch.direction[i] : static_cast<int>(STAY);
+            const int nx = grid.mask_x >= 0 ? (batch.x[i] + DX[d]) & grid.mask_x : wrap(batch.x[i] + DX[d], grid.width);
+            const int ny = grid.mask_y >= 0 ? (batch.y[i] + DY[d]) & grid.mask_y : wrap(batch.y[i] + DY[d], grid.height);
+            batch.x[i] = active ? nx : batch.x[i];
+            batch.y[i] = active ? ny : batch.y[i];
+            const size_t rate = i * types + terrain[static_cast<size_t>(batch.x[i]) * grid.height + batch.y[i]];
+            batch.energy_drain[i] += active ? batch.energy_rate[rate] : 0.0;
+            batch.water_drain[i] += active ? batch.water_rate[rate] : 0.0;
+        }
+    }
 }
 
 bool Movement::is_valid_position(int x, int y, Environment& environment) {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 // Forward declaration
@@ -31,6 +33,118 @@ public:
         double energy_cost;     // Energy cost of this action
     };
 
+    // Per-direction tables, indexed by Direction
+    static constexpr int DIRECTION_COUNT = 9;
+    static constexpr int8_t DX[DIRECTION_COUNT] = {0, 0, -1, 1, 1, -1, 1, -1, 0};
+    static constexpr int8_t DY[DIRECTION_COUNT] = {-1, 1, 0, 0, -1, -1, 1, 1, 0};
+    static constexpr double COST_FACTOR[DIRECTION_COUNT] = {1.0, 1.0, 1.0, 1.0, 1.414, 1.414, 1.414, 1.414, 0.0};   // Diagonals cost sqrt(2)
+
+    /**
+     * Toroidal grid dimensions, with masks precomputed when a side is a power of two
+     */
+    struct Grid {
+        int width;
+        int height;
+        int mask_x;             // width - 1 if width is a power of two, otherwise -1
+        int mask_y;
+
+        static constexpr int mask_for(int size) { return (size > 0 && (size & (size - 1)) == 0) ? size - 1 : -1; }
+        static constexpr Grid make(int width, int height) { return Grid{width, height, mask_for(width), mask_for(height)}; }
+        constexpr bool power_of_two() const { return mask_x >= 0 && mask_y >= 0; }
+    };
+
+    /**
+     * Result of one wraparound step; plain data, returned in registers
+     */
+    struct Step {
+        int x;
+        int y;
+        double energy_cost;     // Energy spent, 0 if the entity couldn't afford the move
+        bool moved;
+    };
+
+    /**
+     * Wraps a coordinate that is at most one step outside [0, size) without branching
+     */
+    static constexpr int wrap(int value, int size) {
+        value += size & -static_cast<int>(value < 0);
+        value -= size & -static_cast<int>(value >= size);
+        return value;
+    }
+
+    /**
+     * One table-driven move on a torus, same rules as execute_movement_wraparound: the move
+     * happens only if energy covers its cost, and the cost is only charged when it does
+     * @param dir - Direction; anything past STAY is treated as STAY
+     */
+    static constexpr Step step_wraparound(int x, int y, Direction dir, const Grid& grid, double energy, double base_energy_cost) {
+        const int d = static_cast<unsigned>(dir) < DIRECTION_COUNT ? dir : STAY;
+        const double cost = base_energy_cost * COST_FACTOR[d];
+        const bool affordable = energy >= cost;
+        const int nx = grid.mask_x >= 0 ? (x + DX[d]) & grid.mask_x : wrap(x + DX[d], grid.width);
+        const int ny = grid.mask_y >= 0 ? (y + DY[d]) & grid.mask_y : wrap(y + DY[d], grid.height);
+        return Step{affordable ? nx : x, affordable ? ny : y, affordable ? cost : 0.0, affordable};
+    }
+
+    /**
+     * Applies one move per entity across structure-of-arrays state in a single pass
+     * @param xs, ys - Positions, updated in place
+     * @param energy - Energy per entity, charged in place for moves that happen
+     * @param directions - Direction per entity
+     * @return Number of entities that moved (STAY counts as a move, as in step_wraparound)
+     */
+    static size_t apply_moves(int* xs, int* ys, double* energy, const uint8_t* directions, size_t count,
+                              const Grid& grid, double base_energy_cost);
+
+    static constexpr int MAX_SPEED = 3;     // Tiles per move at full speed
+
+    /**
+     * One tick's moves in structure-of-arrays form, one entry per moving entity
+     * Each entry carries its entity's drain per terrain type, so walking a path costs one
+     * table load per tile entered.
+     */
+    struct MoveBatch {
+        int terrain_types = 0;
+        std::vector<int> x;
+        std::vector<int> y;
+        std::vector<uint8_t> direction;
+        std::vector<uint8_t> speed;             // Tiles to move, 1 to MAX_SPEED
+        std::vector<double> energy;             // Available energy; gates the move as in step_wraparound
+        std::vector<double> energy_rate;        // [entry * terrain_types + terrain id]
+        std::vector<double> water_rate;
+
+        // Filled in by resolve_moves
+        std::vector<uint8_t> moved;
+        std::vector<double> energy_drain;       // Action cost plus terrain drain along the path
+        std::vector<double> water_drain;
+        std::vector<uint8_t> steps;             // Tiles actually walked
+
+        void clear(int types) {
+            terrain_types = types;
+            x.clear(); y.clear(); direction.clear(); speed.clear(); energy.clear();
+            energy_rate.clear(); water_rate.clear();
+        }
+        size_t size() const { return x.size(); }
+        void push(int px, int py, Direction dir, int tiles, double available,
+                  const double* energy_rates, const double* water_rates) {
+            x.push_back(px);
+            y.push_back(py);
+            direction.push_back(static_cast<uint8_t>(dir));
+            speed.push_back(static_cast<uint8_t>(tiles < 1 ? 1 : tiles > MAX_SPEED ? MAX_SPEED : tiles));
+            energy.push_back(available);
+            energy_rate.insert(energy_rate.end(), energy_rates, energy_rates + terrain_types);
+            water_rate.insert(water_rate.end(), water_rates, water_rates + terrain_types);
+        }
+    };
+
+    /**
+     * Walks every queued move up to speed tiles on a torus, one step for all entries at a
+     * time, adding each entered tile's terrain drain. STAY walks no tiles.
+     * @param terrain - Terrain id per tile, indexed x * grid.height + y
+     * @param base_energy_cost - Per-tile action cost, charged speed times (diagonals x1.414)
+     */
+    static void resolve_moves(MoveBatch& batch, const Grid& grid, const uint8_t* terrain, double base_energy_cost);
+
     /**
      * Convert brain output (decision logits) to a movement action
      * Uses argmax to select the action with highest score
@@ -0,0 +1,316 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "entity/decision_center/tests/doctest.h"
+#include "movement.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    const Movement::Direction ALL_DIRECTIONS[] = {
+        Movement::NORTH, Movement::SOUTH, Movement::WEST, Movement::EAST, Movement::NORTHEAST,
+        Movement::NORTHWEST, Movement::SOUTHEAST, Movement::SOUTHWEST, Movement::STAY};
+
+    // The modulo version every table-driven path has to agree with
+    Movement::Step legacy_step(int x, int y, Movement::Direction dir, int width, int height, double energy, double base_cost)
+    {
+        const Movement::Action action = Movement::direction_to_action(dir, base_cost);
+        const double before = energy;
+        Movement::execute_movement_wraparound(x, y, action, width, height, energy);
+        return Movement::Step{x, y, before - energy, energy != before || action.energy_cost == 0.0};
+    }
+
+    // Terrain id per tile, indexed x * height + y, cycling through the types
+    std::vector<uint8_t> make_terrain(int width, int height, int types)
+    {
+        std::vector<uint8_t> terrain(static_cast<size_t>(width) * height);
+        for (int x = 0; x < width; ++x)
+        {
+            for (int y = 0; y < height; ++y)
+            {
+                terrain[static_cast<size_t>(x) * height + y] = static_cast<uint8_t>((x + 2 * y) % types);
+            }
+        }
+        return terrain;
+    }
+
+    const double ENERGY_RATES[] = {0.01, 0.02, 0.04, 0.08};
+    const double WATER_RATES[] = {0.001, 0.003, 0.005, 0.007};
+}
+
+// ==================== Tables ====================
+
+TEST_SUITE("Movement - Tables")
+{
+    TEST_CASE("DX and DY match the compass")
+    {
+        CHECK(Movement::DX[Movement::NORTH] == 0);
+        CHECK(Movement::DY[Movement::NORTH] == -1);
+        CHECK(Movement::DX[Movement::SOUTH] == 0);
+        CHECK(Movement::DY[Movement::SOUTH] == 1);
+        CHECK(Movement::DX[Movement::WEST] == -1);
+        CHECK(Movement::DY[Movement::WEST] == 0);
+        CHECK(Movement::DX[Movement::EAST] == 1);
+        CHECK(Movement::DY[Movement::EAST] == 0);
+        CHECK(Movement::DX[Movement::NORTHEAST] == 1);
+        CHECK(Movement::DY[Movement::NORTHEAST] == -1);
+        CHECK(Movement::DX[Movement::NORTHWEST] == -1);
+        CHECK(Movement::DY[Movement::NORTHWEST] == -1);
+        CHECK(Movement::DX[Movement::SOUTHEAST] == 1);
+        CHECK(Movement::DY[Movement::SOUTHEAST] == 1);
+        CHECK(Movement::DX[Movement::SOUTHWEST] == -1);
+        CHECK(Movement::DY[Movement::SOUTHWEST] == 1);
+        CHECK(Movement::DX[Movement::STAY] == 0);
+        CHECK(Movement::DY[Movement::STAY] == 0);
+    }
+
+    TEST_CASE("direction_to_action reads the tables")
+    {
+        for (Movement::Direction dir : ALL_DIRECTIONS)
+        {
+            CAPTURE(dir);
+            const Movement::Action action = Movement::direction_to_action(dir, 0.5);
+            CHECK(action.dx == Movement::DX[dir]);
+            CHECK(action.dy == Movement::DY[dir]);
+            CHECK(action.energy_cost == doctest::Approx(0.5 * Movement::COST_FACTOR[dir]));
+        }
+    }
+
+    TEST_CASE("Grid masks only power-of-two sides")
+    {
+        CHECK(Movement::Grid::make(64, 32).power_of_two());
+        CHECK(Movement::Grid::make(64, 32).mask_x == 63);
+        CHECK(Movement::Grid::make(60, 32).mask_x == -1);
+        CHECK_FALSE(Movement::Grid::make(60, 32).power_of_two());
+        CHECK(Movement::Grid::mask_for(0) == -1);
+        CHECK(Movement::Grid::mask_for(1) == 0);
+    }
+}
+
+// ==================== Wraparound ====================
+
+TEST_SUITE("Movement - Wraparound")
+{
+    TEST_CASE("wrap brings one step either side back onto the grid")
+    {
+        CHECK(Movement::wrap(-1, 10) == 9);
+        CHECK(Movement::wrap(10, 10) == 0);
+        CHECK(Movement::wrap(0, 10) == 0);
+        CHECK(Movement::wrap(9, 10) == 9);
+        CHECK(Movement::wrap(-1, 1) == 0);
+        static_assert(Movement::wrap(-1, 7) == 6, "wrap is constexpr");
+    }
+
+    TEST_CASE("step_wraparound matches execute_movement_wraparound")
+    {
+        const int sizes[][2] = {{16, 16}, {32, 8}, {10, 10}, {7, 13}, {16, 5}};
+        for (const auto& size : sizes)
+        {
+            const Movement::Grid grid = Movement::Grid::make(size[0], size[1]);
+            for (Movement::Direction dir : ALL_DIRECTIONS)
+            {
+                // Corners, edges and the middle, so every side wraps at least once
+                const int xs[] = {0, 1, size[0] / 2, size[0] - 1};
+                const int ys[] = {0, 1, size[1] / 2, size[1] - 1};
+                for (int x : xs)
+                {
+                    for (int y : ys)
+                    {
+                        CAPTURE(size[0]);
+                        CAPTURE(size[1]);
+                        CAPTURE(dir);
+                        CAPTURE(x);
+                        CAPTURE(y);
+                        const Movement::Step expected = legacy_step(x, y, dir, size[0], size[1], 1.0, 0.1);
+                        const Movement::Step step = Movement::step_wraparound(x, y, dir, grid, 1.0, 0.1);
+                        CHECK(step.x == expected.x);
+                        CHECK(step.y == expected.y);
+                        CHECK(step.energy_cost == doctest::Approx(expected.energy_cost));
+                        CHECK(step.moved);
+                    }
+                }
+            }
+        }
+    }
+
+    TEST_CASE("Negative steps wrap to the far side")
+    {
+        const Movement::Grid pow2 = Movement::Grid::make(16, 16);
+        const Movement::Grid odd = Movement::Grid::make(15, 9);
+        Movement::Step step = Movement::step_wraparound(0, 0, Movement::NORTHWEST, pow2, 1.0, 0.1);
+        CHECK(step.x == 15);
+        CHECK(step.y == 15);
+        step = Movement::step_wraparound(0, 0, Movement::NORTHWEST, odd, 1.0, 0.1);
+        CHECK(step.x == 14);
+        CHECK(step.y == 8);
+        step = Movement::step_wraparound(14, 8, Movement::SOUTHEAST, odd, 1.0, 0.1);
+        CHECK(step.x == 0);
+        CHECK(step.y == 0);
+    }
+
+    TEST_CASE("Unaffordable steps stay put and cost nothing")
+    {
+        const Movement::Grid grid = Movement::Grid::make(10, 10);
+        const Movement::Step step = Movement::step_wraparound(3, 4, Movement::NORTHEAST, grid, 0.1, 0.1);
+        const Movement::Step expected = legacy_step(3, 4, Movement::NORTHEAST, 10, 10, 0.1, 0.1);
+        CHECK_FALSE(step.moved);
+        CHECK(step.x == expected.x);
+        CHECK(step.y == expected.y);
+        CHECK(step.energy_cost == 0.0);
+        CHECK(expected.energy_cost == 0.0);
+    }
+
+    TEST_CASE("Directions past STAY are treated as STAY")
+    {
+        const Movement::Grid grid = Movement::Grid::make(10, 10);
+        const Movement::Step step = Movement::step_wraparound(3, 4, static_cast<Movement::Direction>(12), grid, 1.0, 0.1);
+        CHECK(step.x == 3);
+        CHECK(step.y == 4);
+        CHECK(step.energy_cost == 0.0);
+    }
+}
+
+// ==================== Batches ====================
+
+TEST_SUITE("Movement - apply_moves")
+{
+    TEST_CASE("apply_moves matches execute_movement_wraparound per entity")
+    {
+        const int sizes[][2] = {{16, 16}, {11, 7}};
+        for (const auto& size : sizes)
+        {
+            CAPTURE(size[0]);
+            const Movement::Grid grid = Movement::Grid::make(size[0], size[1]);
+            std::vector<int> xs, ys;
+            std::vector<double> energy;
+            std::vector<uint8_t> directions;
+            for (int i = 0; i < 40; ++i)
+            {
+                xs.push_back((i * 5) % size[0]);
+                ys.push_back((i * 3) % size[1]);
+                energy.push_back(i % 4 == 0 ? 0.05 : 1.0);      // Some can't afford a step
+                directions.push_back(static_cast<uint8_t>(i % 11));     // Includes out-of-range values
+            }
+
+            std::vector<int> expected_x = xs, expected_y = ys;
+            std::vector<double> expected_energy = energy;
+            size_t expected_moved = 0;
+            for (size_t i = 0; i < xs.size(); ++i)
+            {
+                const Movement::Direction dir = directions[i] < Movement::DIRECTION_COUNT
+                    ? static_cast<Movement::Direction>(directions[i]) : Movement::STAY;
+                const Movement::Action action = Movement::direction_to_action(dir, 0.1);
+                expected_moved += expected_energy[i] >= action.energy_cost;
+                Movement::execute_movement_wraparound(expected_x[i], expected_y[i], action, size[0], size[1], expected_energy[i]);
+            }
+
+            const size_t moved = Movement::apply_moves(xs.data(), ys.data(), energy.data(), directions.data(), xs.size(), grid, 0.1);
+            CHECK(moved == expected_moved);
+            for (size_t i = 0; i < xs.size(); ++i)
+            {
+                CAPTURE(i);
+                CHECK(xs[i] == expected_x[i]);
+                CHECK(ys[i] == expected_y[i]);
+                CHECK(energy[i] == doctest::Approx(expected_energy[i]));
+            }
+        }
+    }
+}
+
+// ==================== Multi-tile moves ====================
+
+TEST_SUITE("Movement - resolve_moves")
+{
+    TEST_CASE("A multi-tile path sums the terrain of every tile entered")
+    {
+        const int sizes[][2] = {{8, 8}, {7, 5}};
+        for (const auto& size : sizes)
+        {
+            CAPTURE(size[0]);
+            const Movement::Grid grid = Movement::Grid::make(size[0], size[1]);
+            const std::vector<uint8_t> terrain = make_terrain(size[0], size[1], 4);
+            Movement::MoveBatch batch;
+            batch.clear(4);
+            batch.push(size[0] - 2, 1, Movement::EAST, 3, 1.0, ENERGY_RATES, WATER_RATES);       // Wraps in x
+            Movement::resolve_moves(batch, grid, terrain.data(), 0.1);
+
+            double energy = 0.1 * 3;
+            double water = 0.0;
+            int x = size[0] - 2;
+            for (int s = 0; s < 3; ++s)
+            {
+                x = Movement::wrap(x + 1, size[0]);
+                energy += ENERGY_RATES[terrain[static_cast<size_t>(x) * size[1] + 1]];
+                water += WATER_RATES[terrain[static_cast<size_t>(x) * size[1] + 1]];
+            }
+            CHECK(batch.moved[0]);
+            CHECK(batch.steps[0] == 3);
+            CHECK(batch.x[0] == x);
+            CHECK(batch.y[0] == 1);
+            CHECK(batch.energy_drain[0] == doctest::Approx(energy));
+            CHECK(batch.water_drain[0] == doctest::Approx(water));
+        }
+    }
+
+    TEST_CASE("Diagonal action cost scales by COST_FACTOR per tile")
+    {
+        const Movement::Grid grid = Movement::Grid::make(8, 8);
+        const std::vector<uint8_t> terrain(64, 0);
+        const double no_drain[] = {0.0};
+        Movement::MoveBatch batch;
+        batch.clear(1);
+        batch.push(4, 4, Movement::NORTHEAST, 2, 1.0, no_drain, no_drain);
+        batch.push(4, 4, Movement::NORTH, 2, 1.0, no_drain, no_drain);
+        Movement::resolve_moves(batch, grid, terrain.data(), 0.1);
+
+        CHECK(batch.energy_drain[0] == doctest::Approx(0.1 * Movement::COST_FACTOR[Movement::NORTHEAST] * 2));
+        CHECK(batch.energy_drain[1] == doctest::Approx(0.1 * 2));
+        CHECK(batch.x[0] == 6);
+        CHECK(batch.y[0] == 2);
+        CHECK(batch.x[1] == 4);
+        CHECK(batch.y[1] == 2);
+    }
+
+    TEST_CASE("Speed is clamped to 1..MAX_SPEED")
+    {
+        const Movement::Grid grid = Movement::Grid::make(16, 16);
+        const std::vector<uint8_t> terrain(256, 0);
+        const double no_drain[] = {0.0};
+        Movement::MoveBatch batch;
+        batch.clear(1);
+        batch.push(0, 0, Movement::SOUTH, 0, 1.0, no_drain, no_drain);
+        batch.push(0, 0, Movement::SOUTH, -4, 1.0, no_drain, no_drain);
+        batch.push(0, 0, Movement::SOUTH, Movement::MAX_SPEED + 5, 1.0, no_drain, no_drain);
+        CHECK(batch.speed[0] == 1);
+        CHECK(batch.speed[1] == 1);
+        CHECK(batch.speed[2] == Movement::MAX_SPEED);
+
+        Movement::resolve_moves(batch, grid, terrain.data(), 0.1);
+        CHECK(batch.y[0] == 1);
+        CHECK(batch.y[1] == 1);
+        CHECK(batch.y[2] == Movement::MAX_SPEED);
+        CHECK(batch.steps[2] == Movement::MAX_SPEED);
+    }
+
+    TEST_CASE("Unaffordable moves and STAY walk no tiles")
+    {
+        const Movement::Grid grid = Movement::Grid::make(8, 8);
+        const std::vector<uint8_t> terrain = make_terrain(8, 8, 4);
+        Movement::MoveBatch batch;
+        batch.clear(4);
+        batch.push(3, 3, Movement::WEST, 3, 0.25, ENERGY_RATES, WATER_RATES);     // Needs 0.3
+        batch.push(3, 3, Movement::STAY, 3, 1.0, ENERGY_RATES, WATER_RATES);
+        Movement::resolve_moves(batch, grid, terrain.data(), 0.1);
+
+        CHECK_FALSE(batch.moved[0]);
+        CHECK(batch.steps[0] == 0);
+        CHECK(batch.x[0] == 3);
+        CHECK(batch.energy_drain[0] == 0.0);
+        CHECK(batch.water_drain[0] == 0.0);
+
+        CHECK(batch.moved[1]);
+        CHECK(batch.steps[1] == 0);
+        CHECK(batch.x[1] == 3);
+        CHECK(batch.y[1] == 3);
+        CHECK(batch.energy_drain[1] == 0.0);
+    }
+}
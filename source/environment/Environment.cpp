@@ -24,10 +24,12 @@
 // Tile class, holds environment data at coordinate position.
 class Tile{
 	std::vector<double> values; // currently an arbitrary value for tracking things like noise
+    int terrain_id; // index of terrain_type, 0 to Environment::TERRAIN_TYPES - 1
     std::string terrain_type; // placeholder for now, will be used to track the type of terrain for the tile, which will affect movement and energy drain for entities on it. Will likely be an int or enum in practice, but string is easier for testing for now.
 	public:
 		Tile(std::vector<double> value_list) {
-            terrain_type="Terrain Efficiency " + std::to_string(rand() % 3 + 1); // placeholder random terrain type
+            terrain_id = rand() % Environment::TERRAIN_TYPES; // placeholder random terrain type
+            terrain_type = Environment::terrainName(terrain_id);
             for(auto value : value_list){
                 values.push_back(value); //placeholder random value noise
             }
@@ -36,6 +38,7 @@ class Tile{
         void setValues(std::vector<double> v){values = v;};
         void setValue(double v, int index){values[index] = v;};
         std::string getTerrainType(){return terrain_type;};
+        int getTerrainId(){return terrain_id;};
         
 };
 
@@ -53,8 +56,19 @@ Environment::Environment(int size_x, int size_y){
         }
         tiles.push_back(tile_col);
     }
+    // flat copy of every tile's terrain id, so path costs are an array load instead of a string
+    terrain_ids.reserve(static_cast<size_t>(_size_x) * _size_y);
+    for(auto& column : tiles){
+        for(Tile* tile : column){
+            terrain_ids.push_back(static_cast<uint8_t>(tile->getTerrainId()));
+        }
+    }
 };
 
+std::string Environment::terrainName(int id){
+    return "Terrain Efficiency " + std::to_string(id + 1);
+}
+
 // function that converts and clamps passed position data to chunk, tile coordinates of range [0, chunks * tiles per chunk - 1].
 Vector2d Environment::boundCoords(Vector2d pos){
     // Converts absolute position coordinates to the array index system.
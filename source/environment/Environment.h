@@ -7,6 +7,8 @@
 #ifndef ENVIRONMENT_H
 #define ENVIRONMENT_H
 
+#include <cstdint>
+#include <string>
 #include <tuple>
 #include <iostream>
 #include <vector>       // added vector dep to change up arrays
@@ -26,7 +28,11 @@ private:
     int _size_y;
     std::vector<std::vector<Tile*>> tiles;    
     std::unordered_map <int, Vector2d> tile_map; // get the X,Y for it for simplicity
+    std::vector<uint8_t> terrain_ids; // terrain id per tile, column-major (x * tile amount Y + y)
 public:
+    static constexpr int TERRAIN_TYPES = 3;
+    static std::string terrainName(int id); // the terrain type string for a terrain id
+
     Environment(int size_x, int size_y);
     Vector2d boundCoords(Vector2d pos);
 
@@ -40,6 +46,8 @@ public:
     int getTileAmountX() {return tiles.size();};
     int getTileAmountY() {return tiles[0].size();};
     int getTileArea() {return tiles[0].size() * tiles.size();};
+    int getTerrainId(int x, int y) const {return terrain_ids[static_cast<size_t>(x) * _size_y + y];};
+    const uint8_t* getTerrainIds() const {return terrain_ids.data();};
     Vector2d getTileFromID(int id);
 };
 
@@ -79,6 +79,7 @@ public:
     size_t removeDepletedResources();
     
     size_t getResourceCount() const { return m_resources.size(); }
+    const vector<unique_ptr<ResourceNode>>& getResources() const { return m_resources; }
     double getTotalEnergy() const;
     void clear();
 
@@ -9,8 +9,11 @@
 #include "../environment/resource_node.h"
 #include "../entity/decision_center/mutate.hpp"
 #include "../entity/decision_center/biology_constants.hpp"
+#include "../entity/decision_center/rng.hpp"
+#include "profiler.h"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <format>
 
@@ -23,6 +26,11 @@ Simulation::~Simulation() = default;
 
 void Simulation::initialize()
 {
+    _state_hash = 0;
+    _entity_terms.clear();
+    _terrain_rates.clear();
+    _move_slots.clear();
+
     // Create a new environment
     int size = 32;
     _environment = std::make_unique<Environment>(size, size);
@@ -37,6 +45,7 @@ void Simulation::initialize()
             Vector2d pos = Vector2d(x,y);
             double curr_noise_val = _perlin.SampleLayered(pos);
             _environment->setTileValue(pos, curr_noise_val, 0);
+            _state_hash += tile_term(x, y);
         }
     }
     std::cout << "Environment noise loaded!" << std::endl;
@@ -46,8 +55,8 @@ void Simulation::initialize()
     std::cout << "Entity created successfully with ID: " << entity->get_id() << std::endl;
     entity->set_coordinates(Vector2d(0, 0)); // Set initial coordinates for the entity
     // Create a brain with a neural network architecture
-    // Architecture: 28 inputs -> 8 hidden -> 8 hidden -> 6 outputs () (128 inputs for 5x5 perception of 3 environtypes and food and water + 3 internal state metrics)
-    std::vector<int> layer_sizes = {128, 200, 200, 6}; // 28 because perception size is 5x5 and then the entity's internal state (3 values for now)
+    // Architecture: 128 inputs -> 200 hidden -> 200 hidden -> an action head and a speed head (see decode_decision)
+    std::vector<int> layer_sizes = {128, 200, 200, BRAIN_OUTPUTS}; // 128 = 5 perception types x 5x5 tiles + 3 internal state metrics
     auto brain = std::make_shared<Brain>(layer_sizes);
     std::cout << "Brain created successfully with " << brain->get_layer_count() << " layers!" << std::endl;
 
@@ -62,6 +71,7 @@ void Simulation::initialize()
 
     // Add entity to the simulation
     _entities.push_back(std::move(entity));
+    rebind_biology();
 
     // Add perception to sim class
     _perception = std::make_unique<Perception>();
@@ -70,21 +80,27 @@ void Simulation::initialize()
     // Add resource manager
     _resource_manager = std::make_unique<ResourceManager>();
     seed_resources();
+    refresh_entity_terms();
     std::cout << "Resource manager initialized successfully!" << std::endl;
 }
 
 void Simulation::seed_resources()
 {
     // Example of seeding some resources in the environment
+    for (const auto& resource : _resource_manager->getResources())
+    {
+        _state_hash -= resource_term(*resource);
+    }
     _resource_manager->clear(); // Clear existing resources before seeding new ones
     for (int x =0; x < _environment->getTileAmountX(); x += 1) {
         for (int y = 0; y < _environment->getTileAmountY(); y += 1) {
-            float randomValue = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+            double randomValue = rng::unit();
             if (randomValue > 0.9){ // 10% chance to create a resource
-                ResourceType type = static_cast<ResourceType>(rand() % 2); // Randomly choose a resource type
-                double energyValue = static_cast<double>(rand()) / static_cast<double>(RAND_MAX); // Random energy value between 0 and 1
-                bool renewable = (rand() % 2) == 0; // Randomly decide if it's renewable
-                _resource_manager->createResource(Position(x, y), type, energyValue, renewable);
+                ResourceType type = static_cast<ResourceType>(rng::next_int(2)); // Randomly choose a resource type
+                double energyValue = rng::unit(); // Random energy value between 0 and 1
+                bool renewable = rng::next_int(2) == 0; // Randomly decide if it's renewable
+                ResourceNode* resource = _resource_manager->createResource(Position(x, y), type, energyValue, renewable);
+                _state_hash += resource_term(*resource);
                 /*
                 std::cout << "Seeded resource at (" << x << ", " << y << ") with energy " << energyValue 
                           << " and type " << (type == ResourceType::FOOD ? "FOOD" : "WATER") 
@@ -102,13 +118,22 @@ float Simulation::environGetTileValue(int x, int y) const
 
 
 Entity* Simulation::reproduce(Entity* p1, Entity* p2)
+{
+    Entity* child = new Entity();
+    breed_into(*p1, *p2, *child);
+    _entities.push_back(std::unique_ptr<Entity>(child));
+    _biology_store.bind(child->get_biology().get());
+    return child;
+}
+
+void Simulation::breed_into(const Entity& p1, const Entity& p2, Entity& child) const
 {
     // Redirect cout to null to suppress output during reproduction
     std::streambuf* originalCoutBuffer = std::cout.rdbuf();
     std::cout.rdbuf(nullptr);
-    Entity* brainParent = (rand() % 2 == 0) ? p1 : p2; // pick one parent for brain
-    std::unordered_map<std::string, double> p1_genetics = p1->biology_get_genetics();
-    std::unordered_map<std::string, double> p2_genetics = p2->biology_get_genetics();
+    const Entity* brainParent = (rng::next_int(2) == 0) ? &p1 : &p2; // pick one parent for brain
+    std::unordered_map<std::string, double> p1_genetics = p1.get_biology()->get_genetic_vals();
+    std::unordered_map<std::string, double> p2_genetics = p2.get_biology()->get_genetic_vals();
     std::unordered_map<std::string, double> child_genetics;
     // make a choice between each parent for each value in the genetics and then mutate it before passing to the child
     for (const auto& pair : p1_genetics)
@@ -116,59 +141,69 @@ Entity* Simulation::reproduce(Entity* p1, Entity* p2)
         const std::string& gene = pair.first;
         double val1 = pair.second;
         double val2 = p2_genetics[gene];
-        double chosen_val = (rand() % 2 == 0) ? val1 : val2; // Randomly choose one parent's value
+        double chosen_val = (rng::next_int(2) == 0) ? val1 : val2; // Randomly choose one parent's value
         child_genetics[gene] = chosen_val;
     }
     // Mutate the child's genetics
     child_genetics = mutate_genetics(child_genetics);
-    // Create a new entity with the child's genetics
-    Entity* child = new Entity();
-    child->set_biology(std::make_shared<Biology>(false)); // false for random genetics, will be overwritten by set_genetic_vals
-    child->get_biology()->set_genetic_vals(child_genetics);
-    // Copy the parents brain, mutate hthe weights and biases, and set it to the child,
-    child->set_brain(std::make_shared<Brain>(*brainParent->get_brain()));   
+    // Reuse the slot's biology when it has one, topping the vitals back up like a fresh Biology
+    if (child.get_biology()) {
+        child.get_biology()->add_energy(1.);
+        child.get_biology()->add_health(1.);
+        child.get_biology()->add_water(1.);
+    } else {
+        child.set_biology(std::make_shared<Biology>(false)); // false for random genetics, will be overwritten by set_genetic_vals
+    }
+    child.get_biology()->set_genetic_vals(child_genetics);
+    // Child layers start as shared copies of the parent's; only blocks that draw a mutation get their own storage
     std::vector<ActivationLayerReLU>& parent_layers = brainParent->get_brain()->get_layers();
-    int layer_index = 0;
-    for (auto& layer : parent_layers) {
-        std::vector<double> mutated_weights = mutate_vector(layer.get_weights());
-        std::vector<double> mutated_biases = mutate_vector(layer.get_biases());
-        child->get_brain()->get_layers()[layer_index].ActivationLayerReLUOffsping(mutated_weights, mutated_biases);
-        layer_index++;
-    }
-    // child-get_brain()->set_layers(mutated_layers);
-    _entities.push_back(std::unique_ptr<Entity>(child));
+    if (child.get_brain()) {
+        child.get_brain()->set_layers(parent_layers);
+    } else {
+        child.set_brain(std::make_shared<Brain>(*brainParent->get_brain()));
+    }
+    for (auto& layer : child.get_brain()->get_layers()) {
+        mutate_layer(layer);
+    }
+    // brain parent is the delta base when the child's genome gets saved
+    child.assign_new_id();
+    child.set_lineage(brainParent->get_id(), brainParent->get_generation() + 1);
     // Restore the original cout buffer
     std::cout.rdbuf(originalCoutBuffer);
-    return child;
 }
 
 void Simulation::set_primary_entity(const Entity& entity){
     _entities.clear();
+    _terrain_rates.clear();
     
     auto cloned = std::make_unique<Entity>();
     //cloned->set_coordinates(Vector2d(0,0)); // Set initial coordinates for the entity
-    cloned->set_coordinates(Vector2d(rand() % _environment->getTileAmountX(), rand() % _environment->getTileAmountY())); // Set random initial coordinates for the entity
+    cloned->set_coordinates(Vector2d(rng::next_int(_environment->getTileAmountX()), rng::next_int(_environment->getTileAmountY()))); // Set random initial coordinates for the entity
     if (entity.get_brain()) {
         cloned->set_brain(std::make_unique<Brain>(*entity.get_brain()));
     }
     if (entity.get_biology()) {
         cloned->set_biology(std::make_unique<Biology>(*entity.get_biology()));
     }
+    cloned->set_lineage(entity.get_parent_id(), entity.get_generation()); // same genome, same ancestry
     // Make sure the clone doesn't copy the metrics of the original.
     cloned->get_biology()->add_energy(1.);
     cloned->get_biology()->add_health(1.);
     cloned->get_biology()->add_water(1.);
     _entities.push_back(std::move(cloned));
+    rebind_biology();
+    refresh_entity_terms();
 }
 void Simulation::set_primary_entity_random(){
     _entities.clear(); // Clear existing entities
+    _terrain_rates.clear();
     auto entity = std::make_unique<Entity>();
     std::cout << "Entity created successfully with ID: " << entity->get_id() << std::endl;
     //entity->set_coordinates(Vector2d(0, 0)); // Set initial coordinates for the entity
-    entity->set_coordinates(Vector2d(rand() % _environment->getTileAmountX(), rand() % _environment->getTileAmountY())); // Set random initial coordinates for the entity
+    entity->set_coordinates(Vector2d(rng::next_int(_environment->getTileAmountX()), rng::next_int(_environment->getTileAmountY()))); // Set random initial coordinates for the entity
     // Create a brain with a neural network architecture
-    // Architecture: 28 inputs -> 8 hidden -> 8 hidden -> 6 outputs () (128 inputs for 5x5 perception of 3 environtypes and food and water + 3 internal state metrics)
-    std::vector<int> layer_sizes = {128, 200, 200, 6}; // 28 because perception size is 5x5 and then the entity's internal state (3 values for now)
+    // Architecture: 128 inputs -> 200 hidden -> 200 hidden -> an action head and a speed head (see decode_decision)
+    std::vector<int> layer_sizes = {128, 200, 200, BRAIN_OUTPUTS}; // 128 = 5 perception types x 5x5 tiles + 3 internal state metrics
     auto brain = std::make_shared<Brain>(layer_sizes);
     std::cout << "Brain created successfully with " << brain->get_layer_count() << " layers!" << std::endl;
 
@@ -183,6 +218,8 @@ void Simulation::set_primary_entity_random(){
 
     // Add entity to the simulation
     _entities.push_back(std::move(entity));
+    rebind_biology();
+    refresh_entity_terms();
 }
 Entity* Simulation::get_primary_entity() const
 {
@@ -195,17 +232,19 @@ Entity* Simulation::get_primary_entity() const
 
 std::vector<double> Simulation::get_perception() const
 {
+    PROFILE_SCOPE("tick/perception");
     Perception::SensoryInput val = _perception->perceive_local_tiles(
         get_primary_entity()->get_coordinates().x,
         get_primary_entity()->get_coordinates().y,
         *_environment,
-        std::max(2, static_cast<int>(4 * get_primary_entity()->biology_get_genetic_value("Vision")))
+        std::max(2, static_cast<int>(4 * get_primary_entity()->biology_view().genes[GENE_VISION]))
     );
     return val.tile_values;
 }
 
 std::vector<double> Simulation::get_perception_expanded(const std::string& type) const
 {
+    PROFILE_SCOPE("tick/perception");
     std::vector<double> expanded_perception;
     std::vector<double> type_values = _perception->extract_tile_values_in_radius_of_type(
         get_primary_entity()->get_coordinates().x,
@@ -226,6 +265,7 @@ int Simulation::pass_perception_to_brain()
         std::cerr << "No primary entity found for perception to brain!" << std::endl;
         return -1; // Indicate an error
     }
+    const BiologyView biology = entity->biology_view();
     // Get the value of all tiles
     //std::vector<double> perception = get_perception();
     std::vector<double> filteredPerception;
@@ -252,102 +292,179 @@ int Simulation::pass_perception_to_brain()
         }
         std::vector<double> perception = get_perception_expanded(type_str);
         // Get the strength of the entities vision and determine how many tiles to ignore
-        float vision_value = entity->biology_get_genetic_value("Vision");
+        float vision_value = biology.genes[GENE_VISION];
         int tilesToIgnore = std::max(static_cast<int>(25.0 - (25 * vision_value)), 1); // at max vision (1.0), ignore 0 tiles, at min vision (0.0) ignore 24 tiles (only sees own tile) 
     
     // Add the filtered values to the master perception list
         std::vector<double> adaptedVision = filter_perception(perception, tilesToIgnore);
         filteredPerception.insert(filteredPerception.end(), adaptedVision.begin(), adaptedVision.end());  
     }
-    filteredPerception.push_back(entity->biology_get_metrics()["Energy"]);
-    filteredPerception.push_back(entity->biology_get_metrics()["Health"]);
-    filteredPerception.push_back(entity->biology_get_metrics()["Water"]);
+    filteredPerception.push_back(biology.metrics.energy);
+    filteredPerception.push_back(biology.metrics.health);
+    filteredPerception.push_back(biology.metrics.water);
     // Get the decision from the brain
     if (_debug){
-        std::cout << "Filtered Perception Length: " << filteredPerception.size() << " with "<< entity->biology_get_genetic_value("Vision")<<std::endl;
+        std::cout << "Filtered Perception Length: " << filteredPerception.size() << " with "<< biology.genes[GENE_VISION]<<std::endl;
+    }
+    PROFILE_SCOPE("tick/brain");
+    return decode_decision(entity->brain_get_outputs(filteredPerception));
+}
+
+int Simulation::decode_decision(const std::vector<double>& outputs)
+{
+    if (outputs.empty())
+    {
+        return -1;
+    }
+    if (outputs.size() == LEGACY_BRAIN_OUTPUTS)
+    {
+        static constexpr int LEGACY_ACTIONS[LEGACY_BRAIN_OUTPUTS] = {MOVE_UP, MOVE_DOWN, MOVE_LEFT, MOVE_RIGHT, STAY_STILL, CONSUME};
+        return LEGACY_ACTIONS[std::max_element(outputs.begin(), outputs.end()) - outputs.begin()];
     }
-    int decision = entity->brain_get_decision(filteredPerception);
-    return decision;
+    if (outputs.size() < static_cast<size_t>(BRAIN_OUTPUTS))
+    {
+        // Not one of our layouts: plain argmax, anything past the action head stays put
+        int index = std::max_element(outputs.begin(), outputs.end()) - outputs.begin();
+        return index < ACTION_COUNT ? index : STAY_STILL;
+    }
+    const auto actions = outputs.begin();
+    const auto speeds = actions + ACTION_COUNT;
+    int action = std::max_element(actions, speeds) - actions;
+    int speed = std::max_element(speeds, speeds + Movement::MAX_SPEED) - speeds + 1;
+    if (action == STAY_STILL || action == CONSUME)
+    {
+        speed = 1;
+    }
+    return action + ACTION_COUNT * (speed - 1);
 }
 
 void Simulation::interpret_decision(int decision_code)
 {
     auto entity = get_primary_entity();
     std::cout << "Entity's current position" << " (" << entity->x << ", " << entity->y << ")" << std::endl;
-    switch (static_cast<DecisionCodes>(decision_code))
-    {
-        case DecisionCodes::MOVE_UP:
-            std::cout << "Entity moves up." << std::endl;
-            Simulation::execute_movement(decision_code);
-            break;
-        case DecisionCodes::MOVE_DOWN:
-            std::cout << "Entity moves down." << std::endl;
-            Simulation::execute_movement(decision_code);
-            break;
-        case DecisionCodes::MOVE_LEFT:
-            std::cout << "Entity moves left." << std::endl;
-            Simulation::execute_movement(decision_code);    
-            break;
-        case DecisionCodes::MOVE_RIGHT:
-            std::cout << "Entity moves right." << std::endl;
-            Simulation::execute_movement(decision_code);
-            break;
-        case DecisionCodes::STAY_STILL:
-            std::cout << "Entity stays still." << std::endl;
-            // Logic for the entity staying still would go here (probably nothing)
-            break;
-        case DecisionCodes::CONSUME:
-            std::cout << "Entity consumes resources." << std::endl;
-            // Logic for consuming resources in current tile would go here
-            Simulation::consumption();
-            break;
-        default:
-            std::cerr << "Unknown decision code: " << decision_code << std::endl;
-    }
-}
-
-void Simulation::execute_movement(int direction){
-    // Placeholder for movement execution logic based on the direction decided by the brain
-    // This would involve updating the entity's coordinates and applying any relevant energy costs or terrain effects
-
-    // First create a movement struct
-    Movement::Action action = Movement::direction_to_action(static_cast<Movement::Direction>(direction), 0); // For now, keeping base energy at 0
-    auto entity = get_primary_entity();
-    int prev_x = entity->x;
-    int prev_y = entity->y;
-    // Fetch the new coordinates and update the entity's position
-    std::vector<int> new_coords = Movement::execute_movement_wraparound(entity->x, entity->y, action, _environment->getTileAmountX(), _environment->getTileAmountY(), entity->biology_get_metrics()["Energy"]);
-    if(new_coords[0]>=_environment->getTileAmountX() || new_coords[1] >= _environment->getTileAmountY() || new_coords[0] < 0 || new_coords[1] < 0){
-        std::cerr << "Error: Movement resulted in out of bounds coordinates (" << new_coords[0] << ", " << new_coords[1] << ")" << std::endl;
+    if (decision_code < 0 || decision_code >= ACTION_COUNT * Movement::MAX_SPEED)
+    {
+        std::cerr << "Unknown decision code: " << decision_code << std::endl;
         return;
     }
-    entity->set_coordinates(Vector2d(new_coords[0], new_coords[1]));
-    std::string terrain_type = _environment->getTileType(Vector2d(entity->x, entity->y));
-    std::cout << "Entity moved from (" << prev_x << ", " << prev_y << ") to (" << entity->x << ", " << entity->y << ") on type " << terrain_type << std::endl;
-    // Need to drain energy based on the terrain type of the new tile and the entity's biology
-    //entity->biology_movement(_environment->getTileType((entity->x, entity->y))); // Something like this in practice
-    entity->biology_movement(terrain_type); // Placeholder until we have actual terrain types implemented
-    
-    //check if there's a resource on the new tile and consume it if there is
-    ResourceNode* resource = _resource_manager->getResourceAtPosition(Position(entity->x, entity->y));
-    if (resource) {
-        double energyGained = resource->consume(entity->biology_get_genetic_value("Mass")); // Consume energy based on Mass ?
-        if (resource->getType() == ResourceType::FOOD) {
-            std::cout << "Entity consumed FOOD resource for" << energyGained << " raw energy." << std::endl;
-            entity->biology_eat(energyGained); // Add the consumed energy to the entity's biology
-        } else if (resource->getType() == ResourceType::WATER) {
-            std::cout << "Entity consumed WATER resource for " << energyGained << " raw water." << std::endl;
-            entity->biology_drink(energyGained); // Add the consumed energy to the entity's biology
+    const int action = decision_action(decision_code);
+    if (action == STAY_STILL)
+    {
+        std::cout << "Entity stays still." << std::endl;
+    }
+    else if (action == CONSUME)
+    {
+        std::cout << "Entity consumes resources." << std::endl;
+        Simulation::consumption();
+    }
+    else
+    {
+        std::cout << "Entity moves in direction " << action << " at speed " << decision_speed(decision_code) << "." << std::endl;
+        queue_move(0, action, decision_speed(decision_code));
+    }
+}
+
+const double* Simulation::terrain_rates(size_t slot)
+{
+    const size_t stride = 2 * Environment::TERRAIN_TYPES;
+    if (_terrain_rates.size() < (slot + 1) * stride)
+    {
+        _terrain_rates.resize((slot + 1) * stride, -1.0);
+    }
+    double* rates = &_terrain_rates[slot * stride];
+    if (rates[0] < 0.0)
+    {
+        // Costs are floored at 0.01, so a negative first entry means not built yet
+        const Biology* bio = _entities[slot]->get_biology().get();
+        for (int id = 0; id < Environment::TERRAIN_TYPES; ++id)
+        {
+            double energy = 0.0;
+            double water = 0.0;
+            try
+            {
+                energy = bio ? bio->movement_energy_cost(Environment::terrainName(id)) : 0.0;
+                water = bio ? bio->movement_water_cost(Environment::terrainName(id)) : 0.0;
+            }
+            catch (const std::exception&)
+            {
+                // Same as Entity::biology_movement: a missing gene means no drain
+            }
+            rates[id] = energy;
+            rates[Environment::TERRAIN_TYPES + id] = water;
         }
     }
+    return rates;
+}
 
-}   
+void Simulation::queue_move(size_t slot, int direction, int speed)
+{
+    if (_move_slots.empty())
+    {
+        _moves.clear(Environment::TERRAIN_TYPES);
+    }
+    Entity& entity = *_entities[slot];
+    const double energy = entity.get_biology() ? entity.get_biology()->get_energy() : 0.0;
+    const double* rates = terrain_rates(slot);
+    _moves.push(entity.x, entity.y, static_cast<Movement::Direction>(direction), speed, energy,
+                rates, rates + Environment::TERRAIN_TYPES);
+    _move_slots.push_back(slot);
+}
+
+void Simulation::resolve_moves()
+{
+    if (_move_slots.empty())
+    {
+        return;
+    }
+    const Movement::Grid grid = Movement::Grid::make(_environment->getTileAmountX(), _environment->getTileAmountY());
+    Movement::resolve_moves(_moves, grid, _environment->getTerrainIds(), 0); // For now, keeping base energy at 0
+
+    for (size_t i = 0; i < _move_slots.size(); ++i)
+    {
+        Entity* entity = _entities[_move_slots[i]].get();
+        std::cout << "Entity moved from (" << entity->x << ", " << entity->y << ") to (" << _moves.x[i] << ", " << _moves.y[i]
+                  << ") over " << static_cast<int>(_moves.steps[i]) << " tiles, draining " << _moves.energy_drain[i]
+                  << " energy and " << _moves.water_drain[i] << " water" << std::endl;
+        entity->set_coordinates(Vector2d(_moves.x[i], _moves.y[i]));
+        if (_moves.steps[i] > 0 && entity->get_biology())
+        {
+            entity->get_biology()->add_energy(-_moves.energy_drain[i]);
+            entity->get_biology()->add_water(-_moves.water_drain[i]);
+        }
+
+        //check if there's a resource on the tile the move ended on and consume it if there is
+        ResourceNode* resource = nullptr;
+        {
+            PROFILE_SCOPE("tick/resources");
+            resource = _resource_manager->getResourceAtPosition(Position(entity->x, entity->y));
+        }
+        if (resource) {
+            _state_hash -= resource_term(*resource);
+            double energyGained = resource->consume(entity->biology_view().genes[GENE_MASS]); // Consume energy based on Mass ?
+            _state_hash += resource_term(*resource);
+            if (resource->getType() == ResourceType::FOOD) {
+                std::cout << "Entity consumed FOOD resource for" << energyGained << " raw energy." << std::endl;
+                entity->biology_eat(energyGained); // Add the consumed energy to the entity's biology
+            } else if (resource->getType() == ResourceType::WATER) {
+                std::cout << "Entity consumed WATER resource for " << energyGained << " raw water." << std::endl;
+                entity->biology_drink(energyGained); // Add the consumed energy to the entity's biology
+            }
+        }
+    }
+    _move_slots.clear();
+}
 
 void Simulation::consumption(){
     Entity* entity = get_primary_entity();
-    ResourceNode* resource = _resource_manager->getResourceAtPosition(Position(entity->x, entity->y));
+    ResourceNode* resource = nullptr;
+    {
+        PROFILE_SCOPE("tick/resources");
+        resource = _resource_manager->getResourceAtPosition(Position(entity->x, entity->y));
+    }
     if (resource) {
-        double energyGained = resource->consume(entity->biology_get_genetic_value("Mass")); // Consume energy based on Mass ?
+        _state_hash -= resource_term(*resource);
+        double energyGained = resource->consume(entity->biology_view().genes[GENE_MASS]); // Consume energy based on Mass ?
+        _state_hash += resource_term(*resource);
         if (resource->getType() == ResourceType::FOOD) {
             std::cout << "Entity consumed FOOD resource for" << energyGained << " raw energy." << std::endl;
             entity->biology_eat(energyGained); // Add the consumed energy to the entity's biology
@@ -362,6 +479,7 @@ void Simulation::consumption(){
 }
 
 int Simulation::tick(int print){
+    PROFILE_SCOPE("tick");
     // Get the perception for the primary entity and pass it to the brain to get a decision
     _debug = print;
     if (!print){
@@ -370,14 +488,26 @@ int Simulation::tick(int print){
     }
     std::vector<double> perception = get_perception();
     int decision = pass_perception_to_brain();
-    interpret_decision(decision);
-    get_primary_entity()->update_biology(); // Handle biology updates like energy drain, health regen, etc.
-    get_primary_entity()->biology_get_metrics(true);
+    _last_decision = decision;
+    {
+        PROFILE_SCOPE("tick/movement");
+        interpret_decision(decision);
+        resolve_moves();
+    }
+    bool entity_dead = false;
+    {
+        PROFILE_SCOPE("tick/biology");
+        _biology_store.tick(); // Clamping, energy and health drain and death checks for every entity in one pass
+        get_primary_entity()->increment_age();
+        get_primary_entity()->get_biology()->print_vals();
+        entity_dead = _biology_store.dead(0);
+    }
+    refresh_entity_terms();
     cout << _environment->getTileAmountX() << "x" << _environment->getTileAmountY() << endl;
     if (print){
+        PROFILE_SCOPE("tick/display");
         display_environment();
     }
-    bool entity_dead = get_primary_entity()->biology_check_death();
     if (entity_dead) {
         //repoint cout before printing death message
         if (!print){
@@ -394,13 +524,153 @@ int Simulation::tick(int print){
     return 0; // Return 0 to indicate the tick completed successfully
 }
 
+namespace
+{
+    /**
+     * @brief splitmix64 finalizer
+     */
+    inline uint64_t mix64(uint64_t z)
+    {
+        z += 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    inline uint64_t double_bits(double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    inline uint64_t pack_position(int32_t x, int32_t y)
+    {
+        return static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32 | static_cast<uint32_t>(y);
+    }
+
+    // The state hash is the wrapping sum of one term per tile, entity slot and resource, so
+    // any one of them can be swapped out (subtract the old term, add the new) in O(1)
+    enum HashDomain : uint64_t { HASH_TILE = 1, HASH_ENTITY = 2, HASH_RESOURCE = 3 };
+
+    inline uint64_t hash_term(HashDomain domain, uint64_t key, uint64_t value)
+    {
+        return mix64(mix64(static_cast<uint64_t>(domain) << 56 ^ key) ^ value);
+    }
+}
+
+uint64_t Simulation::tile_term(int x, int y) const
+{
+    return hash_term(HASH_TILE, pack_position(x, y), double_bits(_environment->getTileValue(Vector2d(x, y), 0)));
+}
+
+uint64_t Simulation::entity_term(size_t slot) const
+{
+    const Entity& entity = *_entities[slot];
+    uint64_t value = mix64(pack_position(entity.x, entity.y));
+    value = mix64(value ^ static_cast<uint64_t>(entity.get_age()));
+    if (const Biology* bio = entity.get_biology().get())
+    {
+        value = mix64(value ^ double_bits(bio->get_energy()));
+        value = mix64(value ^ double_bits(bio->get_health()));
+        value = mix64(value ^ double_bits(bio->get_water()));
+    }
+    return hash_term(HASH_ENTITY, slot, value);
+}
+
+uint64_t Simulation::resource_term(const ResourceNode& resource) const
+{
+    Position pos = resource.getPosition();
+    return hash_term(HASH_RESOURCE, pack_position(pos.x, pos.y), double_bits(resource.getEnergyValue()));
+}
+
+void Simulation::rebind_biology()
+{
+    _biology_store.clear();
+    for (const auto& entity : _entities)
+    {
+        _biology_store.bind(entity->get_biology().get());
+    }
+}
+
+void Simulation::refresh_entity_terms()
+{
+    // Entity state changes all over Biology, so each slot's term is cached and swapped once per
+    // call; changes made between calls (or through get_primary_entity()) are picked up here too
+    for (size_t slot = _entities.size(); slot < _entity_terms.size(); ++slot)
+    {
+        _state_hash -= _entity_terms[slot];
+    }
+    _entity_terms.resize(_entities.size(), 0);
+    for (size_t slot = 0; slot < _entities.size(); ++slot)
+    {
+        const uint64_t term = entity_term(slot);
+        _state_hash += term - _entity_terms[slot];
+        _entity_terms[slot] = term;
+    }
+}
+
+uint64_t Simulation::recompute_state_hash() const
+{
+    uint64_t hash = 0;
+    if (_environment)
+    {
+        for (int x = 0; x < _environment->getTileAmountX(); x++)
+        {
+            for (int y = 0; y < _environment->getTileAmountY(); y++)
+            {
+                hash += tile_term(x, y);
+            }
+        }
+    }
+    for (size_t slot = 0; slot < _entities.size(); ++slot)
+    {
+        hash += entity_term(slot);
+    }
+    if (_resource_manager)
+    {
+        for (const auto& resource : _resource_manager->getResources())
+        {
+            hash += resource_term(*resource);
+        }
+    }
+    return hash;
+}
+
 size_t Simulation::get_entity_count() const
 {
     return _entities.size();
 }
 
+PopulationStats Simulation::compute_population_stats() const
+{
+    // Vitals are summarized in place from the biology store's columns (row i is entity slot i);
+    // only age, the fitness proxy, lives on the entity and is gathered here
+    const size_t n = _biology_store.size();
+    _stats_ages.resize(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        _stats_ages[i] = static_cast<double>(_entities[i]->get_age());
+    }
+
+    PopulationColumns columns;
+    columns.energy = _biology_store.energy_column();
+    columns.health = _biology_store.health_column();
+    columns.water = _biology_store.water_column();
+    columns.fitness = _stats_ages.data();
+    columns.count = n;
+    PopulationStats stats = summarize_population(columns);
+    if (_resource_manager)
+    {
+        stats.resource_count = static_cast<uint32_t>(_resource_manager->getResourceCount());
+        stats.resource_energy = _resource_manager->getTotalEnergy();
+    }
+    return stats;
+}
+
 std::vector<double> Simulation::filter_perception(std::vector<double> perception, int tilesToIgnore) const
 {
+    PROFILE_SCOPE("tick/filter");
     if (perception.empty() || tilesToIgnore <= 0)
     {
         return perception;
@@ -502,6 +772,7 @@ void Simulation::biologySetCoordinates(Vector2d coords)
     if (entity)
     {
         entity->set_coordinates(coords);
+        refresh_entity_terms();
         std::cout << "Entity location set to (" << coords.x << ", " << coords.y << ")" << std::endl;
     }
     else
@@ -523,88 +794,76 @@ Vector2d Simulation::biologyGetCoordinates() const
     }
 }
 
-void Simulation::display_environment() const
+namespace
 {
-    if (!_environment)
+    inline uint8_t color_channel(double value)
     {
-        std::cerr << "Environment not initialized!" << std::endl;
-        return;
+        return static_cast<uint8_t>(std::clamp(static_cast<int>(value * 255), 0, 255));
     }
+}
 
-    Vector2d entity_pos = get_primary_entity() ? get_primary_entity()->get_coordinates() : Vector2d(-1, -1);
+void Simulation::render_frame(FrameRenderer& renderer) const
+{
+    const int width = _environment->getTileAmountX();
+    const int height = _environment->getTileAmountY();
+    if (renderer.width() != width || renderer.height() != height)
+    {
+        renderer.resize(width, height);
+    }
 
-    constexpr const char* kSolidBlock = u8"\u2588\u2588";
-    constexpr const char* kLightShade = u8"\u2591\u2591";
+    // Terrain: blue-green (low) to red (high)
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            double normalized = (_environment->getTileValue(Vector2d(x, y), 0) + 2.0) / 4.0; // 0.0 to 1.0
+            uint8_t fade = color_channel(1 - normalized);
+            renderer.set(x, y, FrameCell{color_channel(normalized), fade, fade, FrameCell::SHADE});
+        }
+    }
 
-    std::cout << "\n=== Environment Display ===\n" << std::endl;
-    // Normal 2d traversal of the environment grid
-    for (int y = 0; y < _environment->getTileAmountY(); ++y)
+    // Resources in one pass over the list instead of two scans per tile: yellow for food,
+    // blue for water, brighter with more energy. Reverse order so the first resource on a
+    // tile wins, like getResourceAtPosition
+    const auto& resources = _resource_manager->getResources();
+    for (auto it = resources.rbegin(); it != resources.rend(); ++it)
     {
-        for (int x = 0; x < _environment->getTileAmountX(); ++x)
+        const ResourceNode& resource = **it;
+        Position pos = resource.getPosition();
+        if (resource.isDepleted() || pos.x < 0 || pos.y < 0 || pos.x >= width || pos.y >= height)
         {
-            double tile_value = _environment->getTileValue(Vector2d(x, y), 0);
-            // Check if an entity is at this location, probably a better way down the line
-            if (entity_pos.x == x && entity_pos.y == y)
-            {
-                double curr_health = get_primary_entity()->biology_get_metrics()["Health"];
-                int r, g, b;
-                r = 255;
-                g = (int)((curr_health) * 255);
-                b = (int)((curr_health) * 255);
-                std::cout << "\033[38;2;" << r << ";" << g << ";" << b << "m"
-                          << kSolidBlock
-                          << "\033[0m"; // Reset color
-            }
-            else if(!_resource_manager->findResourcesInRange(Position(x, y), 0).empty()) // Check if there's a resource at this location
-            {
-                // Display resource as Blue blocks if water, yellow for energy, with intensity based on the energy value of the resource
-                double energy_value = _resource_manager->getResourceAtPosition(Position(x, y))->getEnergyValue();
-                int intensity = static_cast<int>(energy_value * 255);
-                if (_resource_manager->getResourceAtPosition(Position(x, y))->getType() == ResourceType::FOOD) {
-                    // Yellow color for food
-                    std::cout << "\033[38;2;" << intensity << ";" << intensity << ";0m"  // Yellow color with intensity
-                              << kSolidBlock
-                              << "\033[0m"; // Reset color
-                }
-                else {
-                    // Blue color for water 
-                    std::cout << "\033[38;2;0;0;" << intensity << "m"  // Blue color with intensity
-                          << kSolidBlock
-                          << "\033[0m"; // Reset color
-
-                }
-            }
-            else
-            {
-                // Some hacky color coding adopted from another project.
-                int r, g, b;
-
-                double normalized = (tile_value + 2.0) / 4.0; // 0.0 to 1.0
-                r = (int)(normalized * 255);
-                g = (int)((1 - normalized) * 255);
-                b = (int)((1 - normalized) * 255);
-
-                //normalized = tile_value;
-
-                bool aesthetic = true;
-                if(aesthetic){
-                    std::cout << "\033[38;2;" << r << ";" << g << ";" << b << "m"
-                            << kLightShade
-                            << "\033[0m";
-                } else {
-                    // Alternative print method, prints the value instead of 0
-                    char buffer[20];
-                    std::sprintf(buffer,"%.1f", tile_value); 
-                    std::cout << "\033[38;2;" << r << ";" << g << ";" << b << "m"
-                            << buffer
-                            << " "
-                            << "\033[0m"; 
-                    
-               }
-            }
+            continue;
+        }
+        uint8_t intensity = color_channel(resource.getEnergyValue());
+        renderer.set(pos.x, pos.y, resource.getType() == ResourceType::FOOD
+            ? FrameCell{intensity, intensity, 0, FrameCell::SOLID}
+            : FrameCell{0, 0, intensity, FrameCell::SOLID});
+    }
+
+    // Entities on top, white fading to red as health drops
+    for (const auto& entity : _entities)
+    {
+        if (entity->x < 0 || entity->y < 0 || entity->x >= width || entity->y >= height || !entity->get_biology())
+        {
+            continue;
         }
-        std::cout << std::endl;
+        uint8_t health = color_channel(entity->get_biology()->get_health());
+        renderer.set(entity->x, entity->y, FrameCell{255, health, health, FrameCell::SOLID});
     }
+}
+
+void Simulation::display_environment() const
+{
+    if (!_environment)
+    {
+        std::cerr << "Environment not initialized!" << std::endl;
+        return;
+    }
+
+    render_frame(_frame);
+    const std::string& frame = _frame.compose_full();
+    std::cout << "\n=== Environment Display ===\n\n";
+    std::cout.write(frame.data(), static_cast<std::streamsize>(frame.size()));
     std::cout << "\n=== End Environment Display ===\n" << std::endl;
 }
 
@@ -613,7 +872,7 @@ float Simulation::get_vision_value() const
     auto entity = get_primary_entity();
     if (entity)
     {
-        return entity->biology_get_genetic_value("Vision");
+        return entity->biology_view().genes[GENE_VISION];
     }
     else
     {
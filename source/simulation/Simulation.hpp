@@ -1,15 +1,21 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include "../environment/Environment.h"
 #include "../entity/decision_center/entity.hpp"
+#include "../entity/decision_center/biology_store.hpp"
 #include "../entity/perception_movement/perception.hpp"
+#include "../entity/perception_movement/movement.hpp"
+#include "population_stats.h"
+#include "frame_renderer.h"
 
 // Forward declarations
 class Brain;
 class Biology;
 class ResourceManager;
+class ResourceNode;
 
 /**
  * @class Simulation
@@ -20,9 +26,37 @@ class Simulation
 private:
     std::unique_ptr<Environment> _environment;
     std::vector<std::unique_ptr<Entity>> _entities;
+    BiologyStore _biology_store;               // Row i holds the vitals of _entities[i]
     std::unique_ptr<Perception> _perception;
     std::unique_ptr<ResourceManager> _resource_manager;
     int _debug;
+    int _last_decision = -1;
+    uint64_t _state_hash = 0;                  // Wrapping sum of every tile, entity and resource term
+    std::vector<uint64_t> _entity_terms;       // Each entity slot's term as last added to _state_hash
+
+    uint64_t tile_term(int x, int y) const;
+    uint64_t entity_term(size_t slot) const;
+    uint64_t resource_term(const ResourceNode& resource) const;
+
+    /**
+     * @brief Swaps every entity slot's cached term for its current one
+     */
+    void refresh_entity_terms();
+
+    /**
+     * @brief Rebuilds the biology store so row i is bound to entity slot i
+     */
+    void rebind_biology();
+
+    Movement::MoveBatch _moves;                // This tick's moves, resolved together by resolve_moves
+    std::vector<size_t> _move_slots;           // Entity slot of each queued move
+    // Per entity slot, drain per terrain id: energy for all types, then water for all types.
+    // Built from the entity's genes the first time it moves, cleared when entities are replaced.
+    std::vector<double> _terrain_rates;
+
+    const double* terrain_rates(size_t slot);
+    mutable std::vector<double> _stats_ages;   // Age per entity slot, reused every tick so the stats pass never allocates
+    mutable FrameRenderer _frame;               // Reused by display_environment so a frame never reallocates
 
 public:
     /**
@@ -42,7 +76,30 @@ public:
 
     void seed_resources();
 
-    enum DecisionCodes {MOVE_UP=0, MOVE_DOWN=1, MOVE_LEFT=2, MOVE_RIGHT=3, STAY_STILL=4, CONSUME=5};
+    /**
+     * Decision codes pack an action (a Movement::Direction, or CONSUME) and, for moves, a speed
+     * in tiles: code = action + ACTION_COUNT * (speed - 1)
+     */
+    enum DecisionCodes {MOVE_UP=Movement::NORTH, MOVE_DOWN=Movement::SOUTH, MOVE_LEFT=Movement::WEST, MOVE_RIGHT=Movement::EAST,
+                        MOVE_NORTHEAST=Movement::NORTHEAST, MOVE_NORTHWEST=Movement::NORTHWEST,
+                        MOVE_SOUTHEAST=Movement::SOUTHEAST, MOVE_SOUTHWEST=Movement::SOUTHWEST,
+                        STAY_STILL=Movement::STAY, CONSUME=Movement::STAY + 1};
+    static constexpr int ACTION_COUNT = CONSUME + 1;
+    // Brain outputs are two heads read separately: one logit per action, then one per speed.
+    // The output layer grows by the sum of the heads rather than their product.
+    static constexpr int BRAIN_OUTPUTS = ACTION_COUNT + Movement::MAX_SPEED;
+    static constexpr int LEGACY_BRAIN_OUTPUTS = 6;      // Up, down, left, right, stay, consume
+    static constexpr int decision_action(int code) { return code % ACTION_COUNT; }
+    static constexpr int decision_speed(int code) { return code / ACTION_COUNT + 1; }
+
+    /**
+     * @brief Turns brain outputs into a decision code
+     * BRAIN_OUTPUTS-wide brains are read as an action head and a speed head; 6-output brains
+     * (older checkpoints) as the original four moves, stay and consume at speed 1
+     * @return The decision code, or -1 for an empty output
+     */
+    static int decode_decision(const std::vector<double>& outputs);
+
     /**
      * @brief Returns the value of the tile located at (x,y)
      * @return the float value.
@@ -62,6 +119,18 @@ public:
     int pass_perception_to_brain();
 
     Entity* reproduce(Entity* parent1, Entity* parent2);
+
+    /**
+     * @brief Breeds two parents into an existing entity instead of allocating a new one
+     *
+     * Genetics are picked per gene from either parent then mutated; the brain comes from one
+     * parent with mutated weights. When the child already has a brain with the same layer
+     * count, the weights are written into its existing storage. The child gets a new ID.
+     * @param parent1 First parent
+     * @param parent2 Second parent
+     * @param child Slot to overwrite, must not be either parent
+     */
+    void breed_into(const Entity& parent1, const Entity& parent2, Entity& child) const;
     
     /**
      * @brief Returns the first entity (primary entity). Initial sims will only have 1, but I want to have this in place for when we expand.
@@ -73,17 +142,57 @@ public:
 
     void interpret_decision(int decision_code);
 
-    void execute_movement(int direction);
+    /**
+     * @brief Queues a move for an entity slot; it happens in the next resolve_moves()
+     * @param direction A Movement::Direction
+     * @param speed Tiles to move, clamped to 1..Movement::MAX_SPEED
+     */
+    void queue_move(size_t slot, int direction, int speed = 1);
+
+    /**
+     * @brief Movement stage: walks every queued path in one batch, charges terrain drain for
+     * each tile entered, then lets each mover take the resource it lands on
+     */
+    void resolve_moves();
     void consumption();
 
     int tick(int print =1);
 
+    /**
+     * @brief Decision code the primary entity acted on in the last tick, -1 before the first
+     */
+    int get_last_decision() const { return _last_decision; }
+
+    /**
+     * @brief 64-bit hash of the world: tile values, entity positions, ages and vitals, and
+     * every resource's position and energy
+     *
+     * Kept up to date as the world changes (one term per tile, entity and resource, swapped
+     * when that thing mutates), so reading it costs nothing. Equal hashes after the same tick
+     * mean two runs are (almost certainly) in the same state; doubles are hashed by bit
+     * pattern, so any numeric drift shows up. Entity changes made from outside are folded in
+     * at the end of the next tick.
+     */
+    uint64_t state_hash() const { return _state_hash; }
+
+    /**
+     * @brief The same hash rebuilt from scratch, to check the incremental one
+     */
+    uint64_t recompute_state_hash() const;
+
     /**
      * @brief Returns number of entities in the simulation. Surpisingly helpful in diagnosing bugs.
      * @return The count of entities
      */
     size_t get_entity_count() const;
 
+    /**
+     * @brief Gathers every entity's energy, health, water and fitness (age) into SoA columns
+     * and summarizes them in one pass, plus resource count and total resource energy
+     * @return Population and resource stats for this tick
+     */
+    PopulationStats compute_population_stats() const;
+
     /**
      * @brief Tests whether the sim can actually access its members
      * Does not currently test for accuracy, just that communication between modules is possible
@@ -105,11 +214,18 @@ public:
 
     /**
      * @brief Displays the environment to the CLI with color-coded tiles
-     * Tiles are colored blue (low values) to red (high values)
-     * Entities are displayed as white "X"s
+     * Tiles are colored blue (low values) to red (high values), resources yellow (food) or
+     * blue (water), and entities white fading to red with health. The frame is built in one
+     * buffer and written with a single call.
      */
     void display_environment() const;
 
+    /**
+     * @brief Draws the same view as display_environment into a renderer's back buffer,
+     * resizing it to the world first if needed
+     */
+    void render_frame(FrameRenderer& renderer) const;
+
     /**
      * @brief Gets the vision value of the primary entity, which may be used to filter perception in the future
      * @return The vision value as a float
@@ -8,6 +8,10 @@
 #include <vector>
 #include <memory>
 #include <stdexcept>
+#include <atomic>
+#include <cstdint>
+#include <array>
+#include <algorithm>
 
 using namespace std;
 
@@ -125,3 +129,233 @@ size_t CircularBuffer<T>::toPhysicalIndex(size_t logicalIndex) const {
     // If full, need to offset by head position and wrap
     return m_size < m_capacity ? logicalIndex : (m_head + logicalIndex) % m_capacity;
 }
+
+/**
+ * SpscCircularBuffer - Lock-free single-producer / single-consumer ring
+ * Lets the tick loop publish snapshots that an autosave / metrics / render thread drains.
+ * Capacity is rounded up to a power of two so indexing is a mask, not a modulo.
+ * push() never blocks: when the consumer falls behind, the new item is dropped and counted
+ * (the ring can't overwrite the oldest slot without racing the reader).
+ * Exactly one thread may push and one other thread may pop/drain.
+ */
+template<typename T>
+class SpscCircularBuffer {
+public:
+    explicit SpscCircularBuffer(size_t capacity);
+
+    bool push(const T& item);           // Producer only, false if full (item dropped)
+    bool push(T&& item);
+
+    bool pop(T& out);                   // Consumer only, false if empty
+    size_t drainTo(CircularBuffer<T>& dest, size_t maxItems = SIZE_MAX);  // Consumer only
+
+    size_t size() const;                // Snapshot — may be stale by the time it returns
+    size_t capacity() const { return m_mask + 1; }
+    bool empty() const { return size() == 0; }
+    bool full() const { return size() == capacity(); }
+    uint64_t dropped() const { return m_dropped.load(memory_order_relaxed); }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    template<typename U> bool emplace(U&& item);
+
+    unique_ptr<T[]> m_slots;
+    size_t m_mask;
+
+    // Head/tail are free-running counters; each side keeps a cached copy of the other's
+    // so the shared line is only re-read when the ring looks full (or empty)
+    alignas(kCacheLine) atomic<size_t> m_head{0};     // Next write, owned by the producer
+    size_t                             m_cachedTail = 0;
+    atomic<uint64_t>                   m_dropped{0};
+    alignas(kCacheLine) atomic<size_t> m_tail{0};     // Next read, owned by the consumer
+    size_t                             m_cachedHead = 0;
+    char m_pad[kCacheLine - sizeof(atomic<size_t>) - sizeof(size_t)];
+};
+
+template<typename T>
+SpscCircularBuffer<T>::SpscCircularBuffer(size_t capacity) {
+    if (capacity == 0) {
+        throw invalid_argument("SpscCircularBuffer capacity must be > 0");
+    }
+    size_t rounded = 1;
+    while (rounded < capacity) rounded <<= 1;
+    m_slots.reset(new T[rounded]);
+    m_mask = rounded - 1;
+}
+
+template<typename T>
+template<typename U>
+bool SpscCircularBuffer<T>::emplace(U&& item) {
+    const size_t head = m_head.load(memory_order_relaxed);
+    if (head - m_cachedTail > m_mask) {
+        m_cachedTail = m_tail.load(memory_order_acquire);
+        if (head - m_cachedTail > m_mask) {
+            m_dropped.fetch_add(1, memory_order_relaxed);
+            return false;
+        }
+    }
+    m_slots[head & m_mask] = std::forward<U>(item);
+    m_head.store(head + 1, memory_order_release);    // Publishes the slot to the consumer
+    return true;
+}
+
+template<typename T>
+bool SpscCircularBuffer<T>::push(const T& item) {
+    return emplace(item);
+}
+
+template<typename T>
+bool SpscCircularBuffer<T>::push(T&& item) {
+    return emplace(std::move(item));
+}
+
+template<typename T>
+bool SpscCircularBuffer<T>::pop(T& out) {
+    const size_t tail = m_tail.load(memory_order_relaxed);
+    if (tail == m_cachedHead) {
+        m_cachedHead = m_head.load(memory_order_acquire);
+        if (tail == m_cachedHead) return false;
+    }
+    out = std::move(m_slots[tail & m_mask]);
+    m_tail.store(tail + 1, memory_order_release);    // Hands the slot back to the producer
+    return true;
+}
+
+template<typename T>
+size_t SpscCircularBuffer<T>::drainTo(CircularBuffer<T>& dest, size_t maxItems) {
+    size_t tail = m_tail.load(memory_order_relaxed);
+    m_cachedHead = m_head.load(memory_order_acquire);
+    size_t n = m_cachedHead - tail;
+    if (n > maxItems) n = maxItems;
+
+    for (size_t i = 0; i < n; ++i) {
+        dest.push(std::move(m_slots[(tail + i) & m_mask]));
+    }
+    m_tail.store(tail + n, memory_order_release);    // One release for the whole batch
+    return n;
+}
+
+template<typename T>
+size_t SpscCircularBuffer<T>::size() const {
+    const size_t tail = m_tail.load(memory_order_acquire);
+    const size_t head = m_head.load(memory_order_acquire);
+    return head - tail > m_mask ? m_mask + 1 : head - tail;    // Producer may run ahead between loads
+}
+
+/**
+ * StaticCircularBuffer - CircularBuffer with the capacity fixed at compile time
+ * Storage is an inline std::array (no heap), N is a power of two so wrap-around is a mask,
+ * and operator[] skips the bounds check. Meant for the many small per-entity rings
+ * (recent decisions, energy trend) where CircularBuffer's vector + modulo add up.
+ * push_n / copy_out move whole runs as at most two contiguous copies.
+ */
+template<typename T, size_t N>
+class StaticCircularBuffer {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "StaticCircularBuffer capacity must be a power of two");
+    static constexpr size_t kMask = N - 1;
+
+public:
+    void push(const T& item);           // Add element (overwrites oldest if full)
+    void push(T&& item);
+    void push_n(const T* items, size_t count);   // Oldest first; only the last N survive
+
+    const T& operator[](size_t index) const { return m_buffer[physical(index)]; }  // Unchecked
+    T& operator[](size_t index) { return m_buffer[physical(index)]; }
+    const T& get(size_t index) const;   // Checked, same contract as CircularBuffer
+    T& get(size_t index);
+    const T& latest() const;
+    T& latest();
+    const T& rewind(size_t ticksAgo) const;
+
+    size_t copy_out(T* dest) const;     // Oldest to newest into dest[0..size), returns size
+
+    size_t size() const { return m_size; }
+    static constexpr size_t capacity() { return N; }
+    bool empty() const { return m_size == 0; }
+    bool full() const { return m_size == N; }
+    void clear() { m_head = 0; m_size = 0; }
+
+private:
+    array<T, N> m_buffer{};
+    size_t m_head = 0;                  // Next write position, always < N
+    size_t m_size = 0;
+
+    size_t physical(size_t logicalIndex) const { return (m_head - m_size + logicalIndex) & kMask; }
+};
+
+template<typename T, size_t N>
+void StaticCircularBuffer<T, N>::push(const T& item) {
+    m_buffer[m_head] = item;
+    m_head = (m_head + 1) & kMask;
+    m_size += (m_size < N);
+}
+
+template<typename T, size_t N>
+void StaticCircularBuffer<T, N>::push(T&& item) {
+    m_buffer[m_head] = std::move(item);
+    m_head = (m_head + 1) & kMask;
+    m_size += (m_size < N);
+}
+
+template<typename T, size_t N>
+void StaticCircularBuffer<T, N>::push_n(const T* items, size_t count) {
+    if (count > N) {                    // Anything older than the last N would be overwritten anyway
+        items += count - N;
+        count  = N;
+    }
+    size_t first = min(count, N - m_head);
+    copy(items, items + first, m_buffer.begin() + m_head);
+    copy(items + first, items + count, m_buffer.begin());
+    m_head = (m_head + count) & kMask;
+    m_size = min(m_size + count, N);
+}
+
+template<typename T, size_t N>
+const T& StaticCircularBuffer<T, N>::get(size_t index) const {
+    if (index >= m_size) {
+        throw out_of_range("StaticCircularBuffer index out of range");
+    }
+    return (*this)[index];
+}
+
+template<typename T, size_t N>
+T& StaticCircularBuffer<T, N>::get(size_t index) {
+    if (index >= m_size) {
+        throw out_of_range("StaticCircularBuffer index out of range");
+    }
+    return (*this)[index];
+}
+
+template<typename T, size_t N>
+const T& StaticCircularBuffer<T, N>::latest() const {
+    if (empty()) {
+        throw runtime_error("StaticCircularBuffer is empty");
+    }
+    return m_buffer[(m_head - 1) & kMask];
+}
+
+template<typename T, size_t N>
+T& StaticCircularBuffer<T, N>::latest() {
+    if (empty()) {
+        throw runtime_error("StaticCircularBuffer is empty");
+    }
+    return m_buffer[(m_head - 1) & kMask];
+}
+
+template<typename T, size_t N>
+const T& StaticCircularBuffer<T, N>::rewind(size_t ticksAgo) const {
+    if (ticksAgo >= m_size) {
+        throw out_of_range("Cannot rewind beyond buffer history");
+    }
+    return m_buffer[(m_head - 1 - ticksAgo) & kMask];
+}
+
+template<typename T, size_t N>
+size_t StaticCircularBuffer<T, N>::copy_out(T* dest) const {
+    size_t start = (m_head - m_size) & kMask;
+    size_t first = min(m_size, N - start);
+    copy(m_buffer.begin() + start, m_buffer.begin() + start + first, dest);
+    copy(m_buffer.begin(), m_buffer.begin() + (m_size - first), dest + first);
+    return m_size;
+}
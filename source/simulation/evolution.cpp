@@ -0,0 +1,583 @@
+#include "evolution.h"
+#include "../entity/decision_center/biology.hpp"
+#include "../entity/decision_center/brain.hpp"
+#include "../entity/decision_center/rng.hpp"
+#include "../entity/entity_cpp/fitness_calculator.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+    // Checkpoint layout: magic, version, generation, population size, RNG state, next entity
+    // ID (version 2 on), then each entity as written by write_entity. Migration payloads reuse
+    // write_entity. Native byte order; checkpoints resume on the machine type that wrote them.
+    const char CHECKPOINT_MAGIC[8] = {'A', 'L', 'E', 'V', 'C', 'K', 'P', 'T'};
+    const uint32_t CHECKPOINT_VERSION = 2;
+
+    template <typename T>
+    void write_value(std::ostream& out, const T& value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T read_value(std::istream& in)
+    {
+        T value{};
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(T)))
+        {
+            throw std::runtime_error("Entity data is truncated");
+        }
+        return value;
+    }
+
+    void write_bytes(std::ostream& out, const void* data, size_t size)
+    {
+        write_value(out, static_cast<uint32_t>(size));
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+
+    std::string read_bytes(std::istream& in)
+    {
+        uint32_t size = read_value<uint32_t>(in);
+        std::string bytes(size, '\0');
+        if (size > 0 && !in.read(&bytes[0], size))
+        {
+            throw std::runtime_error("Entity data is truncated");
+        }
+        return bytes;
+    }
+
+    // Identity, layer shape, Brain::serialize_genome() bytes, genetics
+    void write_entity(std::ostream& out, const Entity& entity)
+    {
+        write_value(out, static_cast<int64_t>(entity.get_id()));
+        write_value(out, static_cast<int64_t>(entity.get_parent_id()));
+        write_value(out, static_cast<int32_t>(entity.get_generation()));
+
+        // Shape as {inputs, outputs of each layer}, enough to rebuild the Brain
+        std::vector<ActivationLayerReLU>& layers = entity.get_brain()->get_layers();
+        write_value(out, static_cast<uint32_t>(layers.size()));
+        for (const auto& layer : layers)
+        {
+            int32_t n_out = layer.get_biases_count();
+            int32_t n_in = n_out > 0 ? layer.get_weight_count() / n_out : 0;
+            write_value(out, n_in);
+            write_value(out, n_out);
+        }
+        std::vector<uint8_t> genome = entity.get_brain()->serialize_genome();
+        write_bytes(out, genome.data(), genome.size());
+
+        const auto genetics = entity.get_biology()->get_genetic_vals();
+        write_value(out, static_cast<uint32_t>(genetics.size()));
+        for (const auto& gene : genetics)
+        {
+            write_bytes(out, gene.first.data(), gene.first.size());
+            write_value(out, gene.second);
+        }
+    }
+
+    // Inverse of write_entity. Building the Brain draws from the RNG.
+    std::unique_ptr<Entity> read_entity(std::istream& in)
+    {
+        auto entity = std::make_unique<Entity>();
+        const long long id = read_value<int64_t>(in);
+        const long long parent_id = read_value<int64_t>(in);
+        const int lineage_generation = read_value<int32_t>(in);
+        entity->restore_id(id);
+        entity->set_lineage(parent_id, lineage_generation);
+
+        const uint32_t layer_count = read_value<uint32_t>(in);
+        std::vector<int> layer_sizes;
+        for (uint32_t l = 0; l < layer_count; ++l)
+        {
+            int32_t n_in = read_value<int32_t>(in);
+            int32_t n_out = read_value<int32_t>(in);
+            if (l == 0)
+            {
+                layer_sizes.push_back(n_in);
+            }
+            layer_sizes.push_back(n_out);
+        }
+        auto brain = std::make_shared<Brain>(layer_sizes);
+        const std::string genome = read_bytes(in);
+        if (!brain->deserialize_genome(std::vector<uint8_t>(genome.begin(), genome.end())))
+        {
+            throw std::runtime_error("Genome doesn't match its layer sizes");
+        }
+        entity->set_brain(brain);
+
+        std::unordered_map<std::string, double> genetics;
+        const uint32_t gene_count = read_value<uint32_t>(in);
+        for (uint32_t k = 0; k < gene_count; ++k)
+        {
+            std::string name = read_bytes(in);
+            genetics[name] = read_value<double>(in);
+        }
+        auto biology = std::make_shared<Biology>(true);     // Defaults, no RNG draws
+        biology->set_genetic_vals(genetics);
+        entity->set_biology(biology);
+        return entity;
+    }
+}
+
+SelectionMethod parse_selection_method(const std::string& name)
+{
+    if (name == "truncation") return SelectionMethod::TRUNCATION;
+    if (name == "tournament") return SelectionMethod::TOURNAMENT;
+    if (name == "rank") return SelectionMethod::RANK;
+    throw std::invalid_argument("Unknown selection method: " + name);
+}
+
+const char* selection_method_name(SelectionMethod method)
+{
+    switch (method)
+    {
+        case SelectionMethod::TRUNCATION: return "truncation";
+        case SelectionMethod::TOURNAMENT: return "tournament";
+        case SelectionMethod::RANK: return "rank";
+    }
+    return "unknown";
+}
+
+std::unique_ptr<Entity> clone_entity(const Entity& src)
+{
+    auto clone = std::make_unique<Entity>();
+    clone->set_coordinates(src.get_coordinates());
+
+    if (src.get_brain()) {
+        clone->set_brain(std::make_shared<Brain>(*src.get_brain()));
+    }
+
+    if (src.get_biology()) {
+        clone->set_biology(std::make_shared<Biology>(*src.get_biology()));
+    }
+    clone->set_lineage(src.get_parent_id(), src.get_generation());
+
+    return clone;
+}
+
+EvolutionEngine::EvolutionEngine(Simulation& sim, const EvolutionConfig& config)
+    : _sim(sim), _config(config), _generation(0)
+{
+    if (config.population <= 0 || config.trials <= 0 || config.max_ticks <= 0)
+    {
+        throw std::invalid_argument("Evolution population, trials and ticks must be > 0");
+    }
+    if (config.tournament_size <= 0)
+    {
+        throw std::invalid_argument("Tournament size must be > 0");
+    }
+}
+
+void EvolutionEngine::seed_population()
+{
+    const size_t n = static_cast<size_t>(_config.population);
+    _population.resize(n);
+    _next.resize(n);
+    _fitness.assign(n, 0.0);
+    _generation = 0;
+
+    for (size_t j = 0; j < n; ++j)
+    {
+        _sim.set_primary_entity_random();
+        Entity* sampled = _sim.get_primary_entity();
+        if (!sampled)
+        {
+            throw std::runtime_error("Failed to sample initial entity");
+        }
+        _population[j] = clone_entity(*sampled);
+        _next[j] = clone_entity(*sampled);      // Spare slot, overwritten by the first breeding
+    }
+}
+
+int EvolutionEngine::run_trial(const Entity& entity)
+{
+    _sim.seed_resources();
+    _sim.set_primary_entity(entity);
+    int ticks = 0;
+    while (ticks < _config.max_ticks)
+    {
+        int result = _sim.tick(0);
+        if (result == -1 || ticks == _config.max_ticks - 1)
+        {
+            break;
+        }
+        ticks++;
+    }
+    return ticks;
+}
+
+void EvolutionEngine::run_trials(size_t index, int count)
+{
+    for (int m = 0; m < count; ++m)
+    {
+        int ticks = run_trial(*_population[index]);
+        _trial_totals[index] += ticks;
+        _trial_counts[index] += 1;
+        _eval_stats.ticks += ticks;
+        _eval_stats.trials += 1;
+    }
+}
+
+void EvolutionEngine::evaluate()
+{
+    PROFILE_SCOPE("evolution/evaluate");
+    const size_t n = _population.size();
+    _eval_stats = EvaluationStats();
+    _trial_totals.assign(n, 0);
+    _trial_counts.assign(n, 0);
+
+    if (_config.adaptive_trials && _config.trials > 1)
+    {
+        evaluate_adaptive();
+    }
+    else
+    {
+        evaluate_fixed();
+    }
+    for (size_t j = 0; j < n; ++j)
+    {
+        // Exact mean, the same value evaluate_adaptive ranks on, so scores add no rounding ties
+        _fitness[j] = static_cast<double>(_trial_totals[j]) / _trial_counts[j];
+    }
+}
+
+void EvolutionEngine::evaluate_fixed()
+{
+    for (size_t j = 0; j < _population.size(); ++j)
+    {
+        run_trials(j, _config.trials);
+    }
+}
+
+void EvolutionEngine::evaluate_adaptive()
+{
+    const size_t n = _population.size();
+    const size_t contested = contested_count();
+    auto mean = [this](size_t j) { return static_cast<double>(_trial_totals[j]) / _trial_counts[j]; };
+    auto better = [&](size_t a, size_t b) { return mean(a) > mean(b) || (mean(a) == mean(b) && a < b); };
+
+    std::vector<size_t> alive(n);
+    std::iota(alive.begin(), alive.end(), size_t{0});
+    for (size_t j : alive)
+    {
+        run_trials(j, 1);
+    }
+
+    // Successive halving: the bottom half of the race stops after this many trials
+    double skipped_ticks = 0.0;
+    for (int round = 1; round < _config.trials; ++round)
+    {
+        size_t keep = std::min(alive.size(), std::max(2 * contested, (alive.size() + 1) / 2));
+        std::sort(alive.begin(), alive.end(), better);
+        for (size_t r = keep; r < alive.size(); ++r)
+        {
+            const int missing = _config.trials - _trial_counts[alive[r]];
+            _eval_stats.trials_skipped += missing;
+            skipped_ticks += missing * mean(alive[r]);
+        }
+        alive.resize(keep);
+        for (size_t j : alive)
+        {
+            run_trials(j, 1);
+        }
+    }
+
+    // Racing on the leftovers: spend part of the skipped ticks on whoever sits near the cutoff
+    const double budget = skipped_ticks * _config.reinvest_fraction;
+    const long long ticks_before = _eval_stats.ticks;
+    auto reinvested = [&] { return static_cast<double>(_eval_stats.ticks - ticks_before); };
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t{0});
+    const size_t band_lo = contested / 2;
+    const size_t band_hi = std::min(n, 2 * contested);
+    while (band_lo < band_hi && reinvested() < budget)
+    {
+        const double pass_start = reinvested();
+        std::sort(order.begin(), order.end(), better);
+        for (size_t r = band_lo; r < band_hi && reinvested() < budget; ++r)
+        {
+            run_trials(order[r], 1);
+            _eval_stats.trials_reinvested += 1;
+        }
+        if (reinvested() == pass_start)
+        {
+            break;      // Every trial in the band died on its first tick; more passes would spin
+        }
+    }
+
+    _eval_stats.ticks_saved = std::max(0LL, static_cast<long long>(skipped_ticks - reinvested()));
+}
+
+size_t EvolutionEngine::contested_count() const
+{
+    const size_t n = _population.size();
+    if (_config.selection == SelectionMethod::TRUNCATION)
+    {
+        return std::max<size_t>(1, static_cast<size_t>(n * _config.truncation_fraction));
+    }
+    return std::max<size_t>(1, n / 2);
+}
+
+void EvolutionEngine::prepare_selection()
+{
+    const size_t n = _fitness.size();
+    switch (_config.selection)
+    {
+        case SelectionMethod::TRUNCATION:
+        {
+            _pool = FitnessCalculator::selectTopK(_fitness.data(), n, contested_count());
+            break;
+        }
+        case SelectionMethod::RANK:
+        {
+            // Best first from selectTopK, flipped so rank r (1-based) sits at index r - 1
+            _rank_order = FitnessCalculator::selectTopK(_fitness.data(), n, n);
+            std::reverse(_rank_order.begin(), _rank_order.end());
+            _rank_cumulative.resize(n);
+            double total = 0.0;
+            for (size_t r = 0; r < n; ++r)
+            {
+                total += static_cast<double>(r + 1);
+                _rank_cumulative[r] = total;
+            }
+            break;
+        }
+        case SelectionMethod::TOURNAMENT:
+            break;
+    }
+}
+
+size_t EvolutionEngine::select_parent() const
+{
+    const size_t n = _fitness.size();
+    switch (_config.selection)
+    {
+        case SelectionMethod::TRUNCATION:
+            return _pool[static_cast<size_t>(rng::next_int(static_cast<int>(_pool.size())))];
+
+        case SelectionMethod::TOURNAMENT:
+        {
+            size_t best = static_cast<size_t>(rng::next_int(static_cast<int>(n)));
+            for (int k = 1; k < _config.tournament_size; ++k)
+            {
+                size_t entrant = static_cast<size_t>(rng::next_int(static_cast<int>(n)));
+                if (_fitness[entrant] > _fitness[best])
+                {
+                    best = entrant;
+                }
+            }
+            return best;
+        }
+
+        case SelectionMethod::RANK:
+        {
+            double pick = rng::unit() * _rank_cumulative.back();
+            size_t r = static_cast<size_t>(std::upper_bound(_rank_cumulative.begin(), _rank_cumulative.end(), pick)
+                                           - _rank_cumulative.begin());
+            return _rank_order[std::min(r, n - 1)];
+        }
+    }
+    return 0;
+}
+
+void EvolutionEngine::breed_next_generation()
+{
+    PROFILE_SCOPE("evolution/breed");
+    prepare_selection();
+    for (size_t j = 0; j < _next.size(); ++j)
+    {
+        const Entity& parent1 = *_population[select_parent()];
+        const Entity& parent2 = *_population[select_parent()];
+        _sim.breed_into(parent1, parent2, *_next[j]);
+    }
+    _population.swap(_next);
+    std::fill(_fitness.begin(), _fitness.end(), 0.0);
+    ++_generation;
+}
+
+void EvolutionEngine::set_fitness(const std::vector<double>& fitness)
+{
+    if (fitness.size() != _population.size())
+    {
+        throw std::invalid_argument("Fitness count must match the population size");
+    }
+    _fitness = fitness;
+}
+
+size_t EvolutionEngine::best_index() const
+{
+    return static_cast<size_t>(std::distance(_fitness.begin(), std::max_element(_fitness.begin(), _fitness.end())));
+}
+
+double EvolutionEngine::mean_fitness() const
+{
+    return _fitness.empty() ? 0.0 : std::accumulate(_fitness.begin(), _fitness.end(), 0.0) / _fitness.size();
+}
+
+void EvolutionEngine::run(std::ostream& log, const std::function<void(EvolutionEngine&)>& after_evaluate)
+{
+    if (_population.empty())
+    {
+        seed_population();
+    }
+    const int first = _generation;     // Resumed runs don't rewrite the checkpoint they loaded
+    const bool checkpointing = _config.checkpoint_every > 0 && !_config.checkpoint_path.empty();
+    while (_generation < _config.generations)
+    {
+        if (checkpointing && _generation != first && _generation % _config.checkpoint_every == 0)
+        {
+            save_checkpoint(_config.checkpoint_path);
+            log << "Checkpoint at generation " << (_generation + 1) << " -> " << _config.checkpoint_path << std::endl;
+        }
+        evaluate();
+        log << "Generation " << (_generation + 1)
+            << " mean fitness: " << mean_fitness()
+            << " best: " << _fitness[best_index()];
+        if (_config.adaptive_trials)
+        {
+            log << " ticks: " << _eval_stats.ticks << " saved: " << _eval_stats.ticks_saved
+                << " (" << _eval_stats.trials_skipped << " trials skipped, "
+                << _eval_stats.trials_reinvested << " reinvested)";
+        }
+        log << std::endl;
+        if (after_evaluate)
+        {
+            after_evaluate(*this);
+        }
+        if (_generation + 1 >= _config.generations)
+        {
+            break;
+        }
+        breed_next_generation();
+    }
+}
+
+void EvolutionEngine::save_checkpoint(const std::string& path) const
+{
+    PROFILE_SCOPE("persist/checkpoint_save");
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            throw std::runtime_error("Cannot write checkpoint: " + tmp);
+        }
+        out.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        write_value(out, CHECKPOINT_VERSION);
+        write_value(out, static_cast<int32_t>(_generation));
+        write_value(out, static_cast<uint32_t>(_population.size()));
+        const std::string rng_state = rng::save_state();
+        write_bytes(out, rng_state.data(), rng_state.size());
+        write_value(out, static_cast<int64_t>(Entity::next_id()));
+        for (const auto& entity : _population)
+        {
+            write_entity(out, *entity);
+        }
+        out.flush();
+        if (!out)
+        {
+            throw std::runtime_error("Failed writing checkpoint: " + tmp);
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0)
+    {
+        throw std::runtime_error("Cannot replace checkpoint: " + path);
+    }
+}
+
+void EvolutionEngine::load_checkpoint(const std::string& path)
+{
+    PROFILE_SCOPE("persist/checkpoint_load");
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        throw std::runtime_error("Cannot open checkpoint: " + path);
+    }
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), CHECKPOINT_MAGIC))
+    {
+        throw std::runtime_error("Not an evolution checkpoint: " + path);
+    }
+    const uint32_t version = read_value<uint32_t>(in);
+    if (version < 1 || version > CHECKPOINT_VERSION)
+    {
+        throw std::runtime_error("Unsupported checkpoint version: " + path);
+    }
+    const int generation = read_value<int32_t>(in);
+    const uint32_t count = read_value<uint32_t>(in);
+    if (count == 0)
+    {
+        throw std::runtime_error("Checkpoint has no population: " + path);
+    }
+    const std::string rng_state = read_bytes(in);
+    const long long next_id = version >= 2 ? read_value<int64_t>(in) : -1;   // Version 1 didn't save it
+
+    // Building Brains draws from the RNG and building Entities draws IDs, so the saved RNG
+    // state and ID counter go back in last
+    std::vector<std::unique_ptr<Entity>> population(count);
+    for (uint32_t j = 0; j < count; ++j)
+    {
+        population[j] = read_entity(in);
+    }
+
+    if (!rng::load_state(rng_state))
+    {
+        throw std::runtime_error("Checkpoint RNG state is corrupt: " + path);
+    }
+    _population = std::move(population);
+    _next.resize(count);
+    for (uint32_t j = 0; j < count; ++j)
+    {
+        _next[j] = clone_entity(*_population[j]);
+    }
+    if (next_id >= 0)
+    {
+        Entity::set_next_id(next_id);
+    }
+    _fitness.assign(count, 0.0);
+    _generation = generation;
+    _config.population = static_cast<int>(count);
+}
+
+std::string EvolutionEngine::encode_migrants(size_t count) const
+{
+    std::vector<size_t> best = FitnessCalculator::selectTopK(_fitness.data(), _fitness.size(), count);
+    std::ostringstream out(std::ios::binary);
+    write_value(out, static_cast<uint32_t>(best.size()));
+    for (size_t j : best)
+    {
+        write_value(out, _fitness[j]);
+        write_entity(out, *_population[j]);
+    }
+    return out.str();
+}
+
+size_t EvolutionEngine::accept_migrants(const std::string& payload)
+{
+    std::istringstream in(payload, std::ios::binary);
+    const uint32_t count = read_value<uint32_t>(in);
+
+    // Worst first, so migrants only ever displace the bottom of the population
+    std::vector<size_t> order(_fitness.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return _fitness[a] < _fitness[b]; });
+
+    const size_t accepted = std::min<size_t>(count, order.size());
+    for (size_t m = 0; m < accepted; ++m)
+    {
+        const double fitness = read_value<double>(in);
+        _population[order[m]] = read_entity(in);
+        _fitness[order[m]] = fitness;
+    }
+    return accepted;
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Simulation.hpp"
+
+/**
+ * @brief How parents are picked from an evaluated generation
+ */
+enum class SelectionMethod
+{
+    TRUNCATION,  // Uniform among the top fraction
+    TOURNAMENT,  // Best of k uniformly drawn entrants
+    RANK         // Probability proportional to rank (worst = 1, best = N)
+};
+
+/**
+ * @brief Parses "truncation", "tournament" or "rank"
+ * @throws std::invalid_argument for anything else
+ */
+SelectionMethod parse_selection_method(const std::string& name);
+const char* selection_method_name(SelectionMethod method);
+
+/**
+ * @struct EvolutionConfig
+ * @brief Everything an evolution run needs; defaults match the original alpha demonstration
+ */
+struct EvolutionConfig
+{
+    int generations = 100;
+    int population = 100;
+    int trials = 3;                 // Runs averaged per entity
+    int max_ticks = 10000;          // Per trial
+    SelectionMethod selection = SelectionMethod::TRUNCATION;
+    double truncation_fraction = 0.1;
+    int tournament_size = 3;
+    bool adaptive_trials = false;   // Successive halving instead of every entity running every trial
+    double reinvest_fraction = 0.5; // Share of the skipped ticks re-spent near the selection cutoff
+    int checkpoint_every = 0;       // Generations between checkpoints, 0 = off
+    std::string checkpoint_path;    // Overwritten in place (write + rename) each time
+};
+
+/**
+ * @struct EvaluationStats
+ * @brief Trial and tick accounting for the last evaluate()
+ */
+struct EvaluationStats
+{
+    long long trials = 0;           // Trials actually run
+    long long ticks = 0;            // Ticks actually simulated
+    long long trials_skipped = 0;   // Fixed-budget trials successive halving didn't run
+    long long trials_reinvested = 0;
+    long long ticks_saved = 0;      // Estimated fixed-budget ticks minus ticks, never negative
+};
+
+/**
+ * @brief Clones an entity with independent Brain and Biology ownership
+ */
+std::unique_ptr<Entity> clone_entity(const Entity& src);
+
+/**
+ * @class EvolutionEngine
+ * @brief Evaluate / select / breed loop over a fixed-size population
+ *
+ * The population and the next generation are two preallocated slot arrays; breeding writes
+ * children straight into the spare array (Simulation::breed_into) and the arrays swap, so a
+ * generation costs no Entity or Brain allocations and never touches the simulation's own
+ * entity list.
+ */
+class EvolutionEngine
+{
+private:
+    Simulation& _sim;
+    EvolutionConfig _config;
+    std::vector<std::unique_ptr<Entity>> _population;
+    std::vector<std::unique_ptr<Entity>> _next;
+    std::vector<double> _fitness;
+    int _generation;
+    EvaluationStats _eval_stats;
+
+    // Per-entity trial sums for evaluate()
+    std::vector<long long> _trial_totals;
+    std::vector<int> _trial_counts;
+
+    // Per-generation selection tables
+    std::vector<size_t> _pool;          // Truncation: surviving indices
+    std::vector<size_t> _rank_order;    // Rank: indices worst to best
+    std::vector<double> _rank_cumulative;
+
+    void run_trials(size_t index, int count);
+    void evaluate_fixed();
+    void evaluate_adaptive();
+
+public:
+    /**
+     * @brief Creates an engine bound to an initialized simulation
+     * @throws std::invalid_argument on a non-positive population, trial or tick count
+     */
+    EvolutionEngine(Simulation& sim, const EvolutionConfig& config);
+
+    /**
+     * @brief Fills the population with random founders (generation 0)
+     */
+    void seed_population();
+
+    /**
+     * @brief Runs one trial of an entity on freshly seeded resources
+     * @return Ticks survived, capped at max_ticks - 1
+     */
+    int run_trial(const Entity& entity);
+
+    /**
+     * @brief Scores every entity as the mean of its trials
+     *
+     * With adaptive_trials, every entity runs one trial, then each round drops the worse half
+     * of the candidates still in the race (never below twice contested_count()) until the
+     * survivors have run the full trial count. A reinvest_fraction of the ticks the skipped
+     * trials would have cost then goes, one trial at a time, to whoever currently ranks around
+     * the selection cutoff.
+     */
+    void evaluate();
+
+    /**
+     * @brief How many of the best entities the selection method really depends on
+     * Truncation: the kept pool. Tournament and rank: the top half.
+     */
+    size_t contested_count() const;
+
+    /**
+     * @brief Builds the selection method's tables (truncation pool, rank order) from the scores
+     */
+    void prepare_selection();
+
+    /**
+     * @brief Draws one parent index with the configured method; call prepare_selection() first
+     */
+    size_t select_parent() const;
+
+    /**
+     * @brief Selects parents from the current scores and breeds the next generation in place
+     */
+    void breed_next_generation();
+
+    /**
+     * @brief evaluate() + report + breed, for the configured number of generations
+     * Checkpoints every checkpoint_every generations when a checkpoint path is set
+     * @param log One line per generation: generation, mean, best
+     * @param after_evaluate Called once the generation is scored, before it breeds (migration)
+     */
+    void run(std::ostream& log, const std::function<void(EvolutionEngine&)>& after_evaluate = {});
+
+    /**
+     * @brief Writes the unevaluated population, generation and RNG state to path
+     * Goes through path + ".tmp" and a rename, so a kill mid-write keeps the previous checkpoint
+     * @throws std::runtime_error if the file can't be written
+     */
+    void save_checkpoint(const std::string& path) const;
+
+    /**
+     * @brief Replaces the population, generation and RNG state with a checkpoint's
+     * The population size comes from the checkpoint, not the config
+     * @throws std::runtime_error on a missing, truncated or foreign file
+     */
+    void load_checkpoint(const std::string& path);
+
+    /**
+     * @brief Serializes the count best entities and their scores, in the checkpoint's entity format
+     */
+    std::string encode_migrants(size_t count) const;
+
+    /**
+     * @brief Replaces the worst-scoring entities with migrants from encode_migrants()
+     * Call between evaluate() and breed_next_generation(); migrants keep their scores
+     * @return Number of entities replaced
+     * @throws std::runtime_error on a malformed payload
+     */
+    size_t accept_migrants(const std::string& payload);
+
+    int get_generation() const { return _generation; }
+    const EvolutionConfig& get_config() const { return _config; }
+    const std::vector<double>& get_fitness() const { return _fitness; }
+
+    /**
+     * @brief Replaces the scores, e.g. with ones computed outside evaluate()
+     * @throws std::invalid_argument if the size doesn't match the population
+     */
+    void set_fitness(const std::vector<double>& fitness);
+    const EvaluationStats& get_evaluation_stats() const { return _eval_stats; }
+    const std::vector<std::unique_ptr<Entity>>& get_population() const { return _population; }
+    size_t best_index() const;
+    double mean_fitness() const;
+};
@@ -0,0 +1,326 @@
+#include "frame_export.h"
+#include "Simulation.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <sys/wait.h>
+
+namespace
+{
+    bool is_video(const std::string& target)
+    {
+        static const char* const extensions[] = {".mp4", ".mkv", ".webm", ".mov", ".gif"};
+        const std::string ext = std::filesystem::path(target).extension().string();
+        return std::any_of(std::begin(extensions), std::end(extensions),
+                           [&](const char* e) { return ext == e; });
+    }
+
+    /** Single-quotes a path for /bin/sh */
+    std::string shell_quote(const std::string& text)
+    {
+        std::string out = "'";
+        for (char c : text)
+        {
+            out += (c == '\'') ? std::string("'\\''") : std::string(1, c);
+        }
+        return out + "'";
+    }
+
+    std::string frame_name(long long index, const char* extension)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%06lld.%s", index, extension);
+        return name;
+    }
+
+    const std::array<uint32_t, 256>& crc_table()
+    {
+        static const std::array<uint32_t, 256> table = []
+        {
+            std::array<uint32_t, 256> t{};
+            for (uint32_t n = 0; n < 256; ++n)
+            {
+                uint32_t c = n;
+                for (int k = 0; k < 8; ++k)
+                {
+                    c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                }
+                t[n] = c;
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size)
+    {
+        const auto& table = crc_table();
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i)
+        {
+            crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    void put_be32(std::vector<uint8_t>& out, uint32_t value)
+    {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void put_chunk(std::vector<uint8_t>& out, const char type[4], const std::vector<uint8_t>& data)
+    {
+        put_be32(out, static_cast<uint32_t>(data.size()));
+        const size_t start = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data.begin(), data.end());
+        put_be32(out, crc32(0, out.data() + start, out.size() - start));
+    }
+}
+
+bool write_ppm(const std::string& path, const uint8_t* rgb, int width, int height)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << "P6\n" << width << " " << height << "\n255\n";
+    out.write(reinterpret_cast<const char*>(rgb), static_cast<std::streamsize>(width) * height * 3);
+    return static_cast<bool>(out);
+}
+
+bool write_png(const std::string& path, const uint8_t* rgb, int width, int height)
+{
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+
+    std::vector<uint8_t> header;
+    put_be32(header, static_cast<uint32_t>(width));
+    put_be32(header, static_cast<uint32_t>(height));
+    header.insert(header.end(), {8, 2, 0, 0, 0});      // 8-bit RGB, deflate, no filter, no interlace
+    put_chunk(png, "IHDR", header);
+
+    // Scanlines with filter type 0, wrapped in a zlib stream of stored blocks
+    const size_t row_bytes = static_cast<size_t>(width) * 3;
+    std::vector<uint8_t> raw;
+    raw.reserve((row_bytes + 1) * height);
+    for (int y = 0; y < height; ++y)
+    {
+        raw.push_back(0);
+        raw.insert(raw.end(), rgb + y * row_bytes, rgb + (y + 1) * row_bytes);
+    }
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    for (size_t offset = 0; offset < raw.size() || offset == 0; )
+    {
+        const size_t length = std::min<size_t>(65535, raw.size() - offset);
+        const bool last = offset + length == raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(static_cast<uint8_t>(length));
+        zlib.push_back(static_cast<uint8_t>(length >> 8));
+        zlib.push_back(static_cast<uint8_t>(~length));
+        zlib.push_back(static_cast<uint8_t>(~length >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+        offset += length;
+        if (last)
+        {
+            break;
+        }
+    }
+    uint32_t a = 1, b = 0;      // Adler-32 of the uncompressed data
+    for (uint8_t byte : raw)
+    {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    put_be32(zlib, (b << 16) | a);
+    put_chunk(png, "IDAT", zlib);
+    put_chunk(png, "IEND", {});
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+    return static_cast<bool>(out);
+}
+
+FrameExporter::FrameExporter(const FrameExportConfig& config) : _config(config)
+{
+    _config.every = std::max(1, _config.every);
+    _config.scale = std::max(1, _config.scale);
+    if (!is_video(_config.target))
+    {
+        std::filesystem::create_directories(_config.target);
+    }
+    else if (std::system("command -v ffmpeg > /dev/null 2>&1") != 0)
+    {
+        throw std::runtime_error("ffmpeg not found on PATH; export to a directory instead");
+    }
+    int threads = _config.threads > 0 ? _config.threads : static_cast<int>(std::thread::hardware_concurrency());
+    for (int band = 1; band < std::max(1, threads); ++band)
+    {
+        _workers.emplace_back(&FrameExporter::worker_loop, this, band);
+    }
+}
+
+FrameExporter::~FrameExporter()
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _stop = true;
+    }
+    _start.notify_all();
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+    finish();
+}
+
+void FrameExporter::worker_loop(int band)
+{
+    uint64_t seen = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+            _start.wait(guard, [&] { return _stop || _job != seen; });
+            if (_stop)
+            {
+                return;
+            }
+            seen = _job;
+        }
+        rasterize_band(band);
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            --_pending;
+        }
+        _done.notify_one();
+    }
+}
+
+void FrameExporter::rasterize_band(int band)
+{
+    const int bands = static_cast<int>(_workers.size()) + 1;
+    const int tiles_y = _cells.height();
+    const int first = tiles_y * band / bands;
+    const int last = tiles_y * (band + 1) / bands;
+    const int scale = _config.scale;
+    const size_t row_bytes = static_cast<size_t>(_width) * 3;
+
+    for (int ty = first; ty < last; ++ty)
+    {
+        // Build the tile row's first pixel row, then copy it down scale - 1 times
+        uint8_t* row = _rgb.data() + static_cast<size_t>(ty) * scale * row_bytes;
+        uint8_t* pixel = row;
+        for (int tx = 0; tx < _cells.width(); ++tx)
+        {
+            const FrameCell& cell = _cells.get(tx, ty);
+            const bool dim = cell.glyph == FrameCell::SHADE;
+            const uint8_t r = dim ? static_cast<uint8_t>(cell.r * 3 / 4) : cell.r;
+            const uint8_t g = dim ? static_cast<uint8_t>(cell.g * 3 / 4) : cell.g;
+            const uint8_t b = dim ? static_cast<uint8_t>(cell.b * 3 / 4) : cell.b;
+            for (int i = 0; i < scale; ++i)
+            {
+                pixel[0] = r;
+                pixel[1] = g;
+                pixel[2] = b;
+                pixel += 3;
+            }
+        }
+        for (int i = 1; i < scale; ++i)
+        {
+            std::memcpy(row + i * row_bytes, row, row_bytes);
+        }
+    }
+}
+
+void FrameExporter::rasterize()
+{
+    if (!_workers.empty())
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _pending = static_cast<int>(_workers.size());
+        ++_job;
+    }
+    _start.notify_all();
+    rasterize_band(0);
+    std::unique_lock<std::mutex> guard(_lock);
+    _done.wait(guard, [&] { return _pending == 0; });
+}
+
+void FrameExporter::write_frame()
+{
+    if (is_video(_config.target))
+    {
+        if (!_pipe)
+        {
+            // Pad to even dimensions, which yuv420p needs
+            std::string command = "ffmpeg -loglevel error -y -f rawvideo -pix_fmt rgb24 -video_size "
+                + std::to_string(_width) + "x" + std::to_string(_height)
+                + " -framerate " + std::to_string(_config.fps)
+                + " -i - -vf 'pad=ceil(iw/2)*2:ceil(ih/2)*2' -pix_fmt yuv420p " + shell_quote(_config.target);
+            std::signal(SIGPIPE, SIG_IGN);     // A dead ffmpeg becomes a write error, not a kill
+            _pipe = ::popen(command.c_str(), "w");
+            if (!_pipe)
+            {
+                throw std::runtime_error("Cannot start ffmpeg");
+            }
+        }
+        if (std::fwrite(_rgb.data(), 1, _rgb.size(), _pipe) != _rgb.size())
+        {
+            throw std::runtime_error("ffmpeg stopped accepting frames");
+        }
+        return;
+    }
+    const std::string path = (std::filesystem::path(_config.target) / frame_name(_frames, _config.png ? "png" : "ppm")).string();
+    const bool written = _config.png ? write_png(path, _rgb.data(), _width, _height)
+                                     : write_ppm(path, _rgb.data(), _width, _height);
+    if (!written)
+    {
+        throw std::runtime_error("Cannot write frame: " + path);
+    }
+}
+
+bool FrameExporter::on_tick(const Simulation& sim, long long tick)
+{
+    if (tick % _config.every != 0)
+    {
+        return false;
+    }
+    export_frame(sim);
+    return true;
+}
+
+void FrameExporter::export_frame(const Simulation& sim)
+{
+    auto start = std::chrono::steady_clock::now();
+    sim.render_frame(_cells);
+    const int width = _cells.width() * _config.scale;
+    const int height = _cells.height() * _config.scale;
+    if (_pipe && (width != _width || height != _height))
+    {
+        throw std::runtime_error("Frame size changed mid-video");
+    }
+    _width = width;
+    _height = height;
+    _rgb.resize(static_cast<size_t>(_width) * _height * 3);
+    rasterize();
+    write_frame();
+    ++_frames;
+    _seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool FrameExporter::finish()
+{
+    if (!_pipe)
+    {
+        return true;
+    }
+    int status = ::pclose(_pipe);
+    _pipe = nullptr;
+    return status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "frame_renderer.h"
+
+class Simulation;
+
+/**
+ * @struct FrameExportConfig
+ * @brief Where exported frames go and how often
+ *
+ * A target ending in .mp4, .mkv, .webm, .mov or .gif is encoded by piping raw RGB frames to
+ * ffmpeg; anything else is a directory that gets frame_000000.ppm (or .png) files.
+ */
+struct FrameExportConfig
+{
+    std::string target;
+    int every = 1;                  // Export every Nth tick
+    int scale = 8;                  // Pixels per tile edge
+    int threads = 0;                // Rasterizer threads, 0 = hardware concurrency
+    int fps = 30;                   // Frame rate written into videos
+    bool png = false;               // Directory output as PNG instead of PPM
+};
+
+/**
+ * @class FrameExporter
+ * @brief Rasterizes the display_environment view into RGB frames off-screen
+ *
+ * Each tile becomes a scale x scale block in the color the terminal view uses; terrain is
+ * drawn at 3/4 brightness, the way the light-shade glyph reads next to solid resources and
+ * entities. Rows of tiles are split across a fixed set of worker threads, and the frame is
+ * written before the call returns.
+ */
+class FrameExporter
+{
+private:
+    FrameExportConfig _config;
+    FrameRenderer _cells;
+    std::vector<uint8_t> _rgb;
+    int _width = 0;                 // Pixels
+    int _height = 0;
+    FILE* _pipe = nullptr;
+    long long _frames = 0;
+    double _seconds = 0.0;
+
+    // Workers rasterize one band of tile rows each per frame; band 0 runs on the caller
+    std::vector<std::thread> _workers;
+    std::mutex _lock;
+    std::condition_variable _start;
+    std::condition_variable _done;
+    uint64_t _job = 0;
+    int _pending = 0;
+    bool _stop = false;
+
+    void worker_loop(int band);
+    void rasterize_band(int band);
+    void rasterize();
+    void write_frame();
+
+public:
+    /**
+     * @throws std::runtime_error if the output directory can't be created, or a video target
+     * is given and ffmpeg isn't on PATH
+     */
+    explicit FrameExporter(const FrameExportConfig& config);
+    ~FrameExporter();
+
+    FrameExporter(const FrameExporter&) = delete;
+    FrameExporter& operator=(const FrameExporter&) = delete;
+
+    /**
+     * @brief Exports the simulation's current view when tick is a multiple of `every`
+     * @return true if a frame was written
+     * @throws std::runtime_error if ffmpeg can't be started or a frame can't be written
+     */
+    bool on_tick(const Simulation& sim, long long tick);
+
+    /**
+     * @brief Exports the current view unconditionally
+     */
+    void export_frame(const Simulation& sim);
+
+    /**
+     * @brief Flushes and closes the ffmpeg pipe, if any
+     * @return false if ffmpeg exited with an error
+     */
+    bool finish();
+
+    long long frames() const { return _frames; }
+    double seconds() const { return _seconds; }     // Time spent rasterizing and writing
+    const std::vector<uint8_t>& rgb() const { return _rgb; }
+    int width() const { return _width; }
+    int height() const { return _height; }
+};
+
+/**
+ * @brief Writes packed RGB as a binary PPM (P6)
+ */
+bool write_ppm(const std::string& path, const uint8_t* rgb, int width, int height);
+
+/**
+ * @brief Writes packed RGB as a PNG using stored (uncompressed) deflate blocks, so no zlib
+ */
+bool write_png(const std::string& path, const uint8_t* rgb, int width, int height);
@@ -0,0 +1,131 @@
+#include "frame_renderer.h"
+#include <algorithm>
+
+namespace
+{
+    // Each cell is two terminal columns wide so tiles come out roughly square
+    constexpr const char* GLYPHS[] = {u8"░░", u8"██"};
+    constexpr size_t GLYPH_BYTES = 6;
+
+    // Worst case per cell: cursor move, color escape and glyph
+    constexpr size_t MAX_CELL_BYTES = sizeof("\033[65535;65535H") + sizeof("\033[38;2;255;255;255m") + GLYPH_BYTES;
+}
+
+void FrameRenderer::resize(int width, int height)
+{
+    _width = width;
+    _height = height;
+    const size_t cells = static_cast<size_t>(width) * height;
+    _back.assign(cells, FrameCell{});
+    _front.assign(cells, FrameCell{});
+    _front_valid = false;
+    _bytes.reserve(cells * MAX_CELL_BYTES + static_cast<size_t>(height) + 32);
+}
+
+void FrameRenderer::append_number(unsigned value)
+{
+    char digits[10];
+    int n = 0;
+    do
+    {
+        digits[n++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (n > 0)
+    {
+        _bytes.push_back(digits[--n]);
+    }
+}
+
+void FrameRenderer::append_color(const FrameCell& cell)
+{
+    if (_color_known && cell.r == _color.r && cell.g == _color.g && cell.b == _color.b)
+    {
+        return;
+    }
+    _bytes.append("\033[38;2;");
+    append_number(cell.r);
+    _bytes.push_back(';');
+    append_number(cell.g);
+    _bytes.push_back(';');
+    append_number(cell.b);
+    _bytes.push_back('m');
+    _color = cell;
+    _color_known = true;
+}
+
+void FrameRenderer::append_glyph(const FrameCell& cell)
+{
+    _bytes.append(GLYPHS[cell.glyph & 1], GLYPH_BYTES);
+}
+
+void FrameRenderer::append_cursor(int row, int column)
+{
+    _bytes.append("\033[");
+    append_number(static_cast<unsigned>(row));
+    _bytes.push_back(';');
+    append_number(static_cast<unsigned>(column));
+    _bytes.push_back('H');
+}
+
+const std::string& FrameRenderer::compose_full()
+{
+    _bytes.clear();
+    _color_known = false;
+    for (int y = 0; y < _height; ++y)
+    {
+        const FrameCell* row = &_back[static_cast<size_t>(y) * _width];
+        for (int x = 0; x < _width; ++x)
+        {
+            append_color(row[x]);
+            append_glyph(row[x]);
+        }
+        _bytes.push_back('\n');
+    }
+    _bytes.append("\033[0m");
+    _changed = _back.size();
+    return _bytes;
+}
+
+const std::string& FrameRenderer::compose_delta(int top)
+{
+    _bytes.clear();
+    _color_known = false;         // Other output may have changed the color since last frame
+    _changed = 0;
+    const bool redraw = !_front_valid;
+    int cursor_row = -1;
+    int cursor_column = -1;
+    for (int y = 0; y < _height; ++y)
+    {
+        const size_t base = static_cast<size_t>(y) * _width;
+        for (int x = 0; x < _width; ++x)
+        {
+            const FrameCell& cell = _back[base + x];
+            if (!redraw && cell == _front[base + x])
+            {
+                continue;
+            }
+            const int row = top + y;
+            const int column = 2 * x + 1;
+            if (row != cursor_row || column != cursor_column)
+            {
+                append_cursor(row, column);
+            }
+            append_color(cell);
+            append_glyph(cell);
+            cursor_row = row;
+            cursor_column = column + 2;
+            ++_changed;
+        }
+    }
+    if (_changed > 0)
+    {
+        _bytes.append("\033[0m");
+    }
+    // Park the cursor under the grid even on an unchanged frame, so text written after the
+    // delta always lands on the same line
+    append_cursor(top + _height, 1);
+    std::copy(_back.begin(), _back.end(), _front.begin());
+    _front_valid = true;
+    return _bytes;
+}
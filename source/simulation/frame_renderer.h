@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct FrameCell
+ * @brief One grid cell on screen: a 24-bit foreground color and a two-column glyph
+ */
+struct FrameCell
+{
+    enum Glyph : uint8_t { SHADE = 0, SOLID = 1 };
+
+    uint8_t r = 0;
+    uint8_t g = 0;
+    uint8_t b = 0;
+    uint8_t glyph = SHADE;
+
+    bool operator==(const FrameCell& other) const
+    {
+        return r == other.r && g == other.g && b == other.b && glyph == other.glyph;
+    }
+    bool operator!=(const FrameCell& other) const { return !(*this == other); }
+};
+
+/**
+ * @class FrameRenderer
+ * @brief Double-buffered ANSI renderer: cells are drawn into a back buffer, then composed into
+ * one preallocated byte string that the caller writes out in a single call
+ *
+ * compose_full() emits the whole frame as plain lines (for output mixed with log text);
+ * compose_delta() emits only the cells that changed since the last delta, addressed with
+ * cursor moves, for a view that owns the screen. Both skip color escapes that repeat the
+ * previous cell's color.
+ */
+class FrameRenderer
+{
+private:
+    int _width = 0;
+    int _height = 0;
+    std::vector<FrameCell> _back;       // Being drawn
+    std::vector<FrameCell> _front;      // What the screen shows after the last delta
+    bool _front_valid = false;
+    std::string _bytes;
+    size_t _changed = 0;
+
+    // Terminal state while composing, so repeated escapes can be skipped
+    bool _color_known = false;
+    FrameCell _color;
+
+    void append_number(unsigned value);
+    void append_color(const FrameCell& cell);
+    void append_glyph(const FrameCell& cell);
+    void append_cursor(int row, int column);
+
+public:
+    /**
+     * @brief Sizes both buffers and reserves the byte buffer for a full frame; clears the screen
+     * copy, so the next delta redraws everything
+     */
+    void resize(int width, int height);
+
+    int width() const { return _width; }
+    int height() const { return _height; }
+
+    void set(int x, int y, const FrameCell& cell) { _back[static_cast<size_t>(y) * _width + x] = cell; }
+    const FrameCell& get(int x, int y) const { return _back[static_cast<size_t>(y) * _width + x]; }
+
+    /**
+     * @brief Whole back buffer as rows of glyphs, one line per row, color reset at the end
+     */
+    const std::string& compose_full();
+
+    /**
+     * @brief Cells that differ from the previous delta frame, with the grid's top-left at
+     * screen row `top` (1-based); the first delta after resize() or invalidate() draws all.
+     * Always ends with the cursor at column 1 of the row below the grid
+     */
+    const std::string& compose_delta(int top = 1);
+
+    /**
+     * @brief Forget what the screen shows, e.g. after it was cleared or scrolled
+     */
+    void invalidate() { _front_valid = false; }
+
+    /**
+     * @brief Cells written by the last compose call
+     */
+    size_t changed_cells() const { return _changed; }
+};
@@ -0,0 +1,274 @@
+#include "islands.h"
+#include "../entity/decision_center/rng.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+    /**
+     * @brief Collects log output and writes it a whole line at a time, each line prefixed
+     */
+    class IslandLogBuffer : public std::stringbuf
+    {
+    private:
+        std::string _prefix;
+
+    protected:
+        int sync() override
+        {
+            std::string text = str();
+            size_t end = text.rfind('\n');
+            if (end == std::string::npos)
+            {
+                return 0;
+            }
+            std::string out;
+            size_t start = 0;
+            while (start <= end)
+            {
+                size_t eol = text.find('\n', start);
+                out += _prefix;
+                out.append(text, start, eol - start + 1);
+                start = eol + 1;
+            }
+            // One write per flush keeps lines from different islands apart
+            if (::write(STDOUT_FILENO, out.data(), out.size()) < 0)
+            {
+                return -1;
+            }
+            str(text.substr(end + 1));
+            return 0;
+        }
+
+    public:
+        explicit IslandLogBuffer(const std::string& prefix)
+            : std::stringbuf(std::ios::out | std::ios::ate), _prefix(prefix)
+        {
+        }
+    };
+
+    void write_all(int fd, const char* data, size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t n = ::send(fd, data, size, MSG_NOSIGNAL);
+            if (n <= 0)
+            {
+                throw std::runtime_error("Migration peer closed its socket");
+            }
+            data += n;
+            size -= static_cast<size_t>(n);
+        }
+    }
+
+    void read_all(int fd, char* data, size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t n = ::recv(fd, data, size, 0);
+            if (n <= 0)
+            {
+                throw std::runtime_error("Migration peer closed its socket");
+            }
+            data += n;
+            size -= static_cast<size_t>(n);
+        }
+    }
+
+    int run_island(int index, const EvolutionConfig& base, const IslandConfig& islands, bool resume,
+                   uint32_t seed, int send_fd, int receive_fd)
+    {
+        IslandLogBuffer buffer("[island " + std::to_string(index) + "] ");
+        std::ostream log(&buffer);
+
+        rng::seed(seed);
+        reserve_island_ids(index);
+        EvolutionConfig config = base;
+        if (!config.checkpoint_path.empty())
+        {
+            config.checkpoint_path += "." + std::to_string(index);
+        }
+
+        Simulation sim;
+        sim.initialize();
+        EvolutionEngine engine(sim, config);
+        if (resume && std::filesystem::exists(config.checkpoint_path))
+        {
+            engine.load_checkpoint(config.checkpoint_path);
+            log << "Resumed at generation " << (engine.get_generation() + 1) << std::endl;
+        }
+
+        auto migrate = [&](EvolutionEngine& e)
+        {
+            const int done = e.get_generation() + 1;
+            if (islands.migrate_every <= 0 || done % islands.migrate_every != 0 || done >= config.generations)
+            {
+                return;
+            }
+            // Every island sends before it receives, so the send runs beside the receive
+            // instead of deadlocking the ring on full socket buffers
+            const std::string outgoing = e.encode_migrants(static_cast<size_t>(islands.migrants));
+            std::exception_ptr send_error;
+            std::thread sender([&]
+            {
+                try { send_message(send_fd, outgoing); }
+                catch (...) { send_error = std::current_exception(); }
+            });
+            std::string incoming;
+            try
+            {
+                incoming = receive_message(receive_fd);
+            }
+            catch (...)
+            {
+                ::shutdown(send_fd, SHUT_RDWR);     // Unblock the sender before rethrowing
+                sender.join();
+                throw;
+            }
+            sender.join();
+            if (send_error)
+            {
+                std::rethrow_exception(send_error);
+            }
+            size_t accepted = e.accept_migrants(incoming);
+            log << "Migration after generation " << done << ": sent " << islands.migrants
+                << ", accepted " << accepted << " (" << outgoing.size() << " bytes)" << std::endl;
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        const int first = engine.get_generation();
+        engine.run(log, migrate);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        size_t best = engine.best_index();
+        long long evaluated = static_cast<long long>(config.generations - first) * engine.get_config().population;
+        log << "Done: best fitness " << engine.get_fitness()[best] << ", " << evaluated
+            << " entity evaluations in " << seconds << " s" << std::endl;
+        return 0;
+    }
+}
+
+void reserve_island_ids(int index)
+{
+    Entity::set_next_id(Entity::next_id() + (static_cast<long long>(index) << 40));
+}
+
+void send_message(int fd, const std::string& payload)
+{
+    const uint64_t size = payload.size();
+    write_all(fd, reinterpret_cast<const char*>(&size), sizeof(size));
+    write_all(fd, payload.data(), payload.size());
+}
+
+std::string receive_message(int fd)
+{
+    uint64_t size = 0;
+    read_all(fd, reinterpret_cast<char*>(&size), sizeof(size));
+    std::string payload(size, '\0');
+    if (size > 0)
+    {
+        read_all(fd, &payload[0], payload.size());
+    }
+    return payload;
+}
+
+int run_islands(const EvolutionConfig& config, const IslandConfig& islands, bool resume)
+{
+    const int n = islands.islands;
+    if (n <= 0 || islands.migrants < 0)
+    {
+        throw std::invalid_argument("Island count must be > 0 and migrants >= 0");
+    }
+
+    // Ring edge i carries migrants from island i to island (i + 1) % n
+    std::vector<int> edge_send(n), edge_receive(n);
+    for (int i = 0; i < n; ++i)
+    {
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+        {
+            throw std::runtime_error("socketpair failed");
+        }
+        edge_send[i] = fds[0];
+        edge_receive[i] = fds[1];
+    }
+
+    std::cout << "Starting " << n << " islands of " << config.population << " entities, migrating "
+              << islands.migrants << " every " << islands.migrate_every << " generations" << std::endl;
+    std::cout.flush();     // Children would otherwise inherit and repeat unflushed output
+    const uint32_t base_seed = static_cast<uint32_t>(rng::engine()());
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<pid_t> children;
+    for (int i = 0; i < n; ++i)
+    {
+        pid_t pid = ::fork();
+        if (pid < 0)
+        {
+            std::cerr << "fork failed for island " << i << std::endl;
+            break;
+        }
+        if (pid == 0)
+        {
+            const int send_fd = edge_send[i];
+            const int receive_fd = edge_receive[(i + n - 1) % n];
+            for (int e = 0; e < n; ++e)
+            {
+                if (edge_send[e] != send_fd) ::close(edge_send[e]);
+                if (edge_receive[e] != receive_fd) ::close(edge_receive[e]);
+            }
+            int code = 1;
+            try
+            {
+                code = run_island(i, config, islands, resume, base_seed + static_cast<uint32_t>(i),
+                                  send_fd, receive_fd);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "[island " << i << "] " << e.what() << std::endl;
+            }
+            std::cout.flush();
+            ::_exit(code);
+        }
+        children.push_back(pid);
+    }
+
+    // Only the children hold sockets now, so a dead island shows up as EOF at its neighbour
+    for (int i = 0; i < n; ++i)
+    {
+        ::close(edge_send[i]);
+        ::close(edge_receive[i]);
+    }
+
+    int failed = 0;
+    for (pid_t pid : children)
+    {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            ++failed;
+        }
+    }
+    failed += n - static_cast<int>(children.size());
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << n - failed << "/" << n << " islands finished in " << seconds << " s";
+    if (!resume && failed == 0 && seconds > 0.0)
+    {
+        double evaluations = static_cast<double>(n) * config.population * config.generations;
+        std::cout << ", " << evaluations / seconds << " entity evaluations/s overall";
+    }
+    std::cout << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include "evolution.h"
+
+/**
+ * @struct IslandConfig
+ * @brief Island-model layout: independent populations that swap their best entities
+ */
+struct IslandConfig
+{
+    int islands = 1;            // Processes, one population each
+    int migrate_every = 5;      // Generations between migrations, 0 = never
+    int migrants = 2;           // Best entities each island sends per migration
+};
+
+/**
+ * @brief Sends one length-prefixed message over a connected socket
+ * @throws std::runtime_error if the peer is gone
+ */
+void send_message(int fd, const std::string& payload);
+
+/**
+ * @brief Receives one message written by send_message
+ * @throws std::runtime_error on EOF or a socket error
+ */
+std::string receive_message(int fd);
+
+/**
+ * @brief Moves the Entity ID counter into island `index`'s own range of 2^40 IDs
+ *
+ * Every island forks with the same counter and breeds the same number of children, and a
+ * migrant keeps its home ID, so without separate ranges the receiver would already hold
+ * an entity with that ID.
+ */
+void reserve_island_ids(int index);
+
+/**
+ * @brief Runs config on islands.islands forked processes joined in a ring of Unix domain sockets
+ *
+ * Every migrate_every generations each island sends its best migrants to the next island,
+ * serialized with EvolutionEngine::encode_migrants (the checkpoint entity format), and the
+ * ones it receives replace its worst-scoring entities before breeding. Island i is seeded
+ * with a draw from the parent's RNG plus i, hands out IDs from its own range (see
+ * reserve_island_ids), and checkpoints to checkpoint_path + "." + i.
+ * Log lines carry an "[island i]" prefix and are written whole, so islands never interleave
+ * mid-line.
+ *
+ * @return 0 when every island exited cleanly, 1 otherwise
+ */
+int run_islands(const EvolutionConfig& config, const IslandConfig& islands, bool resume);
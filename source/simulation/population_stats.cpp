@@ -0,0 +1,164 @@
+#include "population_stats.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief Two doubles processed together — SSE2 on x86-64, NEON on arm64, plain code elsewhere
+     * The sweep below is written once against these few operations.
+     */
+#if defined(__SSE2__) || defined(_M_X64)
+    using Pair = __m128d;
+    inline Pair pair_load(const double* p) { return _mm_loadu_pd(p); }
+    inline Pair pair_set(double v) { return _mm_set1_pd(v); }
+    inline Pair pair_add(Pair a, Pair b) { return _mm_add_pd(a, b); }
+    inline Pair pair_sub(Pair a, Pair b) { return _mm_sub_pd(a, b); }
+    inline Pair pair_mul(Pair a, Pair b) { return _mm_mul_pd(a, b); }
+    inline Pair pair_min(Pair a, Pair b) { return _mm_min_pd(a, b); }
+    inline Pair pair_max(Pair a, Pair b) { return _mm_max_pd(a, b); }
+    inline void pair_store(double* p, Pair a) { _mm_storeu_pd(p, a); }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    using Pair = float64x2_t;
+    inline Pair pair_load(const double* p) { return vld1q_f64(p); }
+    inline Pair pair_set(double v) { return vdupq_n_f64(v); }
+    inline Pair pair_add(Pair a, Pair b) { return vaddq_f64(a, b); }
+    inline Pair pair_sub(Pair a, Pair b) { return vsubq_f64(a, b); }
+    inline Pair pair_mul(Pair a, Pair b) { return vmulq_f64(a, b); }
+    inline Pair pair_min(Pair a, Pair b) { return vminq_f64(a, b); }
+    inline Pair pair_max(Pair a, Pair b) { return vmaxq_f64(a, b); }
+    inline void pair_store(double* p, Pair a) { vst1q_f64(p, a); }
+#else
+    struct Pair { double v[2]; };
+    inline Pair pair_load(const double* p) { return {{p[0], p[1]}}; }
+    inline Pair pair_set(double v) { return {{v, v}}; }
+    inline Pair pair_add(Pair a, Pair b) { return {{a.v[0] + b.v[0], a.v[1] + b.v[1]}}; }
+    inline Pair pair_sub(Pair a, Pair b) { return {{a.v[0] - b.v[0], a.v[1] - b.v[1]}}; }
+    inline Pair pair_mul(Pair a, Pair b) { return {{a.v[0] * b.v[0], a.v[1] * b.v[1]}}; }
+    inline Pair pair_min(Pair a, Pair b) { return {{std::min(a.v[0], b.v[0]), std::min(a.v[1], b.v[1])}}; }
+    inline Pair pair_max(Pair a, Pair b) { return {{std::max(a.v[0], b.v[0]), std::max(a.v[1], b.v[1])}}; }
+    inline void pair_store(double* p, Pair a) { p[0] = a.v[0]; p[1] = a.v[1]; }
+#endif
+
+    /**
+     * @brief Running sum, sum of squares and range for one chain of pairs
+     */
+    struct Accumulator
+    {
+        Pair sum, sq, lo, hi;
+    };
+
+    inline Accumulator accumulator_start(Pair seed)
+    {
+        return {pair_set(0.0), pair_set(0.0), seed, seed};
+    }
+
+    inline void accumulate(Accumulator& acc, Pair v, Pair shift)
+    {
+        const Pair d = pair_sub(v, shift);
+        acc.sum = pair_add(acc.sum, d);
+        acc.sq = pair_add(acc.sq, pair_mul(d, d));
+        acc.lo = pair_min(acc.lo, v);
+        acc.hi = pair_max(acc.hi, v);
+    }
+
+    inline void accumulator_fold(const Accumulator& acc, double& s, double& s2, MetricSummary& out)
+    {
+        double a[2], b[2], l[2], h[2];
+        pair_store(a, acc.sum);
+        pair_store(b, acc.sq);
+        pair_store(l, acc.lo);
+        pair_store(h, acc.hi);
+        s += a[0] + a[1];
+        s2 += b[0] + b[1];
+        out.min = std::min({out.min, l[0], l[1]});
+        out.max = std::max({out.max, h[0], h[1]});
+    }
+}
+
+MetricSummary summarize_column(const double* values, size_t count)
+{
+    MetricSummary out;
+    if (count == 0)
+    {
+        return out;
+    }
+
+    const double shift = values[0];
+    const Pair shift2 = pair_set(shift);
+
+    // Two independent chains, four values per step, so the adds don't wait on each other
+    Accumulator a = accumulator_start(shift2);
+    Accumulator b = accumulator_start(shift2);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        accumulate(a, pair_load(values + i), shift2);
+        accumulate(b, pair_load(values + i + 2), shift2);
+    }
+
+    // Fold the chains and lanes, then finish the tail one value at a time
+    double s = 0.0, s2 = 0.0;
+    out.min = shift;
+    out.max = shift;
+    accumulator_fold(a, s, s2, out);
+    accumulator_fold(b, s, s2, out);
+    for (; i < count; ++i)
+    {
+        const double d = values[i] - shift;
+        s += d;
+        s2 += d * d;
+        out.min = std::min(out.min, values[i]);
+        out.max = std::max(out.max, values[i]);
+    }
+
+    const double n = static_cast<double>(count);
+    out.mean = shift + s / n;
+    out.variance = std::max(0.0, (s2 - s * s / n) / n);
+    return out;
+}
+
+PopulationStats summarize_population(const PopulationColumns& columns)
+{
+    PopulationStats stats;
+    const size_t n = columns.count;
+    stats.count = static_cast<uint32_t>(n);
+    stats.energy = summarize_column(columns.energy, n);
+    stats.health = summarize_column(columns.health, n);
+    stats.water = summarize_column(columns.water, n);
+    stats.fitness = summarize_column(columns.fitness, n);
+    return stats;
+}
+
+void apply_population_stats(const PopulationStats& stats, SimulationState& state)
+{
+    state.agentCount = stats.count;
+    state.totalResources = stats.resource_count;
+    state.totalEnergy = stats.resource_energy;
+
+    state.averageAgentEnergy = stats.energy.mean;
+    state.minAgentEnergy = stats.energy.min;
+    state.maxAgentEnergy = stats.energy.max;
+    state.varAgentEnergy = stats.energy.variance;
+
+    state.averageHealth = stats.health.mean;
+    state.minHealth = stats.health.min;
+    state.maxHealth = stats.health.max;
+    state.varHealth = stats.health.variance;
+
+    state.averageWater = stats.water.mean;
+    state.minWater = stats.water.min;
+    state.maxWater = stats.water.max;
+    state.varWater = stats.water.variance;
+
+    state.averageFitness = stats.fitness.mean;
+    state.minFitness = stats.fitness.min;
+    state.maxFitness = stats.fitness.max;
+    state.varFitness = stats.fitness.variance;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "simulation_state.h"
+
+/**
+ * @struct MetricSummary
+ * @brief Mean, range and population variance of one per-entity value
+ */
+struct MetricSummary
+{
+    double mean = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double variance = 0.0;
+};
+
+/**
+ * @struct PopulationColumns
+ * @brief Per-entity values laid out one array per field (SoA), index i is the same entity everywhere
+ *
+ * The arrays are borrowed, e.g. straight from a BiologyStore, so summarizing never copies them.
+ */
+struct PopulationColumns
+{
+    const double* energy = nullptr;
+    const double* health = nullptr;
+    const double* water = nullptr;
+    const double* fitness = nullptr;
+    size_t count = 0;
+};
+
+/**
+ * @struct PopulationStats
+ * @brief Everything the per-tick snapshot needs about the population and its resources
+ */
+struct PopulationStats
+{
+    uint32_t count = 0;
+    MetricSummary energy;
+    MetricSummary health;
+    MetricSummary water;
+    MetricSummary fitness;
+    uint32_t resource_count = 0;
+    double resource_energy = 0.0;
+};
+
+/**
+ * @brief Summarizes one column in a single pass
+ *
+ * Accumulates into independent lanes so the compiler can keep them in vector registers;
+ * values are shifted by the first element before squaring so the variance stays accurate
+ * when the spread is small compared to the mean.
+ * @param values Contiguous column
+ * @param count Number of values
+ * @return The summary, all zeros for an empty column
+ */
+MetricSummary summarize_column(const double* values, size_t count);
+
+/**
+ * @brief Summarizes every column of the population (resource fields are left for the caller)
+ * @param columns SoA population values
+ * @return Stats for energy, health, water and fitness
+ */
+PopulationStats summarize_population(const PopulationColumns& columns);
+
+/**
+ * @brief Copies population and resource stats into a tick snapshot
+ * @param stats Result of summarize_population plus resource totals
+ * @param state Snapshot to fill; tick and timestamp are left alone
+ */
+void apply_population_stats(const PopulationStats& stats, SimulationState& state);
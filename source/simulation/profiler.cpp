@@ -0,0 +1,414 @@
+#include "profiler.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Log-linear buckets: values below 4 get their own bucket, every power of two
+     * above that is split into 4, so a bucket is at most 25% wide
+     */
+    constexpr size_t BUCKETS = 252;
+
+    size_t bucket_of(uint64_t value)
+    {
+        if (value < 4)
+        {
+            return static_cast<size_t>(value);
+        }
+        int exponent = 63 - __builtin_clzll(value);
+        return static_cast<size_t>(4 * (exponent - 1)) + ((value >> (exponent - 2)) & 3);
+    }
+
+    uint64_t bucket_floor(size_t bucket)
+    {
+        if (bucket < 4)
+        {
+            return bucket;
+        }
+        int exponent = static_cast<int>(bucket / 4) + 1;
+        return (4 + (bucket % 4)) << (exponent - 2);
+    }
+
+    /**
+     * @brief One phase on one thread; only the owning thread writes, anyone may read
+     *
+     * Relaxed load + store instead of fetch_add: single writer, so nothing is lost, and on
+     * x86 it compiles to plain moves.
+     */
+    struct PhaseSlot
+    {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> total{0};
+        std::atomic<uint64_t> min{UINT64_MAX};
+        std::atomic<uint64_t> max{0};
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets{};
+    };
+
+    inline void bump(std::atomic<uint64_t>& counter, uint64_t by)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    struct TraceEvent
+    {
+        int phase;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    struct ThreadLog
+    {
+        uint32_t tid = 0;
+        std::array<PhaseSlot, profiler::MAX_PHASES> phases;
+        std::vector<TraceEvent> events;
+    };
+
+    /**
+     * @brief Plain copy of the counters, used to merge threads for a report
+     */
+    struct PhaseTotals
+    {
+        uint64_t calls = 0;
+        uint64_t total = 0;
+        uint64_t min = UINT64_MAX;
+        uint64_t max = 0;
+        std::array<uint64_t, BUCKETS> buckets{};
+
+        void add(const PhaseSlot& slot)
+        {
+            calls += slot.calls.load(std::memory_order_relaxed);
+            total += slot.total.load(std::memory_order_relaxed);
+            min = std::min(min, slot.min.load(std::memory_order_relaxed));
+            max = std::max(max, slot.max.load(std::memory_order_relaxed));
+            for (size_t b = 0; b < BUCKETS; ++b)
+            {
+                buckets[b] += slot.buckets[b].load(std::memory_order_relaxed);
+            }
+        }
+
+        /** Upper edge of the bucket holding the q-quantile, clamped to the observed max */
+        uint64_t quantile(double q) const
+        {
+            const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(calls));
+            uint64_t seen = 0;
+            for (size_t b = 0; b < BUCKETS; ++b)
+            {
+                seen += buckets[b];
+                if (seen > rank)
+                {
+                    return std::min(max, b + 1 < BUCKETS ? bucket_floor(b + 1) : max);
+                }
+            }
+            return max;
+        }
+    };
+
+    /**
+     * @brief Phase names and every thread's log; leaked so it outlives thread_local teardown
+     */
+    struct Registry
+    {
+        std::mutex lock;
+        std::array<const char*, profiler::MAX_PHASES> names{};
+        int phase_count = 0;
+        std::vector<ThreadLog*> live;
+        std::array<PhaseTotals, profiler::MAX_PHASES> retired;     // Threads that have exited
+        std::vector<std::pair<uint32_t, TraceEvent>> retired_events;
+        uint32_t next_tid = 1;
+        std::atomic<size_t> trace_limit{0};
+        uint64_t start_ticks = profiler::now();
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    };
+
+    Registry& registry()
+    {
+        static Registry* instance = new Registry();
+        return *instance;
+    }
+
+    /**
+     * @brief Registers the calling thread's log on first use and folds it into retired on exit
+     */
+    class ThreadHandle
+    {
+    private:
+        std::unique_ptr<ThreadLog> _log;
+
+    public:
+        ThreadLog& log()
+        {
+            if (!_log)
+            {
+                _log = std::make_unique<ThreadLog>();
+                Registry& reg = registry();
+                std::lock_guard<std::mutex> guard(reg.lock);
+                _log->tid = reg.next_tid++;
+                reg.live.push_back(_log.get());
+            }
+            return *_log;
+        }
+
+        ~ThreadHandle()
+        {
+            if (!_log)
+            {
+                return;
+            }
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> guard(reg.lock);
+            for (size_t p = 0; p < profiler::MAX_PHASES; ++p)
+            {
+                reg.retired[p].add(_log->phases[p]);
+            }
+            for (const TraceEvent& event : _log->events)
+            {
+                reg.retired_events.emplace_back(_log->tid, event);
+            }
+            reg.live.erase(std::remove(reg.live.begin(), reg.live.end(), _log.get()), reg.live.end());
+        }
+    };
+
+    ThreadLog& thread_log()
+    {
+        thread_local ThreadHandle handle;
+        return handle.log();
+    }
+
+    /**
+     * @brief Profiler ticks per nanosecond, measured against steady_clock since startup
+     */
+    double ticks_per_ns()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        Registry& reg = registry();
+        auto elapsed = [&]
+        {
+            return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - reg.start_time).count();
+        };
+        // Short runs: wait until the interval is long enough for a stable ratio
+        while (elapsed() < 1e7)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        uint64_t ticks = profiler::now() - reg.start_ticks;
+        double ns = elapsed();
+        return ns > 0.0 ? static_cast<double>(ticks) / ns : 1.0;
+#else
+        return 1.0;
+#endif
+    }
+
+    const char* json_name(const char* name)
+    {
+        // Phase names are string literals from PROFILE_SCOPE; reject anything that needs escaping
+        for (const char* c = name; *c; ++c)
+        {
+            if (*c == '"' || *c == '\\' || static_cast<unsigned char>(*c) < 0x20)
+            {
+                return "(invalid name)";
+            }
+        }
+        return name;
+    }
+}
+
+namespace profiler
+{
+    bool compiled_in()
+    {
+#ifdef ALIFE_PROFILE
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    int register_phase(const char* name)
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> guard(reg.lock);
+        for (int p = 0; p < reg.phase_count; ++p)
+        {
+            if (std::strcmp(reg.names[p], name) == 0)
+            {
+                return p;
+            }
+        }
+        if (reg.phase_count == static_cast<int>(MAX_PHASES))
+        {
+            throw std::length_error("Too many profiler phases");
+        }
+        reg.names[reg.phase_count] = name;
+        return reg.phase_count++;
+    }
+
+    void enable_trace(size_t max_events)
+    {
+        registry().trace_limit.store(max_events, std::memory_order_relaxed);
+    }
+
+    void record(int phase, uint64_t start, uint64_t end)
+    {
+        ThreadLog& log = thread_log();
+        PhaseSlot& slot = log.phases[static_cast<size_t>(phase)];
+        const uint64_t elapsed = end >= start ? end - start : 0;
+        bump(slot.calls, 1);
+        bump(slot.total, elapsed);
+        bump(slot.buckets[bucket_of(elapsed)], 1);
+        if (elapsed < slot.min.load(std::memory_order_relaxed))
+        {
+            slot.min.store(elapsed, std::memory_order_relaxed);
+        }
+        if (elapsed > slot.max.load(std::memory_order_relaxed))
+        {
+            slot.max.store(elapsed, std::memory_order_relaxed);
+        }
+        if (log.events.size() < registry().trace_limit.load(std::memory_order_relaxed))
+        {
+            log.events.push_back(TraceEvent{phase, start, end});
+        }
+    }
+
+    void reset()
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> guard(reg.lock);
+        for (ThreadLog* log : reg.live)
+        {
+            for (PhaseSlot& slot : log->phases)
+            {
+                slot.calls.store(0, std::memory_order_relaxed);
+                slot.total.store(0, std::memory_order_relaxed);
+                slot.min.store(UINT64_MAX, std::memory_order_relaxed);
+                slot.max.store(0, std::memory_order_relaxed);
+                for (auto& bucket : slot.buckets)
+                {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+            }
+            log->events.clear();
+        }
+        reg.retired = {};
+        reg.retired_events.clear();
+    }
+
+    void report(std::ostream& out)
+    {
+        if (!compiled_in())
+        {
+            out << "Profiling disabled (configure with -DALIFE_PROFILE=ON)\n";
+            return;
+        }
+        const double per_ns = ticks_per_ns();
+        Registry& reg = registry();
+        std::vector<std::pair<const char*, PhaseTotals>> phases;
+        {
+            std::lock_guard<std::mutex> guard(reg.lock);
+            for (int p = 0; p < reg.phase_count; ++p)
+            {
+                PhaseTotals totals = reg.retired[p];
+                for (ThreadLog* log : reg.live)
+                {
+                    totals.add(log->phases[p]);
+                }
+                phases.emplace_back(reg.names[p], totals);
+            }
+        }
+        std::sort(phases.begin(), phases.end(),
+                  [](const auto& a, const auto& b) { return std::strcmp(a.first, b.first) < 0; });
+
+        auto us = [per_ns](uint64_t ticks) { return static_cast<double>(ticks) / per_ns / 1000.0; };
+        std::ios::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out << std::left << std::setw(28) << "phase" << std::right
+            << std::setw(10) << "calls" << std::setw(12) << "total ms" << std::setw(11) << "mean us"
+            << std::setw(11) << "p50 us" << std::setw(11) << "p90 us" << std::setw(11) << "p99 us"
+            << std::setw(11) << "max us" << "\n";
+        out << std::fixed << std::setprecision(2);
+        for (const auto& [name, t] : phases)
+        {
+            if (t.calls == 0)
+            {
+                continue;
+            }
+            out << std::left << std::setw(28) << name << std::right
+                << std::setw(10) << t.calls << std::setw(12) << us(t.total) / 1000.0
+                << std::setw(11) << us(t.total) / static_cast<double>(t.calls)
+                << std::setw(11) << us(t.quantile(0.50)) << std::setw(11) << us(t.quantile(0.90))
+                << std::setw(11) << us(t.quantile(0.99)) << std::setw(11) << us(t.max) << "\n";
+        }
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    bool write_report(const std::string& path)
+    {
+        const std::string tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp);
+            if (!out)
+            {
+                return false;
+            }
+            report(out);
+            if (!out)
+            {
+                return false;
+            }
+        }
+        return std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+
+    bool write_chrome_trace(const std::string& path)
+    {
+        Registry& reg = registry();
+        if (!compiled_in() || reg.trace_limit.load(std::memory_order_relaxed) == 0)
+        {
+            return false;
+        }
+        const double per_ns = ticks_per_ns();
+        std::ofstream out(path);
+        if (!out)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> guard(reg.lock);
+        out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+        out << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"a-life\"}}";
+        out << std::fixed << std::setprecision(3);
+        auto write_event = [&](uint32_t tid, const TraceEvent& event)
+        {
+            // Complete events ("X"): timestamps and durations in microseconds
+            const double ts = static_cast<double>(event.start - reg.start_ticks) / per_ns / 1000.0;
+            const double dur = static_cast<double>(event.end - event.start) / per_ns / 1000.0;
+            out << ",\n{\"name\": \"" << json_name(reg.names[event.phase]) << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+                << tid << ", \"ts\": " << ts << ", \"dur\": " << dur << "}";
+        };
+        for (const auto& [tid, event] : reg.retired_events)
+        {
+            write_event(tid, event);
+        }
+        for (ThreadLog* log : reg.live)
+        {
+            for (const TraceEvent& event : log->events)
+            {
+                write_event(log->tid, event);
+            }
+        }
+        out << "\n]}\n";
+        return static_cast<bool>(out);
+    }
+}
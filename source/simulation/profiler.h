@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#if defined(ALIFE_PROFILE) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#elif defined(ALIFE_PROFILE)
+#include <chrono>
+#endif
+
+/**
+ * @brief Scoped hot-path timers aggregated into per-phase histograms
+ *
+ * PROFILE_SCOPE("tick/brain") times the rest of the enclosing block. Without ALIFE_PROFILE
+ * (cmake -DALIFE_PROFILE=ON) the macro expands to nothing, so an uninstrumented build pays
+ * nothing; the functions below still exist and report that profiling is off.
+ *
+ * Timestamps come from rdtsc on x86 and steady_clock elsewhere. Each thread records into its
+ * own slots, so timing a phase never takes a lock; a report can be written from any thread
+ * while others keep recording. Nested scopes are inclusive: "tick" contains "tick/brain".
+ */
+namespace profiler
+{
+    constexpr size_t MAX_PHASES = 64;
+
+    /**
+     * @brief True when built with ALIFE_PROFILE
+     */
+    bool compiled_in();
+
+    /**
+     * @brief Id for a phase name, registering it on first use; names must outlive the program
+     */
+    int register_phase(const char* name);
+
+    /**
+     * @brief Also keep every scope as a trace event, up to max_events per thread
+     */
+    void enable_trace(size_t max_events = 1 << 20);
+
+    /**
+     * @brief Clears every histogram and trace event recorded so far
+     */
+    void reset();
+
+    /**
+     * @brief Per-phase table: calls, total and mean time, p50/p90/p99 and max
+     */
+    void report(std::ostream& out);
+
+    /**
+     * @brief Writes the report to path, replacing it atomically
+     * @return false if the file couldn't be written
+     */
+    bool write_report(const std::string& path);
+
+    /**
+     * @brief Writes recorded trace events as Chrome trace-event JSON (chrome://tracing, Perfetto)
+     *
+     * Call once the other recording threads have finished; events are read without locking.
+     * @return false if tracing was never enabled or the file couldn't be written
+     */
+    bool write_chrome_trace(const std::string& path);
+
+    /**
+     * @brief Current timestamp in profiler ticks (TSC cycles or steady_clock ns)
+     */
+    inline uint64_t now()
+    {
+#if defined(ALIFE_PROFILE) && (defined(__x86_64__) || defined(__i386__))
+        return __rdtsc();
+#elif defined(ALIFE_PROFILE)
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Adds one timed call of phase to the calling thread's histogram (and trace)
+     */
+    void record(int phase, uint64_t start, uint64_t end);
+
+    /**
+     * @brief Times its own lifetime as one call of a phase
+     */
+    class ScopedTimer
+    {
+    private:
+        int _phase;
+        uint64_t _start;
+
+    public:
+        explicit ScopedTimer(int phase) : _phase(phase), _start(now()) {}
+        ~ScopedTimer() { record(_phase, _start, now()); }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    };
+}
+
+#define ALIFE_PROFILE_CONCAT_INNER(a, b) a##b
+#define ALIFE_PROFILE_CONCAT(a, b) ALIFE_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef ALIFE_PROFILE
+#define PROFILE_SCOPE(name)                                                                     \
+    static const int ALIFE_PROFILE_CONCAT(_profile_phase_, __LINE__) = profiler::register_phase(name); \
+    profiler::ScopedTimer ALIFE_PROFILE_CONCAT(_profile_timer_, __LINE__)(ALIFE_PROFILE_CONCAT(_profile_phase_, __LINE__))
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
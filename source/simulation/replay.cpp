@@ -0,0 +1,192 @@
+#include "replay.h"
+#include "Simulation.hpp"
+#include "../entity/decision_center/rng.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    const char REPLAY_MAGIC[8] = {'A', 'L', 'R', 'E', 'P', 'L', 'A', 'Y'};
+    const uint32_t REPLAY_VERSION = 3;     // 2: incremental state hash (term sum), 3: action + speed decision codes
+
+    template <typename T>
+    void write_value(std::ostream& out, const T& value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T read_value(std::istream& in)
+    {
+        T value{};
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(T)))
+        {
+            throw std::runtime_error("Replay log is truncated");
+        }
+        return value;
+    }
+
+    /**
+     * @brief Silences std::cout for its lifetime; setup and respawns are chatty
+     */
+    class QuietCout
+    {
+    private:
+        std::ostringstream _sink;
+        std::streambuf* _original;
+
+    public:
+        QuietCout() : _original(std::cout.rdbuf(_sink.rdbuf())) {}
+        ~QuietCout() { std::cout.rdbuf(_original); }
+    };
+
+    /**
+     * @brief Runs `ticks` ticks from seed, calling on_tick(tick, entry, sim) after each one;
+     * on_tick returns false to stop early
+     */
+    template <typename OnTick>
+    double run_seeded(int ticks, uint32_t seed, OnTick on_tick)
+    {
+        std::srand(seed);
+        rng::seed(seed);
+        QuietCout quiet;
+        Simulation sim;
+        sim.initialize();
+
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 1; t <= ticks; ++t)
+        {
+            const int result = sim.tick(0);
+            uint8_t entry = static_cast<uint8_t>(sim.get_last_decision() + 1) & 0x7f;
+            if (result == -1)
+            {
+                entry |= ReplayLog::REPLAY_RESPAWNED;
+                sim.set_primary_entity_random();
+            }
+            if (!on_tick(t, entry, sim))
+            {
+                break;
+            }
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+ReplayLog record_run(int ticks, uint32_t seed, uint32_t hash_every)
+{
+    ReplayLog log;
+    log.seed = seed;
+    log.hash_every = hash_every;
+    log.ticks.reserve(static_cast<size_t>(std::max(ticks, 0)));
+    run_seeded(ticks, seed, [&](int t, uint8_t entry, const Simulation& sim)
+    {
+        log.ticks.push_back(entry);
+        if (hash_every > 0 && t % static_cast<int>(hash_every) == 0)
+        {
+            log.hashes.push_back(sim.state_hash());
+        }
+        return true;
+    });
+    return log;
+}
+
+ReplayResult verify_replay(const ReplayLog& log)
+{
+    ReplayResult result;
+    result.seconds = run_seeded(static_cast<int>(log.ticks.size()), log.seed,
+                                [&](int t, uint8_t entry, const Simulation& sim)
+    {
+        result.ticks_run = t;
+        const uint8_t expected = log.ticks[static_cast<size_t>(t - 1)];
+        if (entry != expected)
+        {
+            result.diverged_at = t;
+            result.reason = (entry & 0x7f) != (expected & 0x7f)
+                ? "decision " + std::to_string((entry & 0x7f) - 1) + ", log has " + std::to_string((expected & 0x7f) - 1)
+                : std::string((entry & ReplayLog::REPLAY_RESPAWNED) ? "entity died, log has it alive"
+                                                                   : "entity alive, log has it dying");
+            return false;
+        }
+        if (log.hash_every > 0 && t % static_cast<int>(log.hash_every) == 0)
+        {
+            const size_t index = static_cast<size_t>(t / static_cast<int>(log.hash_every)) - 1;
+            if (index < log.hashes.size() && sim.state_hash() != log.hashes[index])
+            {
+                result.diverged_at = t;
+                result.reason = "state hash differs";
+                return false;
+            }
+        }
+        return true;
+    });
+    return result;
+}
+
+void save_replay(const std::string& path, const ReplayLog& log)
+{
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            throw std::runtime_error("Cannot write replay log: " + tmp);
+        }
+        out.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+        write_value(out, REPLAY_VERSION);
+        write_value(out, log.seed);
+        write_value(out, log.hash_every);
+        write_value(out, static_cast<uint32_t>(log.ticks.size()));
+        out.write(reinterpret_cast<const char*>(log.ticks.data()), static_cast<std::streamsize>(log.ticks.size()));
+        write_value(out, static_cast<uint32_t>(log.hashes.size()));
+        out.write(reinterpret_cast<const char*>(log.hashes.data()),
+                  static_cast<std::streamsize>(log.hashes.size() * sizeof(uint64_t)));
+        out.flush();
+        if (!out)
+        {
+            throw std::runtime_error("Failed writing replay log: " + tmp);
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0)
+    {
+        throw std::runtime_error("Cannot replace replay log: " + path);
+    }
+}
+
+ReplayLog load_replay(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        throw std::runtime_error("Cannot open replay log: " + path);
+    }
+    char magic[sizeof(REPLAY_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), REPLAY_MAGIC))
+    {
+        throw std::runtime_error("Not a replay log: " + path);
+    }
+    if (read_value<uint32_t>(in) != REPLAY_VERSION)
+    {
+        throw std::runtime_error("Unsupported replay log version: " + path);
+    }
+    ReplayLog log;
+    log.seed = read_value<uint32_t>(in);
+    log.hash_every = read_value<uint32_t>(in);
+    log.ticks.resize(read_value<uint32_t>(in));
+    if (!in.read(reinterpret_cast<char*>(log.ticks.data()), static_cast<std::streamsize>(log.ticks.size())))
+    {
+        throw std::runtime_error("Replay log is truncated");
+    }
+    log.hashes.resize(read_value<uint32_t>(in));
+    if (!in.read(reinterpret_cast<char*>(log.hashes.data()),
+                 static_cast<std::streamsize>(log.hashes.size() * sizeof(uint64_t))))
+    {
+        throw std::runtime_error("Replay log is truncated");
+    }
+    return log;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ReplayLog
+ * @brief Everything needed to re-run a simulation exactly: its seed and what happened each tick
+ *
+ * One seed drives both rand() (terrain) and the rng engine (brains, genetics, resources), so
+ * the seed alone rebuilds the starting world. Each tick is one byte: the decision code plus
+ * one, with REPLAY_RESPAWNED set when the entity died and was replaced. A state hash is kept
+ * every hash_every ticks.
+ */
+struct ReplayLog
+{
+    static constexpr uint8_t REPLAY_RESPAWNED = 0x80;
+
+    uint32_t seed = 0;
+    uint32_t hash_every = 0;            // 0 = decisions only
+    std::vector<uint8_t> ticks;         // One entry per tick
+    std::vector<uint64_t> hashes;       // Simulation::state_hash() after tick hash_every, 2 * hash_every, ...
+};
+
+/**
+ * @struct ReplayResult
+ * @brief Outcome of re-running a ReplayLog
+ */
+struct ReplayResult
+{
+    int ticks_run = 0;
+    int diverged_at = -1;               // First tick (1-based) that differs, -1 if none did
+    std::string reason;
+    double seconds = 0.0;               // Tick loop only, setup excluded
+};
+
+/**
+ * @brief Runs ticks headless from seed and logs it; a dead entity is replaced by a random one
+ * so the run always does `ticks` ticks of work
+ */
+ReplayLog record_run(int ticks, uint32_t seed, uint32_t hash_every);
+
+/**
+ * @brief Re-runs a log from its seed, stopping at the first decision, respawn or hash mismatch
+ */
+ReplayResult verify_replay(const ReplayLog& log);
+
+/**
+ * @brief Writes a log as: magic, version, seed, hash_every, tick bytes, hashes (native byte order)
+ * @throws std::runtime_error if the file can't be written
+ */
+void save_replay(const std::string& path, const ReplayLog& log);
+
+/**
+ * @throws std::runtime_error if the file is missing, truncated or not a replay log
+ */
+ReplayLog load_replay(const std::string& path);
@@ -28,8 +28,11 @@ struct SimulationState {
     double averageAgentEnergy;          // Mean energy across all agents
     double averageFitness;              // Mean fitness score
     
-    // Optional: You can expand this with more detailed snapshots
-    // For now, keeping it minimal for performance
+    // Population spread — filled by one PopulationStats pass per tick
+    double minAgentEnergy, maxAgentEnergy, varAgentEnergy;
+    double averageHealth, minHealth, maxHealth, varHealth;
+    double averageWater, minWater, maxWater, varWater;
+    double minFitness, maxFitness, varFitness;
     
     SimulationState()
         : tick(0)
@@ -39,5 +42,9 @@ struct SimulationState {
         , agentCount(0)
         , averageAgentEnergy(0.0)
         , averageFitness(0.0)
+        , minAgentEnergy(0.0), maxAgentEnergy(0.0), varAgentEnergy(0.0)
+        , averageHealth(0.0), minHealth(0.0), maxHealth(0.0), varHealth(0.0)
+        , averageWater(0.0), minWater(0.0), maxWater(0.0), varWater(0.0)
+        , minFitness(0.0), maxFitness(0.0), varFitness(0.0)
     {}
 };
@@ -0,0 +1,308 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "entity/decision_center/tests/doctest.h"
+#include "evolution.h"
+#include "islands.h"
+#include "entity/decision_center/brain.hpp"
+#include "entity/decision_center/rng.hpp"
+#include "../entity/entity_cpp/fitness_calculator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    // Simulation prints every tick; the tests only care about the engine
+    struct QuietOutput
+    {
+        std::ostringstream sink;
+        std::streambuf* original = std::cout.rdbuf(sink.rdbuf());
+        ~QuietOutput() { std::cout.rdbuf(original); }
+    };
+
+    Simulation& shared_simulation()
+    {
+        static std::unique_ptr<Simulation> sim = []
+        {
+            QuietOutput quiet;
+            rng::seed(1);
+            auto s = std::make_unique<Simulation>();
+            s->initialize();
+            return s;
+        }();
+        return *sim;
+    }
+
+    EvolutionEngine make_engine(SelectionMethod method, int population, const std::vector<double>& fitness)
+    {
+        EvolutionConfig config;
+        config.population = population;
+        config.selection = method;
+        config.truncation_fraction = 0.3;
+        EvolutionEngine engine(shared_simulation(), config);
+        {
+            QuietOutput quiet;
+            engine.seed_population();
+        }
+        engine.set_fitness(fitness);
+        return engine;
+    }
+
+    std::vector<int> draw_counts(EvolutionEngine& engine, int draws)
+    {
+        std::vector<int> counts(engine.get_population().size(), 0);
+        engine.prepare_selection();
+        for (int d = 0; d < draws; ++d)
+        {
+            counts[engine.select_parent()] += 1;
+        }
+        return counts;
+    }
+}
+
+// ==================== Selection ====================
+
+TEST_SUITE("Evolution - Selection")
+{
+    TEST_CASE("Truncation only draws from the selectTopK pool")
+    {
+        rng::seed(11);
+        const std::vector<double> fitness = {5, 90, 12, 40, 3, 77, 61, 8, 20, 33};
+        EvolutionEngine engine = make_engine(SelectionMethod::TRUNCATION, 10, fitness);
+
+        const std::vector<size_t> pool = FitnessCalculator::selectTopK(fitness.data(), fitness.size(), engine.contested_count());
+        REQUIRE(pool.size() == 3);
+        const std::set<size_t> allowed(pool.begin(), pool.end());
+
+        std::vector<int> counts = draw_counts(engine, 3000);
+        for (size_t j = 0; j < counts.size(); ++j)
+        {
+            CAPTURE(j);
+            if (allowed.count(j))
+            {
+                CHECK(counts[j] > 800);     // Uniform over the pool: ~1000 each
+            }
+            else
+            {
+                CHECK(counts[j] == 0);
+            }
+        }
+    }
+
+    TEST_CASE("Rank selection follows the cumulative rank table")
+    {
+        rng::seed(12);
+        // Ranks, worst = 1: index 1 -> 1, index 3 -> 2, index 0 -> 3, index 2 -> 4
+        const std::vector<double> fitness = {30, 10, 40, 20};
+        EvolutionEngine engine = make_engine(SelectionMethod::RANK, 4, fitness);
+
+        const int draws = 40000;
+        std::vector<int> counts = draw_counts(engine, draws);
+        const double expected[] = {3.0 / 10, 1.0 / 10, 4.0 / 10, 2.0 / 10};
+        for (size_t j = 0; j < 4; ++j)
+        {
+            CAPTURE(j);
+            CHECK(static_cast<double>(counts[j]) / draws == doctest::Approx(expected[j]).epsilon(0.05));
+        }
+    }
+
+    TEST_CASE("Rank selection maps each draw through the table exactly")
+    {
+        const std::vector<double> fitness = {30, 10, 40, 20};
+        EvolutionEngine engine = make_engine(SelectionMethod::RANK, 4, fitness);
+        engine.prepare_selection();
+
+        const size_t worst_to_best[] = {1, 3, 0, 2};
+        const double cumulative[] = {1, 3, 6, 10};
+        rng::seed(13);
+        for (int d = 0; d < 200; ++d)
+        {
+            const std::string state = rng::save_state();
+            const double pick = rng::unit() * 10.0;
+            rng::load_state(state);
+            size_t r = static_cast<size_t>(std::upper_bound(std::begin(cumulative), std::end(cumulative), pick) - std::begin(cumulative));
+            CHECK(engine.select_parent() == worst_to_best[std::min<size_t>(r, 3)]);
+        }
+    }
+
+    TEST_CASE("Tournament of one is uniform whatever the scores")
+    {
+        rng::seed(14);
+        const std::vector<double> fitness = {1000, 1, 1, 1, 500};
+        EvolutionConfig config;
+        config.population = 5;
+        config.selection = SelectionMethod::TOURNAMENT;
+        config.tournament_size = 1;
+        EvolutionEngine engine(shared_simulation(), config);
+        {
+            QuietOutput quiet;
+            engine.seed_population();
+        }
+        engine.set_fitness(fitness);
+
+        const int draws = 50000;
+        std::vector<int> counts = draw_counts(engine, draws);
+        double chi_square = 0.0;
+        const double expected = draws / 5.0;
+        for (int c : counts)
+        {
+            chi_square += (c - expected) * (c - expected) / expected;
+        }
+        CHECK(chi_square < 18.47);      // 4 degrees of freedom, p = 0.001
+    }
+
+    TEST_CASE("Fitness must match the population size")
+    {
+        EvolutionEngine engine = make_engine(SelectionMethod::TRUNCATION, 4, {1, 2, 3, 4});
+        CHECK_THROWS_AS(engine.set_fitness({1, 2, 3}), std::invalid_argument);
+    }
+}
+
+// ==================== Breeding ====================
+
+TEST_SUITE("Evolution - Breeding")
+{
+    TEST_CASE("Breeding writes only the spare slots, then swaps")
+    {
+        rng::seed(15);
+        EvolutionEngine engine = make_engine(SelectionMethod::TOURNAMENT, 6, {6, 5, 4, 3, 2, 1});
+
+        std::vector<const Entity*> parents;
+        std::vector<std::vector<uint8_t>> genomes;
+        for (const auto& entity : engine.get_population())
+        {
+            parents.push_back(entity.get());
+            genomes.push_back(entity->get_brain()->serialize_genome());
+        }
+
+        {
+            QuietOutput quiet;
+            engine.breed_next_generation();
+        }
+        CHECK(engine.get_generation() == 1);
+
+        // The children live in the other slot array
+        for (const auto& child : engine.get_population())
+        {
+            CHECK(std::find(parents.begin(), parents.end(), child.get()) == parents.end());
+        }
+        // The parents are byte-for-byte what they were before breeding
+        for (size_t j = 0; j < parents.size(); ++j)
+        {
+            CAPTURE(j);
+            CHECK(parents[j]->get_brain()->serialize_genome() == genomes[j]);
+        }
+
+        // A second generation swaps back into the original objects
+        engine.set_fitness({1, 2, 3, 4, 5, 6});
+        {
+            QuietOutput quiet;
+            engine.breed_next_generation();
+        }
+        for (size_t j = 0; j < parents.size(); ++j)
+        {
+            CHECK(engine.get_population()[j].get() == parents[j]);
+        }
+    }
+}
+
+// ==================== Checkpoints ====================
+
+TEST_SUITE("Evolution - Checkpoints")
+{
+    TEST_CASE("Resume restores IDs and the ID counter")
+    {
+        rng::seed(16);
+        EvolutionEngine engine = make_engine(SelectionMethod::TRUNCATION, 4, {1, 2, 3, 4});
+        const std::string path = (std::filesystem::temp_directory_path() / "test_evolution.ckpt").string();
+        engine.save_checkpoint(path);
+        const long long next_id = Entity::next_id();
+        std::vector<long long> ids;
+        for (const auto& entity : engine.get_population())
+        {
+            ids.push_back(entity->get_id());
+        }
+
+        // Entities made after the save, or while loading, must not shift later IDs
+        Entity later_a, later_b;
+        EvolutionEngine resumed = make_engine(SelectionMethod::TRUNCATION, 2, {1, 2});
+        resumed.load_checkpoint(path);
+        std::remove(path.c_str());
+
+        CHECK(Entity::next_id() == next_id);
+        REQUIRE(resumed.get_population().size() == ids.size());
+        for (size_t j = 0; j < ids.size(); ++j)
+        {
+            CHECK(resumed.get_population()[j]->get_id() == ids[j]);
+        }
+    }
+}
+
+// ==================== Islands ====================
+
+TEST_SUITE("Evolution - Islands")
+{
+    TEST_CASE("Two-island migration leaves no duplicate IDs")
+    {
+        rng::seed(17);
+        // Each island is a fork, so both start from the same counter and keep their own copy
+        const long long forked = Entity::next_id();
+        long long counters[2];
+        std::vector<std::unique_ptr<EvolutionEngine>> islands;
+        for (int i = 0; i < 2; ++i)
+        {
+            Entity::set_next_id(forked);
+            reserve_island_ids(i);
+            islands.push_back(std::make_unique<EvolutionEngine>(make_engine(SelectionMethod::TRUNCATION, 8, {1, 2, 3, 4, 5, 6, 7, 8})));
+            counters[i] = Entity::next_id();
+        }
+
+        auto ids_of = [](const EvolutionEngine& engine)
+        {
+            std::vector<long long> ids;
+            for (const auto& entity : engine.get_population())
+            {
+                ids.push_back(entity->get_id());
+            }
+            return ids;
+        };
+        auto check_unique = [](const std::vector<long long>& ids)
+        {
+            CHECK(std::set<long long>(ids.begin(), ids.end()).size() == ids.size());
+        };
+
+        for (int generation = 0; generation < 2; ++generation)
+        {
+            CAPTURE(generation);
+            const std::string from_0 = islands[0]->encode_migrants(3);
+            const std::string from_1 = islands[1]->encode_migrants(3);
+            CHECK(islands[0]->accept_migrants(from_1) == 3);
+            CHECK(islands[1]->accept_migrants(from_0) == 3);
+            check_unique(ids_of(*islands[0]));
+            check_unique(ids_of(*islands[1]));
+
+            // Breed each island with its own counter, as its process would
+            for (int i = 0; i < 2; ++i)
+            {
+                Entity::set_next_id(counters[i]);
+                {
+                    QuietOutput quiet;
+                    islands[i]->breed_next_generation();
+                }
+                counters[i] = Entity::next_id();
+                islands[i]->set_fitness({8, 7, 6, 5, 4, 3, 2, 1});
+            }
+        }
+
+        // Every ID either island ever handed out stays unique across both
+        std::vector<long long> all = ids_of(*islands[0]);
+        const std::vector<long long> second = ids_of(*islands[1]);
+        all.insert(all.end(), second.begin(), second.end());
+        check_unique(all);
+    }
+}
@@ -0,0 +1,115 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "entity/decision_center/tests/doctest.h"
+#include "population_stats.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    // Textbook two-pass population statistics to check the single-pass sweep against
+    MetricSummary reference_summary(const std::vector<double>& values)
+    {
+        MetricSummary out;
+        if (values.empty())
+        {
+            return out;
+        }
+        double sum = 0.0;
+        for (double v : values)
+        {
+            sum += v;
+        }
+        out.mean = sum / values.size();
+        for (double v : values)
+        {
+            out.variance += (v - out.mean) * (v - out.mean);
+        }
+        out.variance /= values.size();
+        out.min = *std::min_element(values.begin(), values.end());
+        out.max = *std::max_element(values.begin(), values.end());
+        return out;
+    }
+}
+
+// ==================== summarize_column ====================
+
+TEST_SUITE("PopulationStats - summarize_column")
+{
+    TEST_CASE("Empty column is all zeros")
+    {
+        MetricSummary s = summarize_column(nullptr, 0);
+        CHECK(s.mean == 0.0);
+        CHECK(s.min == 0.0);
+        CHECK(s.max == 0.0);
+        CHECK(s.variance == 0.0);
+    }
+
+    TEST_CASE("Single value")
+    {
+        const double value = 0.37;
+        MetricSummary s = summarize_column(&value, 1);
+        CHECK(s.mean == doctest::Approx(0.37));
+        CHECK(s.min == 0.37);
+        CHECK(s.max == 0.37);
+        CHECK(s.variance == doctest::Approx(0.0));
+    }
+
+    TEST_CASE("Lengths around the four-value step match the two-pass result")
+    {
+        // 4k + 1..3 exercise the scalar tail; the extremes sit in the tail for some lengths
+        for (size_t n : {2u, 3u, 4u, 5u, 7u, 13u, 1001u, 1002u, 1003u})
+        {
+            std::vector<double> values(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                values[i] = 0.5 + 0.4 * ((i * 7919) % 101) / 101.0;
+            }
+            values[n - 1] = -2.0;         // Minimum in the last slot
+            if (n > 2)
+            {
+                values[n - 2] = 3.0;      // Maximum next to it
+            }
+            MetricSummary expected = reference_summary(values);
+            MetricSummary s = summarize_column(values.data(), n);
+            CAPTURE(n);
+            CHECK(s.mean == doctest::Approx(expected.mean).epsilon(1e-12));
+            CHECK(s.variance == doctest::Approx(expected.variance).epsilon(1e-12));
+            CHECK(s.min == expected.min);
+            CHECK(s.max == expected.max);
+        }
+    }
+
+    TEST_CASE("Small spread around a large mean keeps its variance")
+    {
+        std::vector<double> values = {1e9 + 1.0, 1e9 + 2.0, 1e9 + 3.0, 1e9 + 4.0, 1e9 + 5.0};
+        MetricSummary s = summarize_column(values.data(), values.size());
+        CHECK(s.mean == doctest::Approx(1e9 + 3.0));
+        CHECK(s.variance == doctest::Approx(2.0));
+    }
+}
+
+// ==================== summarize_population ====================
+
+TEST_SUITE("PopulationStats - summarize_population")
+{
+    TEST_CASE("Every borrowed column is summarized")
+    {
+        std::vector<double> energy = {0.1, 0.2, 0.3};
+        std::vector<double> health = {1.0, 1.0, 1.0};
+        std::vector<double> water = {0.0, 0.5, 1.0};
+        std::vector<double> fitness = {10.0, 20.0, 30.0};
+        PopulationColumns columns;
+        columns.energy = energy.data();
+        columns.health = health.data();
+        columns.water = water.data();
+        columns.fitness = fitness.data();
+        columns.count = 3;
+
+        PopulationStats stats = summarize_population(columns);
+        CHECK(stats.count == 3);
+        CHECK(stats.energy.mean == doctest::Approx(0.2));
+        CHECK(stats.health.variance == doctest::Approx(0.0));
+        CHECK(stats.water.max == 1.0);
+        CHECK(stats.fitness.min == 10.0);
+    }
+}
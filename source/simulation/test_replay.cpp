@@ -0,0 +1,121 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "entity/decision_center/tests/doctest.h"
+#include "replay.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    const int TICKS = 400;
+    const uint32_t HASH_EVERY = 10;
+
+    // Recording is the slow part, so every case checks the same run
+    const ReplayLog& recorded()
+    {
+        static const ReplayLog log = record_run(TICKS, 31, HASH_EVERY);
+        return log;
+    }
+
+    std::string temp_path(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+}
+
+// ==================== Round trip ====================
+
+TEST_SUITE("Replay - Round trip")
+{
+    TEST_CASE("A recorded run has one entry per tick and one hash per interval")
+    {
+        const ReplayLog& log = recorded();
+        CHECK(log.seed == 31);
+        CHECK(log.ticks.size() == static_cast<size_t>(TICKS));
+        CHECK(log.hashes.size() == static_cast<size_t>(TICKS / HASH_EVERY));
+    }
+
+    TEST_CASE("Record, save, load and verify")
+    {
+        const std::string path = temp_path("test_replay_round_trip.rpl");
+        save_replay(path, recorded());
+        const ReplayLog loaded = load_replay(path);
+        std::remove(path.c_str());
+
+        CHECK(loaded.seed == recorded().seed);
+        CHECK(loaded.hash_every == recorded().hash_every);
+        CHECK(loaded.ticks == recorded().ticks);
+        CHECK(loaded.hashes == recorded().hashes);
+
+        const ReplayResult result = verify_replay(loaded);
+        CHECK(result.diverged_at == -1);
+        CHECK(result.ticks_run == TICKS);
+        CHECK(result.reason.empty());
+    }
+
+    TEST_CASE("Missing and foreign files throw")
+    {
+        CHECK_THROWS_AS(load_replay(temp_path("test_replay_missing.rpl")), std::runtime_error);
+
+        const std::string path = temp_path("test_replay_foreign.rpl");
+        {
+            std::ofstream out(path, std::ios::binary);
+            out << "definitely not a replay";
+        }
+        CHECK_THROWS_AS(load_replay(path), std::runtime_error);
+        std::remove(path.c_str());
+    }
+}
+
+// ==================== Tampering ====================
+
+TEST_SUITE("Replay - Tampering")
+{
+    TEST_CASE("A changed decision diverges at its tick")
+    {
+        ReplayLog log = recorded();
+        log.ticks[136] ^= 0x01;                 // Tick 137
+        const ReplayResult result = verify_replay(log);
+        CHECK(result.diverged_at == 137);
+        CHECK(result.ticks_run == 137);
+        CHECK(result.reason.find("decision") == 0);
+    }
+
+    TEST_CASE("A flipped respawn flag diverges at its tick")
+    {
+        ReplayLog log = recorded();
+        log.ticks[49] ^= ReplayLog::REPLAY_RESPAWNED;      // Tick 50
+        const ReplayResult result = verify_replay(log);
+        CHECK(result.diverged_at == 50);
+        CHECK(result.reason.find("entity") == 0);
+    }
+
+    TEST_CASE("A changed hash diverges at the tick it was taken")
+    {
+        ReplayLog log = recorded();
+        log.hashes[7] += 1;                     // Taken after tick 80
+        const ReplayResult result = verify_replay(log);
+        CHECK(result.diverged_at == 80);
+        CHECK(result.reason == "state hash differs");
+    }
+
+    TEST_CASE("A byte changed on disk diverges at its tick")
+    {
+        const std::string path = temp_path("test_replay_tampered.rpl");
+        save_replay(path, recorded());
+        {
+            // Header: magic, version, seed, hash_every, tick count; then one byte per tick
+            const std::streamoff tick_bytes = 8 + 4 * sizeof(uint32_t);
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(tick_bytes + 299);      // Tick 300
+            file.put(static_cast<char>(recorded().ticks[299] ^ 0x02));
+        }
+        const ReplayLog loaded = load_replay(path);
+        std::remove(path.c_str());
+
+        const ReplayResult result = verify_replay(loaded);
+        CHECK(result.diverged_at == 300);
+    }
+}
@@ -0,0 +1,109 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "entity/decision_center/tests/doctest.h"
+#include "Simulation.hpp"
+#include "entity/decision_center/rng.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    // Simulation prints every tick; the tests only care about its state
+    struct QuietOutput
+    {
+        std::ostringstream sink;
+        std::streambuf* original = std::cout.rdbuf(sink.rdbuf());
+        ~QuietOutput() { std::cout.rdbuf(original); }
+    };
+}
+
+// ==================== Decisions ====================
+
+TEST_SUITE("Simulation - Decisions")
+{
+    TEST_CASE("Empty outputs decode to -1")
+    {
+        CHECK(Simulation::decode_decision({}) == -1);
+    }
+
+    TEST_CASE("Legacy 6-output brains keep the original action order at speed 1")
+    {
+        const int expected[] = {Simulation::MOVE_UP, Simulation::MOVE_DOWN, Simulation::MOVE_LEFT,
+                                Simulation::MOVE_RIGHT, Simulation::STAY_STILL, Simulation::CONSUME};
+        for (int winner = 0; winner < Simulation::LEGACY_BRAIN_OUTPUTS; ++winner)
+        {
+            CAPTURE(winner);
+            std::vector<double> outputs(Simulation::LEGACY_BRAIN_OUTPUTS, 0.1);
+            outputs[winner] = 0.9;
+            const int code = Simulation::decode_decision(outputs);
+            CHECK(code == expected[winner]);
+            CHECK(Simulation::decision_speed(code) == 1);
+        }
+    }
+
+    TEST_CASE("Full brains read the action and speed heads separately")
+    {
+        for (int action = 0; action < Simulation::ACTION_COUNT; ++action)
+        {
+            for (int speed = 1; speed <= Movement::MAX_SPEED; ++speed)
+            {
+                CAPTURE(action);
+                CAPTURE(speed);
+                std::vector<double> outputs(Simulation::BRAIN_OUTPUTS, 0.0);
+                outputs[action] = 1.0;
+                outputs[Simulation::ACTION_COUNT + speed - 1] = 2.0;     // Higher than any action logit
+                const int code = Simulation::decode_decision(outputs);
+                const bool stationary = action == Simulation::STAY_STILL || action == Simulation::CONSUME;
+                CHECK(Simulation::decision_action(code) == action);
+                CHECK(Simulation::decision_speed(code) == (stationary ? 1 : speed));
+            }
+        }
+    }
+
+    TEST_CASE("Unknown widths fall back to argmax over the action head")
+    {
+        std::vector<double> outputs(4, 0.0);
+        outputs[Simulation::MOVE_RIGHT] = 1.0;
+        CHECK(Simulation::decode_decision(outputs) == Simulation::MOVE_RIGHT);
+
+        std::vector<double> wide(Simulation::ACTION_COUNT + 1, 0.0);
+        wide[Simulation::ACTION_COUNT] = 1.0;          // Past the action head
+        CHECK(Simulation::decode_decision(wide) == Simulation::STAY_STILL);
+    }
+}
+
+// ==================== State hash ====================
+
+TEST_SUITE("Simulation - State hash")
+{
+    TEST_CASE("The incremental hash matches a full recompute every tick")
+    {
+        QuietOutput quiet;
+        std::srand(21);
+        rng::seed(21);
+        Simulation sim;
+        sim.initialize();
+        REQUIRE(sim.state_hash() == sim.recompute_state_hash());
+
+        int respawns = 0;
+        int reseeds = 0;
+        for (int t = 1; t <= 1500; ++t)
+        {
+            if (sim.tick(0) == -1)
+            {
+                sim.set_primary_entity_random();
+                ++respawns;
+            }
+            if (t % 250 == 0)
+            {
+                sim.seed_resources();
+                ++reseeds;
+            }
+            CAPTURE(t);
+            REQUIRE(sim.state_hash() == sim.recompute_state_hash());
+        }
+        CHECK(respawns > 0);
+        CHECK(reseeds == 6);
+    }
+}
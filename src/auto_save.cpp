@@ -41,7 +41,7 @@ void AutoSave::configure(const AutoSaveConfig& cfg) {
 }
 
 void AutoSave::loadConfig() {
-    PGResultGuard r(db().execParams(
+    PGResultGuard r(db()->execPrepared("as_load_config",
         "SELECT interval_ticks, max_auto_saves, enabled, "
         "       slot_prefix, last_auto_save_tick "
         "FROM   auto_save_config ORDER BY id LIMIT 1",
@@ -58,7 +58,7 @@ void AutoSave::loadConfig() {
 }
 
 void AutoSave::persistConfig() const {
-    PGResultGuard r(db().execParams(
+    PGResultGuard r(db()->execPrepared("as_update_config",
         "UPDATE auto_save_config "
         "SET interval_ticks      = $1, "
         "    max_auto_saves      = $2, "
@@ -77,7 +77,7 @@ void AutoSave::persistConfig() const {
 
     // If the update touched 0 rows the table was empty — insert a fresh row
     if (string(PQcmdTuples(r)) == "0") {
-        PGResultGuard ins(db().execParams(
+        PGResultGuard ins(db()->execPrepared("as_insert_config",
             "INSERT INTO auto_save_config "
             "(interval_ticks, max_auto_saves, enabled, slot_prefix, last_auto_save_tick) "
             "VALUES ($1,$2,$3,$4,$5)",
@@ -155,7 +155,7 @@ int AutoSave::doSave(const SimulationSavePayload& payload) {
 void AutoSave::pruneOldAutoSaves() {
     // Delete anything beyond the N most-recent auto-saves
     // (rotation reuses slot names so this is mostly a safety net)
-    PGResultGuard r(db().execParams(
+    PGResultGuard r(db()->execPrepared("as_prune",
         "DELETE FROM simulation_saves "
         "WHERE  is_auto_save = TRUE "
         "  AND  id NOT IN ( "
@@ -169,7 +169,7 @@ void AutoSave::pruneOldAutoSaves() {
 }
 
 void AutoSave::clearAllAutoSaves() {
-    PGResultGuard r(db().execParams(
+    PGResultGuard r(db()->execPrepared("as_clear_all",
         "DELETE FROM simulation_saves WHERE is_auto_save = TRUE",
         {}
     ));
@@ -9,6 +9,7 @@
 #include <fstream>
 #include <sstream>
 #include <cstdlib>
+#include <algorithm>
 
 using namespace std;
 
@@ -30,6 +31,17 @@ static string envOr(const char* varName, const string& fallback) {
     return (val && *val) ? string(val) : fallback;  // Use env var if set, else default
 }
 
+static int envIntOr(const char* varName, int fallback) {
+    const char* val = getenv(varName);
+    if (!val || !*val) return fallback;
+    try {
+        int v = stoi(val);
+        return v > 0 ? v : fallback;    // Ignore zero / negative sizes
+    } catch (const exception&) {
+        return fallback;
+    }
+}
+
 DBConnectionParams DBConnectionParams::fromEnv() {
     DBConnectionParams p;
     p.host     = envOr("ALIFE_DB_HOST", p.host);
@@ -37,6 +49,8 @@ DBConnectionParams DBConnectionParams::fromEnv() {
     p.dbname   = envOr("ALIFE_DB_NAME", p.dbname);
     p.user     = envOr("ALIFE_DB_USER", p.user);
     p.password = envOr("ALIFE_DB_PASS", p.password);
+    p.poolSize      = envIntOr("ALIFE_DB_POOL_SIZE",      p.poolSize);
+    p.pipelineDepth = envIntOr("ALIFE_DB_PIPELINE_DEPTH", p.pipelineDepth);
     return p;
 }
 
@@ -54,6 +68,13 @@ DBConnector::DBConnector(const string& connectionString)
     connect();
 }
 
+DBConnector::DBConnector(const DBConnectionParams& params, const string& connectionString)
+    : m_params(params)
+    , m_connStr(connectionString)
+{
+    connect();
+}
+
 DBConnector::~DBConnector() {
     if (m_conn) {
         PQfinish(m_conn);
@@ -65,17 +86,29 @@ DBConnector::DBConnector(DBConnector&& o) noexcept
     : m_conn(o.m_conn)
     , m_params(move(o.m_params))
     , m_connStr(move(o.m_connStr))
+    , m_inPipeline(o.m_inPipeline)
+    , m_broken(o.m_broken)
+    , m_pipelineQueue(move(o.m_pipelineQueue))
+    , m_prepared(move(o.m_prepared))
+    , m_preparePending(move(o.m_preparePending))
 {
-    o.m_conn = nullptr;
+    o.m_conn       = nullptr;
+    o.m_inPipeline = false;
 }
 
 DBConnector& DBConnector::operator=(DBConnector&& o) noexcept {
     if (this != &o) {
         if (m_conn) PQfinish(m_conn);
-        m_conn    = o.m_conn;
-        m_params  = move(o.m_params);
-        m_connStr = move(o.m_connStr);
-        o.m_conn  = nullptr;
+        m_conn            = o.m_conn;
+        m_params          = move(o.m_params);
+        m_connStr         = move(o.m_connStr);
+        m_inPipeline     = o.m_inPipeline;
+        m_broken         = o.m_broken;
+        m_pipelineQueue  = move(o.m_pipelineQueue);
+        m_prepared       = move(o.m_prepared);
+        m_preparePending = move(o.m_preparePending);
+        o.m_conn       = nullptr;
+        o.m_inPipeline = false;
     }
     return *this;
 }
@@ -94,10 +127,15 @@ bool DBConnector::isConnected() const {
 }
 
 void DBConnector::reconnect() {
+    m_inPipeline = false;       // A reset connection always comes back out of pipeline mode
+    m_pipelineQueue.clear();
+    m_prepared.clear();         // Prepared statements die with the old session
+    m_preparePending.clear();
     if (!m_conn) { connect(); return; }
     PQreset(m_conn);   // libpq built-in reconnect
     if (PQstatus(m_conn) != CONNECTION_OK)
         throw DBConnectionError(PQerrorMessage(m_conn));
+    m_broken = false;
 }
 
 // Validates a PGresult*, throws on error and cleans up
@@ -156,15 +194,249 @@ PGresult* DBConnector::execParamsBinary(const string& sql,
     return res;
 }
 
+// ---------------------------------------------------------------
+// Prepared statements
+// ---------------------------------------------------------------
+
+void DBConnector::prepare(const string& name, const string& sql) {
+    if (m_prepared.count(name)) return;
+    // nParams = 0 / null types — the server infers parameter types from the SQL
+    PGresult* res = PQprepare(m_conn, name.c_str(), sql.c_str(), 0, nullptr);
+    checkResult(res, "prepare " + name);
+    PQclear(res);
+    m_prepared.insert(name);
+}
+
+PGresult* DBConnector::runPrepared(const string& name, const string& sql, int nParams,
+                                   const char* const* paramValues, const int* paramLengths,
+                                   const int* paramFormats) {
+    if (!isConnected()) reconnect();
+    prepare(name, sql);
+
+    PGresult* res = PQexecPrepared(m_conn, name.c_str(), nParams,
+                                   paramValues, paramLengths, paramFormats, 0);
+
+    // Statement vanished server-side (e.g. DISCARD ALL) — re-prepare once and retry.
+    // Inside a transaction the failure has already aborted it, so a retry can't succeed:
+    // report the original error and let the caller roll back.
+    const char* state = res ? PQresultErrorField(res, PG_DIAG_SQLSTATE) : nullptr;
+    if (state && string(state) == "26000") {
+        m_prepared.erase(name);     // Prepare again next time either way
+    }
+    if (state && string(state) == "26000" && PQtransactionStatus(m_conn) != PQTRANS_INERROR) {
+        PQclear(res);
+        prepare(name, sql);
+        res = PQexecPrepared(m_conn, name.c_str(), nParams,
+                             paramValues, paramLengths, paramFormats, 0);
+    }
+
+    checkResult(res, name);
+    return res;
+}
+
+PGresult* DBConnector::execPrepared(const string& name, const string& sql,
+                                    const vector<string>& params) {
+    vector<const char*> vals;
+    vals.reserve(params.size());
+    for (const auto& p : params) vals.push_back(p.c_str());
+    return runPrepared(name, sql, static_cast<int>(vals.size()), vals.data(), nullptr, nullptr);
+}
+
+PGresult* DBConnector::execPreparedBinary(const string& name,
+                                          const string& sql,
+                                          int nParams,
+                                          const char* const* paramValues,
+                                          const int* paramLengths,
+                                          const int* paramFormats) {
+    return runPrepared(name, sql, nParams, paramValues, paramLengths, paramFormats);
+}
+
 void DBConnector::beginTransaction()    { PGResultGuard g(exec("BEGIN")); }
 void DBConnector::commitTransaction()   { PGResultGuard g(exec("COMMIT")); }
 
 void DBConnector::rollbackTransaction() {
     // Best-effort — don't throw if rollback itself fails
+    if (m_inPipeline) abortPipeline();
     PGresult* res = PQexec(m_conn, "ROLLBACK");
     if (res) PQclear(res);
 }
 
+// ---------------------------------------------------------------
+// Pipeline mode
+// ---------------------------------------------------------------
+
+void DBConnector::beginPipeline() {
+    if (m_inPipeline) return;
+    if (!isConnected()) reconnect();
+#ifdef LIBPQ_HAS_PIPELINING
+    if (PQenterPipelineMode(m_conn) != 1)
+        throw DBQueryError(string("beginPipeline: ") + PQerrorMessage(m_conn));
+#endif
+    m_inPipeline = true;
+    m_pipelineQueue.clear();
+    m_preparePending.clear();
+}
+
+void DBConnector::queueParams(const string& sql, const vector<string>& params) {
+    if (!m_inPipeline) { PGResultGuard g(execParams(sql, params)); return; }
+
+#ifdef LIBPQ_HAS_PIPELINING
+    vector<const char*> vals;
+    vals.reserve(params.size());
+    for (const auto& p : params) vals.push_back(p.c_str());
+
+    // libpq copies the parameters into its send buffer, callers can free theirs right away
+    if (!PQsendQueryParams(m_conn, sql.c_str(), static_cast<int>(vals.size()),
+                           nullptr, vals.data(), nullptr, nullptr, 0))
+        throw DBQueryError(sql.substr(0, 80) + ": " + PQerrorMessage(m_conn));
+    afterQueue();
+#else
+    PGResultGuard g(execParams(sql, params));
+#endif
+}
+
+void DBConnector::queueParamsBinary(const string& sql,
+                                    int nParams,
+                                    const char* const* paramValues,
+                                    const int* paramLengths,
+                                    const int* paramFormats) {
+    if (!m_inPipeline) {
+        PGResultGuard g(execParamsBinary(sql, nParams, paramValues, paramLengths, paramFormats));
+        return;
+    }
+
+#ifdef LIBPQ_HAS_PIPELINING
+    if (!PQsendQueryParams(m_conn, sql.c_str(), nParams,
+                           nullptr, paramValues, paramLengths, paramFormats, 0))
+        throw DBQueryError(sql.substr(0, 80) + ": " + PQerrorMessage(m_conn));
+    afterQueue();
+#else
+    PGResultGuard g(execParamsBinary(sql, nParams, paramValues, paramLengths, paramFormats));
+#endif
+}
+
+void DBConnector::queuePrepare(const string& name, const string& sql) {
+    if (m_prepared.count(name) || m_preparePending.count(name)) return;
+#ifdef LIBPQ_HAS_PIPELINING
+    if (!PQsendPrepare(m_conn, name.c_str(), sql.c_str(), 0, nullptr))
+        throw DBQueryError("prepare " + name + ": " + PQerrorMessage(m_conn));
+    m_preparePending.insert(name);
+    afterQueue(name);   // Only marked prepared once the sync confirms it
+#endif
+}
+
+void DBConnector::queuePrepared(const string& name, const string& sql,
+                                const vector<string>& params) {
+    if (!m_inPipeline) { PGResultGuard g(execPrepared(name, sql, params)); return; }
+
+#ifdef LIBPQ_HAS_PIPELINING
+    vector<const char*> vals;
+    vals.reserve(params.size());
+    for (const auto& p : params) vals.push_back(p.c_str());
+    queuePreparedBinary(name, sql, static_cast<int>(vals.size()), vals.data(), nullptr, nullptr);
+#else
+    PGResultGuard g(execPrepared(name, sql, params));
+#endif
+}
+
+void DBConnector::queuePreparedBinary(const string& name,
+                                      const string& sql,
+                                      int nParams,
+                                      const char* const* paramValues,
+                                      const int* paramLengths,
+                                      const int* paramFormats) {
+    if (!m_inPipeline) {
+        PGResultGuard g(execPreparedBinary(name, sql, nParams, paramValues, paramLengths, paramFormats));
+        return;
+    }
+
+#ifdef LIBPQ_HAS_PIPELINING
+    queuePrepare(name, sql);
+    // A prepare queued ahead of us in the same pipeline is guaranteed to run first
+    if (!PQsendQueryPrepared(m_conn, name.c_str(), nParams,
+                             paramValues, paramLengths, paramFormats, 0))
+        throw DBQueryError(name + ": " + PQerrorMessage(m_conn));
+    afterQueue();
+#else
+    PGResultGuard g(execPreparedBinary(name, sql, nParams, paramValues, paramLengths, paramFormats));
+#endif
+}
+
+// Bound the number of unread results so neither side blocks on a full socket buffer
+void DBConnector::afterQueue(const string& preparedName) {
+    m_pipelineQueue.push_back(preparedName);
+    if (static_cast<int>(m_pipelineQueue.size()) >= max(1, m_params.pipelineDepth))
+        syncPipeline();
+}
+
+void DBConnector::syncPipeline() {
+    if (!m_inPipeline) return;
+#ifdef LIBPQ_HAS_PIPELINING
+    if (PQpipelineSync(m_conn) != 1)
+        throw DBQueryError(string("syncPipeline: ") + PQerrorMessage(m_conn));
+
+    // Each queued statement yields its result(s) followed by a NULL,
+    // then the sync point itself. Keep the first error, drain the rest.
+    string firstError;
+    vector<string> queued;
+    queued.swap(m_pipelineQueue);
+    m_preparePending.clear();
+
+    for (const string& preparedName : queued) {
+        while (PGresult* res = PQgetResult(m_conn)) {
+            ExecStatusType status = PQresultStatus(res);
+            bool ok = status == PGRES_COMMAND_OK || status == PGRES_TUPLES_OK;
+            if (ok && !preparedName.empty())
+                m_prepared.insert(preparedName);
+            if (!ok && firstError.empty())
+                firstError = status == PGRES_PIPELINE_ABORTED
+                           ? string("statement skipped after earlier failure")
+                           : string(PQresultErrorMessage(res));
+            PQclear(res);
+        }
+    }
+
+    PGResultGuard sync(PQgetResult(m_conn));
+    if (!sync.res || PQresultStatus(sync.res) != PGRES_PIPELINE_SYNC) {
+        if (firstError.empty()) firstError = "lost pipeline sync";
+    }
+
+    if (!firstError.empty())
+        throw DBQueryError("pipeline: " + firstError);
+#endif
+}
+
+void DBConnector::endPipeline() {
+    if (!m_inPipeline) return;
+    syncPipeline();
+#ifdef LIBPQ_HAS_PIPELINING
+    if (PQexitPipelineMode(m_conn) != 1)
+        throw DBQueryError(string("endPipeline: ") + PQerrorMessage(m_conn));
+#endif
+    m_inPipeline = false;
+}
+
+void DBConnector::abortPipeline() {
+    if (!m_inPipeline) return;
+    try {
+        syncPipeline();     // Drains whatever is still in flight
+    } catch (...) {
+        // Already failing — the caller is about to roll back anyway
+    }
+#ifdef LIBPQ_HAS_PIPELINING
+    if (m_conn && PQexitPipelineMode(m_conn) != 1) {
+        try {
+            reconnect();    // Couldn't leave cleanly, start over with a fresh session
+        } catch (const DBConnectionError&) {
+            m_broken = true;    // Server gone — callers run this from destructors, so don't throw
+        }
+    }
+#endif
+    m_inPipeline = false;
+    m_pipelineQueue.clear();
+    m_preparePending.clear();
+}
+
 void DBConnector::applySchema(const string& schemaSql) {
     PGResultGuard g(exec(schemaSql));
 }
@@ -177,3 +449,85 @@ void DBConnector::applySchemaFile(const string& filePath) {
     ss << file.rdbuf();
     applySchema(ss.str());
 }
+
+// ---------------------------------------------------------------
+// DBConnectionPool
+// ---------------------------------------------------------------
+
+DBConnectionPool::DBConnectionPool(const DBConnectionParams& params)
+    : m_params(params)
+    , m_connStr(params.toConnectionString())
+    , m_capacity(static_cast<size_t>(max(1, params.poolSize)))
+{
+    // Open the first connection eagerly so a bad config fails at startup, not mid-run
+    auto first = make_shared<DBConnector>(m_params);
+    m_all.push_back(first);
+    m_idle.push_back(first);
+}
+
+DBConnectionPool::DBConnectionPool(shared_ptr<DBConnector> single)
+    : m_capacity(1)
+{
+    if (!single) throw invalid_argument("DBConnectionPool: null DBConnector");
+    m_params  = single->params();             // A replacement for it reopens the same way
+    m_connStr = single->connectionString();
+    m_all.push_back(single);
+    m_idle.push_back(single);
+}
+
+DBConnectionPool::Lease DBConnectionPool::acquire() {
+    unique_lock<mutex> lock(m_mutex);
+    while (true) {
+        if (!m_idle.empty()) {
+            shared_ptr<DBConnector> conn = move(m_idle.back());
+            m_idle.pop_back();
+            return Lease(this, move(conn));
+        }
+
+        if (m_all.size() + m_opening < m_capacity) {
+            // Grow lazily — open outside the lock so other leases aren't held up by the handshake
+            ++m_opening;
+            lock.unlock();
+            shared_ptr<DBConnector> conn;
+            try {
+                conn = make_shared<DBConnector>(m_params, m_connStr);
+            } catch (...) {
+                lock.lock();
+                --m_opening;
+                m_cv.notify_one();  // Let a waiter retry the slot we failed to fill
+                throw;
+            }
+            lock.lock();
+            --m_opening;
+            m_all.push_back(conn);
+            return Lease(this, move(conn));
+        }
+
+        m_cv.wait(lock);
+    }
+}
+
+size_t DBConnectionPool::openCount() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_all.size();
+}
+
+void DBConnectionPool::giveBack(shared_ptr<DBConnector> conn) {
+    if (conn->inPipeline()) conn->abortPipeline();  // Never hand out a half-used pipeline
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (conn->isBroken()) {
+            // Free its slot; the next acquire() opens a fresh connection in its place
+            m_all.erase(remove(m_all.begin(), m_all.end(), conn), m_all.end());
+        } else {
+            m_idle.push_back(move(conn));
+        }
+    }
+    m_cv.notify_one();
+}
+
+void DBConnectionPool::Lease::release() {
+    if (m_pool && m_conn) m_pool->giveBack(move(m_conn));
+    m_pool = nullptr;
+    m_conn.reset();
+}
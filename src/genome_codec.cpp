@@ -0,0 +1,335 @@
+#include "../include/genome_codec.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef ALIFE_USE_ZLIB
+  #include <zlib.h>
+#endif
+#ifdef ALIFE_USE_ZSTD
+  #include <zstd.h>
+  #include <zdict.h>
+#endif
+
+using namespace std;
+
+// ---------------------------------------------------------------
+// Shared helpers
+// ---------------------------------------------------------------
+
+// Pick the median-length sample — siblings share most of their bytes with it
+static const vector<uint8_t>* representativeSample(const vector<const vector<uint8_t>*>& samples) {
+    vector<const vector<uint8_t>*> usable;
+    for (const auto* s : samples)
+        if (s && !s->empty()) usable.push_back(s);
+    if (usable.empty()) return nullptr;
+
+    auto mid = usable.begin() + usable.size() / 2;
+    nth_element(usable.begin(), mid, usable.end(),
+                [](const vector<uint8_t>* a, const vector<uint8_t>* b) { return a->size() < b->size(); });
+    return *mid;
+}
+
+// Default "training": the leading bytes of one representative genome.
+// Genomes are inherited, so offset i of a child lines up with offset i of the dictionary.
+vector<uint8_t> GenomeCodec::trainDictionary(const vector<const vector<uint8_t>*>& samples,
+                                             size_t maxBytes) const {
+    if (samples.size() < kMinDictSamples) return {};
+    if (maxBytes == 0) maxBytes = 32768;
+    const vector<uint8_t>* rep = representativeSample(samples);
+    if (!rep) return {};
+    size_t n = min(maxBytes, rep->size());
+    return vector<uint8_t>(rep->begin(), rep->begin() + static_cast<ptrdiff_t>(n));
+}
+
+vector<vector<uint8_t>> GenomeCodec::compressBatch(const vector<const vector<uint8_t>*>& genomes) {
+    vector<vector<uint8_t>> out;
+    out.reserve(genomes.size());
+    for (const auto* g : genomes) {
+        if (!g || g->empty()) out.emplace_back();
+        else                  out.push_back(compress(g->data(), g->size()));
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------
+// None — passthrough, used when no compression library is built in
+// ---------------------------------------------------------------
+
+namespace {
+
+class RawGenomeCodec : public GenomeCodec {
+public:
+    GenomeCodecType type() const override { return GenomeCodecType::None; }
+
+    vector<uint8_t> trainDictionary(const vector<const vector<uint8_t>*>&, size_t) const override {
+        return {};
+    }
+
+    vector<uint8_t> compress(const uint8_t* data, size_t len) override {
+        return vector<uint8_t>(data, data + len);
+    }
+
+    vector<uint8_t> decompress(const uint8_t* data, size_t len, size_t rawLen) override {
+        if (rawLen && rawLen != len)
+            throw GenomeCodecError("raw blob is " + to_string(len) + " bytes, expected " + to_string(rawLen));
+        return vector<uint8_t>(data, data + len);
+    }
+};
+
+// ---------------------------------------------------------------
+// zlib — one deflate/inflate stream reset between genomes
+// ---------------------------------------------------------------
+
+#ifdef ALIFE_USE_ZLIB
+class ZlibGenomeCodec : public GenomeCodec {
+public:
+    explicit ZlibGenomeCodec(int level) : m_level(level > 0 ? min(level, 9) : Z_BEST_SPEED) {}
+
+    ~ZlibGenomeCodec() override {
+        if (m_deflateReady) deflateEnd(&m_def);
+        if (m_inflateReady) inflateEnd(&m_inf);
+    }
+
+    GenomeCodecType type() const override { return GenomeCodecType::Zlib; }
+
+    // Deflate can only reach 32 KiB back, so a longer dictionary is wasted
+    vector<uint8_t> trainDictionary(const vector<const vector<uint8_t>*>& samples,
+                                    size_t maxBytes) const override {
+        return GenomeCodec::trainDictionary(samples, maxBytes ? min<size_t>(maxBytes, 32768) : 32768);
+    }
+
+    vector<uint8_t> compress(const uint8_t* data, size_t len) override {
+        if (len == 0) return {};
+
+        int rc = m_deflateReady ? deflateReset(&m_def) : deflateInit(&m_def, m_level);
+        if (rc != Z_OK) throw GenomeCodecError("deflate init failed (" + to_string(rc) + ")");
+        m_deflateReady = true;
+
+        if (!m_dict.empty()) {
+            rc = deflateSetDictionary(&m_def, m_dict.data(), static_cast<uInt>(m_dict.size()));
+            if (rc != Z_OK) throw GenomeCodecError("deflateSetDictionary failed (" + to_string(rc) + ")");
+        }
+
+        vector<uint8_t> out(deflateBound(&m_def, static_cast<uLong>(len)));
+        m_def.next_in   = const_cast<Bytef*>(data);
+        m_def.avail_in  = static_cast<uInt>(len);
+        m_def.next_out  = out.data();
+        m_def.avail_out = static_cast<uInt>(out.size());
+
+        rc = deflate(&m_def, Z_FINISH);     // deflateBound guarantees one pass
+        if (rc != Z_STREAM_END) throw GenomeCodecError("deflate failed (" + to_string(rc) + ")");
+
+        out.resize(m_def.total_out);
+        return out;
+    }
+
+    vector<uint8_t> decompress(const uint8_t* data, size_t len, size_t rawLen) override {
+        if (len == 0) return {};
+
+        int rc = m_inflateReady ? inflateReset(&m_inf) : inflateInit(&m_inf);
+        if (rc != Z_OK) throw GenomeCodecError("inflate init failed (" + to_string(rc) + ")");
+        m_inflateReady = true;
+
+        // Known size decodes in one pass; otherwise keep the stream going and grow the tail
+        vector<uint8_t> out(rawLen ? rawLen : max<size_t>(len * 4, 64));
+        m_inf.next_in  = const_cast<Bytef*>(data);
+        m_inf.avail_in = static_cast<uInt>(len);
+
+        while (true) {
+            m_inf.next_out  = out.data() + m_inf.total_out;
+            m_inf.avail_out = static_cast<uInt>(out.size() - m_inf.total_out);
+
+            rc = inflate(&m_inf, Z_NO_FLUSH);
+            if (rc == Z_STREAM_END) break;
+
+            if (rc == Z_NEED_DICT) {
+                if (m_dict.empty()) throw GenomeCodecError("blob needs a dictionary, none set");
+                rc = inflateSetDictionary(&m_inf, m_dict.data(), static_cast<uInt>(m_dict.size()));
+                if (rc != Z_OK) throw GenomeCodecError("dictionary mismatch (" + to_string(rc) + ")");
+                continue;
+            }
+
+            bool outputFull = m_inf.avail_out == 0;
+            if ((rc == Z_OK || rc == Z_BUF_ERROR) && outputFull) {
+                out.resize(out.size() * 2);
+                continue;
+            }
+            throw GenomeCodecError(rc == Z_BUF_ERROR ? string("truncated zlib blob")
+                                                     : "inflate failed (" + to_string(rc) + ")");
+        }
+
+        out.resize(m_inf.total_out);
+        if (rawLen && out.size() != rawLen)
+            throw GenomeCodecError("inflated " + to_string(out.size()) + " bytes, expected " + to_string(rawLen));
+        return out;
+    }
+
+private:
+    int      m_level;
+    z_stream m_def{};
+    z_stream m_inf{};
+    bool     m_deflateReady = false;
+    bool     m_inflateReady = false;
+};
+#endif
+
+// ---------------------------------------------------------------
+// zstd — reusable contexts plus digested (C/D)Dict for the shared dictionary
+// ---------------------------------------------------------------
+
+#ifdef ALIFE_USE_ZSTD
+class ZstdGenomeCodec : public GenomeCodec {
+public:
+    explicit ZstdGenomeCodec(int level)
+        : m_level(level > 0 ? level : 1)
+        , m_cctx(ZSTD_createCCtx())
+        , m_dctx(ZSTD_createDCtx())
+    {
+        if (!m_cctx || !m_dctx) throw GenomeCodecError("zstd context allocation failed");
+    }
+
+    ~ZstdGenomeCodec() override {
+        ZSTD_freeCDict(m_cdict);
+        ZSTD_freeDDict(m_ddict);
+        ZSTD_freeCCtx(m_cctx);
+        ZSTD_freeDCtx(m_dctx);
+    }
+
+    GenomeCodecType type() const override { return GenomeCodecType::Zstd; }
+
+    // A whole genome used raw is the best dictionary there is — children compress down
+    // to their mutations. It has to stay inside the level-1 match window (512 KiB).
+    // Bigger genomes fall back to ZDICT picking the segments that recur most.
+    static constexpr size_t kMaxRawDictBytes = size_t(1) << 19;
+    static constexpr size_t kTrainedDictBytes = 112640;         // zstd's recommended 110 KiB
+    static constexpr size_t kMaxTrainingBytes = size_t(8) << 20; // Bounds ZDICT's run time
+
+    vector<uint8_t> trainDictionary(const vector<const vector<uint8_t>*>& samples,
+                                    size_t maxBytes) const override {
+        if (samples.size() < kMinDictSamples) return {};
+        const vector<uint8_t>* rep = representativeSample(samples);
+        if (!rep) return {};
+        if (rep->size() <= (maxBytes ? maxBytes : kMaxRawDictBytes))
+            return GenomeCodec::trainDictionary(samples, rep->size());
+
+        if (maxBytes == 0) maxBytes = kTrainedDictBytes;
+        vector<uint8_t> flat;
+        vector<size_t>  sizes;
+        for (const auto* s : samples) {
+            if (!s || s->empty()) continue;
+            if (flat.size() + s->size() > kMaxTrainingBytes && !sizes.empty()) break;
+            flat.insert(flat.end(), s->begin(), s->end());
+            sizes.push_back(s->size());
+        }
+
+        vector<uint8_t> dict(maxBytes);
+        size_t n = ZDICT_trainFromBuffer(dict.data(), dict.size(), flat.data(),
+                                         sizes.data(), static_cast<unsigned>(sizes.size()));
+        if (ZDICT_isError(n))
+            return GenomeCodec::trainDictionary(samples, maxBytes);  // Too few samples to train on
+        dict.resize(n);
+        return dict;
+    }
+
+    void setDictionary(const vector<uint8_t>& dict) override {
+        GenomeCodec::setDictionary(dict);
+        ZSTD_freeCDict(m_cdict);
+        ZSTD_freeDDict(m_ddict);
+        m_cdict = nullptr;
+        m_ddict = nullptr;
+        if (m_dict.empty()) return;
+
+        // Digest once — reused for every genome in the batch
+        m_cdict = ZSTD_createCDict(m_dict.data(), m_dict.size(), m_level);
+        m_ddict = ZSTD_createDDict(m_dict.data(), m_dict.size());
+        if (!m_cdict || !m_ddict) throw GenomeCodecError("zstd dictionary load failed");
+    }
+
+    vector<uint8_t> compress(const uint8_t* data, size_t len) override {
+        if (len == 0) return {};
+        vector<uint8_t> out(ZSTD_compressBound(len));
+        size_t n = m_cdict
+            ? ZSTD_compress_usingCDict(m_cctx, out.data(), out.size(), data, len, m_cdict)
+            : ZSTD_compressCCtx(m_cctx, out.data(), out.size(), data, len, m_level);
+        if (ZSTD_isError(n)) throw GenomeCodecError(string("zstd compress: ") + ZSTD_getErrorName(n));
+        out.resize(n);
+        return out;
+    }
+
+    vector<uint8_t> decompress(const uint8_t* data, size_t len, size_t rawLen) override {
+        if (len == 0) return {};
+        if (rawLen == 0) {
+            unsigned long long framed = ZSTD_getFrameContentSize(data, len);
+            if (framed == ZSTD_CONTENTSIZE_ERROR || framed == ZSTD_CONTENTSIZE_UNKNOWN)
+                throw GenomeCodecError("zstd blob has no size and none was stored");
+            rawLen = static_cast<size_t>(framed);
+        }
+
+        vector<uint8_t> out(rawLen);
+        size_t n = m_ddict
+            ? ZSTD_decompress_usingDDict(m_dctx, out.data(), out.size(), data, len, m_ddict)
+            : ZSTD_decompressDCtx(m_dctx, out.data(), out.size(), data, len);
+        if (ZSTD_isError(n)) throw GenomeCodecError(string("zstd decompress: ") + ZSTD_getErrorName(n));
+        if (n != rawLen)
+            throw GenomeCodecError("zstd produced " + to_string(n) + " bytes, expected " + to_string(rawLen));
+        return out;
+    }
+
+private:
+    int         m_level;
+    ZSTD_CCtx*  m_cctx  = nullptr;
+    ZSTD_DCtx*  m_dctx  = nullptr;
+    ZSTD_CDict* m_cdict = nullptr;
+    ZSTD_DDict* m_ddict = nullptr;
+};
+#endif
+
+} // namespace
+
+// ---------------------------------------------------------------
+// Factory
+// ---------------------------------------------------------------
+
+bool GenomeCodec::isAvailable(GenomeCodecType type) {
+    switch (type) {
+        case GenomeCodecType::None: return true;
+#ifdef ALIFE_USE_ZLIB
+        case GenomeCodecType::Zlib: return true;
+#endif
+#ifdef ALIFE_USE_ZSTD
+        case GenomeCodecType::Zstd: return true;
+#endif
+        default: return false;
+    }
+}
+
+GenomeCodecType GenomeCodec::bestAvailable() {
+    if (isAvailable(GenomeCodecType::Zstd)) return GenomeCodecType::Zstd;
+    if (isAvailable(GenomeCodecType::Zlib)) return GenomeCodecType::Zlib;
+    return GenomeCodecType::None;
+}
+
+const char* GenomeCodec::name(GenomeCodecType type) {
+    switch (type) {
+        case GenomeCodecType::None: return "none";
+        case GenomeCodecType::Zlib: return "zlib";
+        case GenomeCodecType::Zstd: return "zstd";
+        default:                    return "unknown";
+    }
+}
+
+unique_ptr<GenomeCodec> GenomeCodec::create(GenomeCodecType type, int level) {
+    switch (type) {
+        case GenomeCodecType::None: return make_unique<RawGenomeCodec>();
+#ifdef ALIFE_USE_ZLIB
+        case GenomeCodecType::Zlib: return make_unique<ZlibGenomeCodec>(level);
+#endif
+#ifdef ALIFE_USE_ZSTD
+        case GenomeCodecType::Zstd: return make_unique<ZstdGenomeCodec>(level);
+#endif
+        default:
+            (void)level;
+            throw GenomeCodecError(string(name(type)) + " codec not compiled into this build");
+    }
+}
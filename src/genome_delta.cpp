@@ -0,0 +1,107 @@
+#include "../include/genome_delta.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+using namespace std;
+
+static void putVarint(vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+static uint64_t getVarint(const uint8_t*& p, const uint8_t* end) {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p >= end) throw GenomeCodecError("genome delta truncated in varint");
+        uint8_t b = *p++;
+        v |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    throw GenomeCodecError("genome delta varint too long");
+}
+
+vector<uint8_t> GenomeDelta::encode(const vector<uint8_t>& parent,
+                                    const vector<uint8_t>& child,
+                                    size_t maxBytes) {
+    const size_t words       = child.size() / kWordBytes;
+    const size_t parentWords = parent.size() / kWordBytes;
+
+    // Changed words go to a scratch buffer first — their count sits ahead of them in the header
+    vector<uint8_t> body;
+    uint64_t changed = 0;
+    size_t   last    = 0;   // index + 1 of the previous changed word
+
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t c;
+        memcpy(&c, child.data() + i * kWordBytes, kWordBytes);
+        if (i < parentWords) {
+            uint64_t p;
+            memcpy(&p, parent.data() + i * kWordBytes, kWordBytes);
+            if (p == c) continue;
+        }
+
+        putVarint(body, i - last);
+        body.insert(body.end(), child.data() + i * kWordBytes, child.data() + (i + 1) * kWordBytes);
+        last = i + 1;
+        ++changed;
+
+        if (body.size() >= maxBytes) return {};     // Already no smaller than the full genome
+    }
+
+    vector<uint8_t> out;
+    out.reserve(body.size() + 24);
+    out.push_back(kVersion);
+    putVarint(out, child.size());
+    putVarint(out, changed);
+    out.insert(out.end(), body.begin(), body.end());
+    out.insert(out.end(), child.begin() + static_cast<ptrdiff_t>(words * kWordBytes), child.end());
+
+    if (out.size() >= maxBytes) return {};
+    return out;
+}
+
+vector<uint8_t> GenomeDelta::apply(const vector<uint8_t>& parent, const vector<uint8_t>& delta) {
+    const uint8_t* p   = delta.data();
+    const uint8_t* end = delta.data() + delta.size();
+
+    if (p >= end || *p++ != kVersion)
+        throw GenomeCodecError("genome delta has unknown version");
+
+    uint64_t childLen = getVarint(p, end);
+    uint64_t changed  = getVarint(p, end);
+
+    // Every child byte past the parent arrives in a changed word or the tail, so a length
+    // beyond that is a corrupt header — reject it before it sizes the allocation
+    if (changed > static_cast<uint64_t>(end - p) / kWordBytes)
+        throw GenomeCodecError("genome delta claims " + to_string(changed) + " changed words in "
+                               + to_string(end - p) + " bytes");
+    if (childLen > parent.size() + changed * kWordBytes + childLen % kWordBytes)
+        throw GenomeCodecError("genome delta child length " + to_string(childLen) + " exceeds parent plus changes");
+    const size_t words = static_cast<size_t>(childLen / kWordBytes);
+
+    // Start from the parent, truncated or zero-padded to the child's length
+    vector<uint8_t> child(static_cast<size_t>(childLen), 0);
+    if (!parent.empty())
+        memcpy(child.data(), parent.data(), min(parent.size(), child.size()));
+
+    size_t next = 0;
+    for (uint64_t k = 0; k < changed; ++k) {
+        size_t i = next + static_cast<size_t>(getVarint(p, end));
+        if (i >= words || static_cast<size_t>(end - p) < kWordBytes)
+            throw GenomeCodecError("genome delta word " + to_string(i) + " out of range");
+        memcpy(child.data() + i * kWordBytes, p, kWordBytes);
+        p   += kWordBytes;
+        next = i + 1;
+    }
+
+    size_t tail = static_cast<size_t>(childLen) - words * kWordBytes;
+    if (static_cast<size_t>(end - p) != tail)
+        throw GenomeCodecError("genome delta tail is " + to_string(end - p) + " bytes, expected " + to_string(tail));
+    memcpy(child.data() + words * kWordBytes, p, tail);
+    return child;
+}
@@ -0,0 +1,550 @@
+#include "../include/history_store.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+// ---------------------------------------------------------------
+// Column layout — one entry per SimulationState field, in block order.
+// Adding a field here is all it takes to store it.
+// ---------------------------------------------------------------
+
+namespace {
+
+enum class ColumnKind : uint8_t { Int, Float };
+
+struct ColumnSpec {
+    const char* name;
+    ColumnKind  kind;
+    size_t      offset;
+    size_t      width;      // Bytes — ints are zero-extended to 64 bits
+};
+
+const ColumnSpec kColumns[] = {
+    { "tick",             ColumnKind::Int,   offsetof(SimulationState, tick),               8 },
+    { "timestamp",        ColumnKind::Float, offsetof(SimulationState, timestamp),          8 },
+    { "total_energy",     ColumnKind::Float, offsetof(SimulationState, totalEnergy),        8 },
+    { "total_resources",  ColumnKind::Int,   offsetof(SimulationState, totalResources),     4 },
+    { "agent_count",      ColumnKind::Int,   offsetof(SimulationState, agentCount),         4 },
+    { "avg_agent_energy", ColumnKind::Float, offsetof(SimulationState, averageAgentEnergy), 8 },
+    { "avg_fitness",      ColumnKind::Float, offsetof(SimulationState, averageFitness),     8 },
+    // Version 2 — population spread
+    { "min_agent_energy", ColumnKind::Float, offsetof(SimulationState, minAgentEnergy),     8 },
+    { "max_agent_energy", ColumnKind::Float, offsetof(SimulationState, maxAgentEnergy),     8 },
+    { "var_agent_energy", ColumnKind::Float, offsetof(SimulationState, varAgentEnergy),     8 },
+    { "avg_health",       ColumnKind::Float, offsetof(SimulationState, averageHealth),      8 },
+    { "min_health",       ColumnKind::Float, offsetof(SimulationState, minHealth),          8 },
+    { "max_health",       ColumnKind::Float, offsetof(SimulationState, maxHealth),          8 },
+    { "var_health",       ColumnKind::Float, offsetof(SimulationState, varHealth),          8 },
+    { "avg_water",        ColumnKind::Float, offsetof(SimulationState, averageWater),       8 },
+    { "min_water",        ColumnKind::Float, offsetof(SimulationState, minWater),           8 },
+    { "max_water",        ColumnKind::Float, offsetof(SimulationState, maxWater),           8 },
+    { "var_water",        ColumnKind::Float, offsetof(SimulationState, varWater),           8 },
+    { "min_fitness",      ColumnKind::Float, offsetof(SimulationState, minFitness),         8 },
+    { "max_fitness",      ColumnKind::Float, offsetof(SimulationState, maxFitness),         8 },
+    { "var_fitness",      ColumnKind::Float, offsetof(SimulationState, varFitness),         8 },
+};
+constexpr size_t kColumnCount = sizeof(kColumns) / sizeof(kColumns[0]);
+constexpr size_t kTickColumn  = 0;
+
+// Column holding each HistoryMetric
+constexpr size_t kMetricColumn[kHistoryMetricCount] = { 2, 3, 4, 5, 6, 10, 14 };
+
+constexpr uint8_t kBlockMagic   = 'H';
+constexpr uint8_t kBlockVersion = 2;
+constexpr size_t  kV1Columns    = 7;    // Version 1 blocks stop at avg_fitness
+
+uint64_t readRaw(const SimulationState& s, const ColumnSpec& c) {
+    uint64_t v = 0;
+    if (c.kind == ColumnKind::Float) {
+        memcpy(&v, reinterpret_cast<const char*>(&s) + c.offset, 8);
+    } else if (c.width == 8) {
+        memcpy(&v, reinterpret_cast<const char*>(&s) + c.offset, 8);
+    } else {
+        uint32_t v32;
+        memcpy(&v32, reinterpret_cast<const char*>(&s) + c.offset, 4);
+        v = v32;
+    }
+    return v;
+}
+
+void writeRaw(SimulationState& s, const ColumnSpec& c, uint64_t v) {
+    if (c.width == 8) {
+        memcpy(reinterpret_cast<char*>(&s) + c.offset, &v, 8);
+    } else {
+        uint32_t v32 = static_cast<uint32_t>(v);
+        memcpy(reinterpret_cast<char*>(&s) + c.offset, &v32, 4);
+    }
+}
+
+double asDouble(const ColumnSpec& c, uint64_t raw) {
+    if (c.kind == ColumnKind::Int) return static_cast<double>(raw);
+    double d;
+    memcpy(&d, &raw, 8);
+    return d;
+}
+
+double metricValue(const SimulationState& s, size_t metric) {
+    const ColumnSpec& c = kColumns[kMetricColumn[metric]];
+    return asDouble(c, readRaw(s, c));
+}
+
+inline int clz64(uint64_t x) { return x ? __builtin_clzll(x) : 64; }
+inline int ctz64(uint64_t x) { return x ? __builtin_ctzll(x) : 64; }
+
+inline uint64_t zigzag(int64_t v)    { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+inline int64_t  unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+// MSB-first bit reader over one column's bytes
+struct BitReader {
+    const uint8_t* data;
+    size_t         len;
+    size_t         bit = 0;
+
+    uint64_t get(int n) {
+        uint64_t v = 0;
+        while (n > 0) {
+            size_t byte = bit >> 3;
+            if (byte >= len) throw runtime_error("HistoryStore: column truncated");
+            int avail = 8 - static_cast<int>(bit & 7);
+            int take  = min(n, avail);
+            uint64_t chunk = (data[byte] >> (avail - take)) & ((1u << take) - 1);
+            v = (v << take) | chunk;
+            bit += static_cast<size_t>(take);
+            n   -= take;
+        }
+        return v;
+    }
+};
+
+} // namespace
+
+// ---------------------------------------------------------------
+// Bit packing
+// ---------------------------------------------------------------
+
+template<typename W>
+static void putBits(W& w, uint64_t v, int n) {
+    while (n > 0) {
+        if (w.bitsFree == 0) { w.bytes.push_back(0); w.bitsFree = 8; }
+        int take = min(n, w.bitsFree);
+        uint64_t chunk = (v >> (n - take)) & ((1u << take) - 1);
+        w.bytes.back() |= static_cast<uint8_t>(chunk << (w.bitsFree - take));
+        w.bitsFree -= take;
+        n          -= take;
+    }
+}
+
+// 6-bit length then the significant bits — used for non-zero delta-of-deltas
+template<typename W>
+static void putVarBits(W& w, uint64_t u) {
+    int n = max(1, 64 - clz64(u));
+    putBits(w, static_cast<uint64_t>(n - 1), 6);
+    putBits(w, u, n);
+}
+
+static uint64_t getVarBits(BitReader& r) {
+    int n = static_cast<int>(r.get(6)) + 1;
+    return r.get(n);
+}
+
+// ---------------------------------------------------------------
+// Construction / push
+// ---------------------------------------------------------------
+
+HistoryStore::HistoryStore(size_t hotCapacity, size_t blockTicks)
+    : m_hot(hotCapacity)
+    , m_blockTicks(blockTicks)
+{
+    if (blockTicks == 0) throw invalid_argument("HistoryStore block size must be > 0");
+    resetBlock(m_open);
+}
+
+void HistoryStore::resetBlock(Block& b) const {
+    b = Block{};
+    b.columns.assign(kColumnCount, ColumnWriter{});
+}
+
+void HistoryStore::clear() {
+    m_hot.clear();
+    m_sealed.clear();
+    resetBlock(m_open);
+    for (auto& level : m_rollups) level.clear();
+    m_pending.fill(Rollup{});
+    m_total     = 0;
+    m_firstTick = 0;
+    m_lastTick  = 0;
+}
+
+void HistoryStore::push(const SimulationState& s) {
+    if (m_total > 0 && s.tick <= m_lastTick)
+        throw invalid_argument("HistoryStore: tick " + to_string(s.tick) +
+                               " not after " + to_string(m_lastTick));
+
+    m_hot.push(s);
+    if (m_total == 0) m_firstTick = s.tick;
+    m_lastTick = s.tick;
+    ++m_total;
+
+    appendToBlock(m_open, s);
+    if (m_open.count == m_blockTicks) {
+        m_sealed.push_back(move(m_open));
+        resetBlock(m_open);
+    }
+
+    Rollup raw;
+    raw.firstTick = raw.lastTick = s.tick;
+    raw.ticks = 1;
+    for (size_t m = 0; m < kHistoryMetricCount; ++m)
+        raw.min[m] = raw.max[m] = raw.sum[m] = metricValue(s, m);
+    foldRollup(1, raw);
+}
+
+// Fold one finished point of level-1 into level's open bucket, cascading up when it fills
+void HistoryStore::foldRollup(size_t level, const Rollup& child) {
+    Rollup& p = m_pending[level];
+    if (p.children == 0) {
+        p = child;
+    } else {
+        p.lastTick = child.lastTick;
+        p.ticks   += child.ticks;
+        for (size_t m = 0; m < kHistoryMetricCount; ++m) {
+            p.min[m]  = min(p.min[m], child.min[m]);
+            p.max[m]  = max(p.max[m], child.max[m]);
+            p.sum[m] += child.sum[m];
+        }
+    }
+    p.children++;
+
+    if (p.children < kRollupFactor) return;
+    Rollup done = p;
+    done.children = 0;
+    m_rollups[level].push_back(done);
+    p = Rollup{};
+    if (level + 1 < kLevels) foldRollup(level + 1, done);
+}
+
+// Append one row to every column — constant work per column
+void HistoryStore::appendToBlock(Block& b, const SimulationState& s) {
+    if (b.count == 0) b.firstTick = s.tick;
+    b.lastTick = s.tick;
+
+    for (size_t c = 0; c < kColumnCount; ++c) {
+        ColumnWriter& w = b.columns[c];
+        uint64_t raw = readRaw(s, kColumns[c]);
+
+        if (b.count == 0) {
+            putBits(w, raw, 64);
+        } else if (kColumns[c].kind == ColumnKind::Int) {
+            // Delta-of-delta: steady ticks / flat counts cost one bit
+            int64_t delta = static_cast<int64_t>(raw - w.prev);
+            int64_t dod   = delta - w.prevDelta;
+            if (dod == 0) {
+                putBits(w, 0, 1);
+            } else {
+                putBits(w, 1, 1);
+                putVarBits(w, zigzag(dod));
+            }
+            w.prevDelta = delta;
+        } else {
+            // XOR with the previous double, store only the meaningful window
+            uint64_t x = raw ^ w.prev;
+            if (x == 0) {
+                putBits(w, 0, 1);
+            } else {
+                int lead  = clz64(x);
+                int trail = ctz64(x);
+                putBits(w, 1, 1);
+                if (w.prevLead >= 0 && lead >= w.prevLead && trail >= w.prevTrail) {
+                    putBits(w, 0, 1);
+                    putBits(w, x >> w.prevTrail, 64 - w.prevLead - w.prevTrail);
+                } else {
+                    int sig = 64 - lead - trail;
+                    putBits(w, 1, 1);
+                    putBits(w, static_cast<uint64_t>(lead), 6);
+                    putBits(w, static_cast<uint64_t>(sig - 1), 6);
+                    putBits(w, x >> trail, sig);
+                    w.prevLead  = lead;
+                    w.prevTrail = trail;
+                }
+            }
+        }
+        w.prev = raw;
+    }
+    b.count++;
+}
+
+// ---------------------------------------------------------------
+// Decoding
+// ---------------------------------------------------------------
+
+static vector<uint64_t> decodeColumn(const vector<uint8_t>& bytes, ColumnKind kind, uint32_t count) {
+    vector<uint64_t> out;
+    out.reserve(count);
+    if (count == 0) return out;
+
+    BitReader r{bytes.data(), bytes.size()};
+    uint64_t prev = r.get(64);
+    out.push_back(prev);
+
+    int64_t prevDelta = 0;
+    int     lead = 0, trail = 0;
+    for (uint32_t i = 1; i < count; ++i) {
+        if (kind == ColumnKind::Int) {
+            int64_t dod = r.get(1) ? unzigzag(getVarBits(r)) : 0;
+            prevDelta  += dod;
+            prev       += static_cast<uint64_t>(prevDelta);
+        } else if (r.get(1)) {
+            if (r.get(1)) {
+                lead  = static_cast<int>(r.get(6));
+                int sig = static_cast<int>(r.get(6)) + 1;
+                trail = 64 - lead - sig;
+            }
+            prev ^= r.get(64 - lead - trail) << trail;
+        }
+        out.push_back(prev);
+    }
+    return out;
+}
+
+vector<SimulationState> HistoryStore::decodeRows(const Block& b) {
+    vector<SimulationState> rows(b.count);
+    for (size_t c = 0; c < b.columns.size(); ++c) {      // Older blocks may have fewer
+        vector<uint64_t> col = decodeColumn(b.columns[c].bytes, kColumns[c].kind, b.count);
+        for (uint32_t i = 0; i < b.count; ++i) writeRaw(rows[i], kColumns[c], col[i]);
+    }
+    return rows;
+}
+
+// Only the tick column and the requested metric — the rest stay packed
+vector<double> HistoryStore::decodeMetric(const Block& b, HistoryMetric metric, vector<uint64_t>& ticks) {
+    const ColumnSpec& spec = kColumns[kMetricColumn[static_cast<size_t>(metric)]];
+    ticks = decodeColumn(b.columns[kTickColumn].bytes, ColumnKind::Int, b.count);
+    vector<uint64_t> raw = decodeColumn(b.columns[kMetricColumn[static_cast<size_t>(metric)]].bytes,
+                                        spec.kind, b.count);
+    vector<double> out(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i) out[i] = asDouble(spec, raw[i]);
+    return out;
+}
+
+// ---------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------
+
+vector<SimulationState> HistoryStore::range(uint64_t fromTick, uint64_t toTick) const {
+    vector<SimulationState> out;
+    if (m_total == 0 || fromTick > toTick) return out;
+
+    // Hot ring covers it — no decoding at all
+    if (!m_hot.empty() && fromTick >= m_hot.get(0).tick) {
+        for (size_t i = 0; i < m_hot.size(); ++i) {
+            const SimulationState& s = m_hot.get(i);
+            if (s.tick > toTick) break;
+            if (s.tick >= fromTick) out.push_back(s);
+        }
+        return out;
+    }
+
+    auto emit = [&](const Block& b) {
+        if (b.count == 0 || b.lastTick < fromTick || b.firstTick > toTick) return;
+        for (const SimulationState& s : decodeRows(b))
+            if (s.tick >= fromTick && s.tick <= toTick) out.push_back(s);
+    };
+
+    auto first = lower_bound(m_sealed.begin(), m_sealed.end(), fromTick,
+                             [](const Block& b, uint64_t t) { return b.lastTick < t; });
+    for (auto it = first; it != m_sealed.end() && it->firstTick <= toTick; ++it) emit(*it);
+    emit(m_open);
+    return out;
+}
+
+size_t HistoryStore::levelFor(uint64_t fromTick, uint64_t toTick, size_t maxPoints) const {
+    if (m_total < 2 || maxPoints == 0) return 0;
+    uint64_t lo = max(fromTick, m_firstTick);
+    uint64_t hi = min(toTick,   m_lastTick);
+    if (lo > hi) return 0;
+
+    // Estimate raw points from the average tick stride
+    double stride = static_cast<double>(m_lastTick - m_firstTick) / static_cast<double>(m_total - 1);
+    double points = static_cast<double>(hi - lo) / max(stride, 1.0) + 1.0;
+
+    size_t level = 0;
+    while (level + 1 < kLevels && points > static_cast<double>(maxPoints)) {
+        points /= static_cast<double>(kRollupFactor);
+        ++level;
+    }
+    return level;
+}
+
+vector<HistorySample> HistoryStore::query(HistoryMetric metric, uint64_t fromTick, uint64_t toTick,
+                                          size_t maxPoints) const {
+    vector<HistorySample> out;
+    if (m_total == 0 || fromTick > toTick) return out;
+    size_t m     = static_cast<size_t>(metric);
+    size_t level = levelFor(fromTick, toTick, maxPoints);
+
+    if (level == 0) {
+        auto emit = [&](uint64_t tick, double v) {
+            HistorySample p;
+            p.firstTick = p.lastTick = tick;
+            p.ticks = 1;
+            p.min = p.max = p.mean = v;
+            out.push_back(p);
+        };
+
+        if (!m_hot.empty() && fromTick >= m_hot.get(0).tick) {
+            for (size_t i = 0; i < m_hot.size(); ++i) {
+                const SimulationState& s = m_hot.get(i);
+                if (s.tick > toTick) break;
+                if (s.tick >= fromTick) emit(s.tick, metricValue(s, m));
+            }
+            return out;
+        }
+
+        auto scan = [&](const Block& b) {
+            if (b.count == 0 || b.lastTick < fromTick || b.firstTick > toTick) return;
+            vector<uint64_t> ticks;
+            vector<double> values = decodeMetric(b, metric, ticks);
+            for (size_t i = 0; i < ticks.size(); ++i)
+                if (ticks[i] >= fromTick && ticks[i] <= toTick) emit(ticks[i], values[i]);
+        };
+        auto first = lower_bound(m_sealed.begin(), m_sealed.end(), fromTick,
+                                 [](const Block& b, uint64_t t) { return b.lastTick < t; });
+        for (auto it = first; it != m_sealed.end() && it->firstTick <= toTick; ++it) scan(*it);
+        scan(m_open);
+        return out;
+    }
+
+    // Rollup level — closed buckets, then the still-filling one so recent ticks show up.
+    // Buckets straddling the range edges are returned whole.
+    auto emit = [&](const Rollup& r) {
+        if (r.ticks == 0 || r.lastTick < fromTick || r.firstTick > toTick) return;
+        HistorySample p;
+        p.firstTick = r.firstTick;
+        p.lastTick  = r.lastTick;
+        p.ticks     = r.ticks;
+        p.min       = r.min[m];
+        p.max       = r.max[m];
+        p.mean      = r.sum[m] / r.ticks;
+        out.push_back(p);
+    };
+
+    const vector<Rollup>& points = m_rollups[level];
+    auto first = lower_bound(points.begin(), points.end(), fromTick,
+                             [](const Rollup& r, uint64_t t) { return r.lastTick < t; });
+    for (auto it = first; it != points.end() && it->firstTick <= toTick; ++it) emit(*it);
+
+    // The open bucket at this level only holds finished children, add the partial ones below it
+    Rollup tail = m_pending[level];
+    for (size_t below = level - 1; below >= 1; --below) {
+        const Rollup& p = m_pending[below];
+        if (p.ticks == 0) continue;
+        if (tail.ticks == 0) { tail = p; continue; }
+        tail.lastTick = p.lastTick;
+        tail.ticks   += p.ticks;
+        for (size_t k = 0; k < kHistoryMetricCount; ++k) {
+            tail.min[k]  = min(tail.min[k], p.min[k]);
+            tail.max[k]  = max(tail.max[k], p.max[k]);
+            tail.sum[k] += p.sum[k];
+        }
+    }
+    emit(tail);
+    return out;
+}
+
+// ---------------------------------------------------------------
+// Block serialization
+//   'H', version, u32 count, u64 firstTick, u64 lastTick, u8 columns,
+//   then per column: u32 byte length + packed bits
+// ---------------------------------------------------------------
+
+static void putLE(vector<uint8_t>& out, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+static uint64_t getLE(const vector<uint8_t>& in, size_t& pos, int bytes) {
+    if (pos + static_cast<size_t>(bytes) > in.size())
+        throw runtime_error("HistoryStore: block header truncated");
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= static_cast<uint64_t>(in[pos + i]) << (8 * i);
+    pos += static_cast<size_t>(bytes);
+    return v;
+}
+
+size_t HistoryStore::blockCount() const {
+    return m_sealed.size() + (m_open.count > 0 ? 1 : 0);
+}
+
+size_t HistoryStore::compressedBytes() const {
+    size_t n = 0;
+    for (const auto& b : m_sealed)
+        for (const auto& c : b.columns) n += c.bytes.size();
+    for (const auto& c : m_open.columns) n += c.bytes.size();
+    return n;
+}
+
+vector<uint8_t> HistoryStore::encode(const Block& b) {
+    vector<uint8_t> out;
+    out.push_back(kBlockMagic);
+    out.push_back(kBlockVersion);
+    putLE(out, b.count, 4);
+    putLE(out, b.firstTick, 8);
+    putLE(out, b.lastTick, 8);
+    out.push_back(static_cast<uint8_t>(b.columns.size()));
+    for (const auto& c : b.columns) {
+        putLE(out, c.bytes.size(), 4);
+        out.insert(out.end(), c.bytes.begin(), c.bytes.end());
+    }
+    return out;
+}
+
+const HistoryStore::Block& HistoryStore::blockAt(size_t index) const {
+    if (index < m_sealed.size()) return m_sealed[index];
+    if (index == m_sealed.size() && m_open.count > 0) return m_open;
+    throw out_of_range("HistoryStore block index out of range");
+}
+
+vector<uint8_t> HistoryStore::encodedBlock(size_t index) const {
+    return encode(blockAt(index));
+}
+
+void HistoryStore::blockBounds(size_t index, uint64_t& firstTick, uint64_t& lastTick,
+                               uint32_t& count) const {
+    const Block& b = blockAt(index);
+    firstTick = b.firstTick;
+    lastTick  = b.lastTick;
+    count     = b.count;
+}
+
+vector<SimulationState> HistoryStore::decodeBlock(const vector<uint8_t>& bytes) {
+    size_t pos = 0;
+    if (getLE(bytes, pos, 1) != kBlockMagic)
+        throw runtime_error("HistoryStore: not a history block");
+    uint64_t version = getLE(bytes, pos, 1);
+    if (version != 1 && version != kBlockVersion)
+        throw runtime_error("HistoryStore: unknown block version " + to_string(version));
+
+    Block b;
+    b.count     = static_cast<uint32_t>(getLE(bytes, pos, 4));
+    b.firstTick = getLE(bytes, pos, 8);
+    b.lastTick  = getLE(bytes, pos, 8);
+    size_t columns = static_cast<size_t>(getLE(bytes, pos, 1));
+    size_t expected = version == 1 ? kV1Columns : kColumnCount;
+    if (columns != expected)
+        throw runtime_error("HistoryStore: block has " + to_string(columns) +
+                            " columns, expected " + to_string(expected));
+
+    b.columns.resize(columns);
+    for (auto& c : b.columns) {
+        size_t len = static_cast<size_t>(getLE(bytes, pos, 4));
+        if (pos + len > bytes.size()) throw runtime_error("HistoryStore: column truncated");
+        c.bytes.assign(bytes.begin() + static_cast<ptrdiff_t>(pos),
+                       bytes.begin() + static_cast<ptrdiff_t>(pos + len));
+        pos += len;
+    }
+    return decodeRows(b);
+}
@@ -11,49 +11,50 @@
 #include <sstream>
 #include <algorithm>
 #include <cassert>
-
-#ifdef ALIFE_USE_ZLIB
-  #include <zlib.h>
-#endif
+#include <unordered_map>
 
 using namespace std;
 
+// Hot statements go through DBConnector::execPrepared / queuePrepared under a
+// fixed "sm_*" name, so each pooled connection parses and plans them once.
+static const char* kDeleteSlotSql = "DELETE FROM simulation_saves WHERE slot_name = $1";
+
 SaveManager::SaveManager(shared_ptr<DBConnector> db)
-    : m_db(move(db))
 {
-    if (!m_db) throw invalid_argument("SaveManager: null DBConnector");
+    if (!db) throw invalid_argument("SaveManager: null DBConnector");
+    m_pool = make_shared<DBConnectionPool>(move(db));
+}
+
+SaveManager::SaveManager(shared_ptr<DBConnectionPool> pool)
+    : m_pool(move(pool))
+{
+    if (!m_pool) throw invalid_argument("SaveManager: null DBConnectionPool");
 }
 
 void SaveManager::initSchema(const string& schemaFilePath) {
-    m_db->applySchemaFile(schemaFilePath);
+    auto db = m_pool->acquire();
+    db->applySchemaFile(schemaFilePath);
 }
 
 bool SaveManager::compressionEnabled() {
-#ifdef ALIFE_USE_ZLIB
-    return true;
-#else
-    return false;
-#endif
+    return GenomeCodec::bestAvailable() != GenomeCodecType::None;
+}
+
+void SaveManager::setFullGenomeInterval(uint32_t generations) {
+    m_fullGenomeEvery = generations;
+}
+
+void SaveManager::setGenomeCodec(GenomeCodecType type, int level) {
+    if (!GenomeCodec::isAvailable(type))
+        throw invalid_argument(string("SaveManager: ") + GenomeCodec::name(type) + " codec not compiled in");
+    m_codecType  = type;
+    m_codecLevel = level;
 }
 
 vector<uint8_t> SaveManager::compressBytes(const vector<uint8_t>& data) {
     if (data.empty()) return {};
-
 #ifdef ALIFE_USE_ZLIB
-    uLongf destLen = compressBound(static_cast<uLong>(data.size()));  // zlib upper-bound
-    vector<uint8_t> out(destLen);
-
-    int rc = compress2(
-        out.data(), &destLen,
-        reinterpret_cast<const Bytef*>(data.data()),
-        static_cast<uLong>(data.size()),
-        Z_BEST_COMPRESSION
-    );
-    if (rc != Z_OK)
-        throw runtime_error("SaveManager::compressBytes: zlib error " + to_string(rc));
-
-    out.resize(destLen);
-    return out;
+    return GenomeCodec::create(GenomeCodecType::Zlib)->compress(data);
 #else
     return data;  // No zlib — store uncompressed
 #endif
@@ -62,31 +63,11 @@ vector<uint8_t> SaveManager::compressBytes(const vector<uint8_t>& data) {
 vector<uint8_t> SaveManager::decompressBytes(const vector<uint8_t>& data,
                                                size_t expectedUncompressedSize) {
     if (data.empty()) return {};
-
 #ifdef ALIFE_USE_ZLIB
-    // Start at the hint size, or 4x compressed size if no hint was given
-    uLongf destLen = static_cast<uLongf>(
-        expectedUncompressedSize > 0 ? expectedUncompressedSize : data.size() * 4);
-
-    vector<uint8_t> out;
-    while (true) {
-        out.resize(destLen);
-        int rc = uncompress(
-            out.data(), &destLen,
-            reinterpret_cast<const Bytef*>(data.data()),
-            static_cast<uLong>(data.size())
-        );
-        if (rc == Z_OK) {
-            out.resize(destLen);
-            return out;
-        } else if (rc == Z_BUF_ERROR) {
-            destLen *= 2;   // Buffer too small — double and retry
-        } else {
-            throw runtime_error("SaveManager::decompressBytes: zlib error " +
-                                to_string(rc));
-        }
-    }
+    // Streams into a growing buffer when there's no size hint
+    return GenomeCodec::create(GenomeCodecType::Zlib)->decompress(data, expectedUncompressedSize);
 #else
+    (void)expectedUncompressedSize;
     return data;
 #endif
 }
@@ -119,26 +100,32 @@ int SaveManager::save(const SimulationSavePayload& payload) {
 }
 
 int SaveManager::saveInternal(const SimulationSavePayload& payload, bool isAutoSave) {
-    m_db->beginTransaction();
+    auto db = m_pool->acquire();
+    db->beginTransaction();
     try {
-        int saveId = upsertSaveSlot(payload, isAutoSave);
+        int saveId = upsertSaveSlot(*db, payload, isAutoSave);
 
-        saveAgents   (saveId, payload.agents);
-        saveResources(saveId, payload.resources);
-        saveEnvironment(saveId, payload);
+        // Child rows don't depend on each other's results — batch them into one pipeline
+        db->beginPipeline();
+        saveAgents   (*db, saveId, payload);
+        saveResources(*db, saveId, payload.resources);
+        saveEnvironment(*db, saveId, payload);
 
         if (payload.stateHistory)
-            saveHistory(saveId, payload.stateHistory);
+            saveHistory(*db, saveId, payload.stateHistory);
+        if (payload.history)
+            saveHistoryBlocks(*db, saveId, *payload.history);
+        db->endPipeline();
 
-        m_db->commitTransaction();
+        db->commitTransaction();
         return saveId;
     } catch (...) {
-        m_db->rollbackTransaction();
+        db->rollbackTransaction();  // Also drains and exits the pipeline
         throw;
     }
 }
 
-int SaveManager::upsertSaveSlot(const SimulationSavePayload& payload, bool isAutoSave) {
+int SaveManager::upsertSaveSlot(DBConnector& db, const SimulationSavePayload& payload, bool isAutoSave) {
     // Tally up fitness and energy totals for the summary row
     double totalEnergy = 0.0;
     double totalFitness = 0.0;
@@ -153,13 +140,13 @@ int SaveManager::upsertSaveSlot(const SimulationSavePayload& payload, bool isAut
     }
 
     // Delete any existing slot with this name (FK cascade removes all child rows)
-    { PGResultGuard del(m_db->execParams("DELETE FROM simulation_saves WHERE slot_name = $1", {payload.slotName})); }
+    { PGResultGuard del(db.execPrepared("sm_delete_slot", kDeleteSlotSql, {payload.slotName})); }
 
-    PGResultGuard ins(m_db->execParams(
+    PGResultGuard ins(db.execPrepared("sm_insert_slot",
         "INSERT INTO simulation_saves "
         "(slot_name, description, tick, real_timestamp, agent_count, resource_count, "
-        " total_energy, average_fitness, is_auto_save, compressed) "
-        "VALUES ($1,$2,$3,$4,$5,$6,$7,$8,$9,$10) "
+        " total_energy, average_fitness, is_auto_save, compressed, genome_codec) "
+        "VALUES ($1,$2,$3,$4,$5,$6,$7,$8,$9,$10,$11) "
         "RETURNING id",
         {
             payload.slotName,
@@ -171,35 +158,84 @@ int SaveManager::upsertSaveSlot(const SimulationSavePayload& payload, bool isAut
             to_string(totalEnergy),
             to_string(avgFitness),
             isAutoSave ? "true" : "false",
-            compressionEnabled() ? "true" : "false"
+            m_codecType != GenomeCodecType::None ? "true" : "false",
+            to_string(static_cast<int>(m_codecType))
         }
     ));
 
     return stoi(ins.val(0, 0));
 }
 
-void SaveManager::saveAgents(int saveId, const vector<AgentSaveData>& agents) {
-    if (agents.empty()) return;
+void SaveManager::saveAgents(DBConnector& db, int saveId, const SimulationSavePayload& payload) {
+    if (payload.agents.empty() && payload.lineage.empty()) return;
 
     const string sql =
         "INSERT INTO simulation_agent_states "
         "(save_id, agent_id, pos_x, pos_y, energy, max_energy, age, "
-        " energy_gained, energy_spent, offspring, fitness, genome_data, genome_length) "
-        "VALUES ($1,$2,$3,$4,$5,$6,$7,$8,$9,$10,$11,$12,$13)";
-
-    for (const auto& a : agents) {
-        // Compress genome before storing; track uncompressed size for decompression hint
-        vector<uint8_t> compressed;
-        size_t uncompressedLen = 0;
-        if (!a.genomeBytes.empty()) {
-            compressed     = compressBytes(a.genomeBytes);
-            uncompressedLen = a.genomeBytes.size();
+        " energy_gained, energy_spent, offspring, fitness, genome_data, genome_length, "
+        " parent_id, generation, genome_is_delta, is_lineage) "
+        "VALUES ($1,$2,$3,$4,$5,$6,$7,$8,$9,$10,$11,$12,$13,$14,$15,$16,$17)";
+
+    // Live agents first, then ancestors kept only as delta bases
+    vector<const AgentSaveData*> rows;
+    rows.reserve(payload.agents.size() + payload.lineage.size());
+    for (const auto& a : payload.agents)  rows.push_back(&a);
+    for (const auto& a : payload.lineage) rows.push_back(&a);
+    const size_t liveCount = payload.agents.size();
+
+    unordered_map<uint64_t, const vector<uint8_t>*> genomeById;
+    genomeById.reserve(rows.size());
+    for (const auto* a : rows)
+        if (!a->genomeBytes.empty()) genomeById.emplace(a->agentId, &a->genomeBytes);
+
+    // Store a child as a sparse diff against its brain parent when that's smaller.
+    // Roots, every Nth generation and children whose parent isn't in this save stay
+    // full, which also caps how long a delta chain can get on load.
+    vector<vector<uint8_t>> deltas(rows.size());
+    vector<const vector<uint8_t>*> stored(rows.size());
+    vector<const vector<uint8_t>*> fullGenomes;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const AgentSaveData& a = *rows[i];
+        stored[i] = &a.genomeBytes;
+
+        bool keyframe = a.parentId < 0 || m_fullGenomeEvery == 0 ||
+                        a.generation % m_fullGenomeEvery == 0;
+        auto parent = keyframe ? genomeById.end()
+                               : genomeById.find(static_cast<uint64_t>(a.parentId));
+        if (!a.genomeBytes.empty() && parent != genomeById.end() &&
+            static_cast<uint64_t>(a.parentId) != a.agentId) {
+            deltas[i] = GenomeDelta::encode(*parent->second, a.genomeBytes, a.genomeBytes.size());
+            if (!deltas[i].empty()) stored[i] = &deltas[i];
         }
+        if (stored[i] == &a.genomeBytes) fullGenomes.push_back(&a.genomeBytes);
+    }
+
+    // Whole population through one codec instance, primed with a dictionary
+    // trained on the full genomes (inheritance makes them near-identical)
+    auto codec = GenomeCodec::create(m_codecType, m_codecLevel);
+    vector<uint8_t> dict = codec->trainDictionary(fullGenomes);
+    if (!dict.empty()) {
+        codec->setDictionary(dict);
+        string p1 = to_string(saveId);
+        const char* vals[2] = { p1.c_str(), reinterpret_cast<const char*>(dict.data()) };
+        int         lens[2] = { 0, static_cast<int>(dict.size()) };
+        int         fmts[2] = { 0, 1 };
+        db.queuePreparedBinary("sm_insert_dictionary",
+            "INSERT INTO simulation_genome_dictionaries (save_id, dictionary) VALUES ($1,$2)",
+            2, vals, lens, fmts);
+    }
+    vector<vector<uint8_t>> blobs = codec->compressBatch(stored);
+
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const AgentSaveData&   a          = *rows[i];
+        const vector<uint8_t>& compressed = blobs[i];
+        size_t uncompressedLen = stored[i]->size();     // Exact output size on load
+        bool   isDelta         = stored[i] != &a.genomeBytes;
 
         // $12 (genome_data) is sent as binary BYTEA, everything else is text
-        const char* paramVals[13];
-        int         paramLens[13];
-        int         paramFmts[13];
+        const char* paramVals[17];
+        int         paramLens[17];
+        int         paramFmts[17];
 
         string p1  = to_string(saveId);         string p2  = to_string(a.agentId);
         string p3  = to_string(a.posX);         string p4  = to_string(a.posY);
@@ -207,6 +243,7 @@ void SaveManager::saveAgents(int saveId, const vector<AgentSaveData>& agents) {
         string p7  = to_string(a.age);          string p8  = to_string(a.energyGained);
         string p9  = to_string(a.energySpent);  string p10 = to_string(a.offspring);
         string p11 = to_string(a.fitness);      string p13 = to_string(uncompressedLen);
+        string p14 = to_string(a.parentId);     string p15 = to_string(a.generation);
 
         paramVals[0]=p1.c_str();  paramLens[0]=0; paramFmts[0]=0;
         paramVals[1]=p2.c_str();  paramLens[1]=0; paramFmts[1]=0;
@@ -229,12 +266,16 @@ void SaveManager::saveAgents(int saveId, const vector<AgentSaveData>& agents) {
         }
 
         paramVals[12]=p13.c_str();paramLens[12]=0;paramFmts[12]=0;
+        paramVals[13]=a.parentId < 0 ? nullptr : p14.c_str(); paramLens[13]=0; paramFmts[13]=0;
+        paramVals[14]=p15.c_str();paramLens[14]=0;paramFmts[14]=0;
+        paramVals[15]=isDelta ? "true" : "false";        paramLens[15]=0; paramFmts[15]=0;
+        paramVals[16]=i >= liveCount ? "true" : "false"; paramLens[16]=0; paramFmts[16]=0;
 
-        PGResultGuard r(m_db->execParamsBinary(sql, 13, paramVals, paramLens, paramFmts));
+        db.queuePreparedBinary("sm_insert_agent", sql, 17, paramVals, paramLens, paramFmts);
     }
 }
 
-void SaveManager::saveResources(int saveId, const vector<ResourceNode*>& resources) {
+void SaveManager::saveResources(DBConnector& db, int saveId, const vector<ResourceNode*>& resources) {
     if (resources.empty()) return;
 
     const string sql =
@@ -246,7 +287,7 @@ void SaveManager::saveResources(int saveId, const vector<ResourceNode*>& resourc
     for (const auto* r : resources) {
         if (!r) continue;
         Position pos = r->getPosition();
-        PGResultGuard ins(m_db->execParams(sql, {
+        db.queuePrepared("sm_insert_resource", sql, {
             to_string(saveId),
             to_string(r->getID()),
             to_string(pos.x),
@@ -256,26 +297,26 @@ void SaveManager::saveResources(int saveId, const vector<ResourceNode*>& resourc
             to_string(r->getMaxEnergy()),
             r->isRenewable() ? "true" : "false",
             "0.0"   // regen_rate — placeholder until ResourceNode exposes it
-        }));
+        });
     }
 }
 
-void SaveManager::saveEnvironment(int saveId, const SimulationSavePayload& payload) {
+void SaveManager::saveEnvironment(DBConnector& db, int saveId, const SimulationSavePayload& payload) {
     const string sql =
         "INSERT INTO simulation_environment_state "
         "(save_id, world_width, world_height, total_energy, extra_data) "
         "VALUES ($1,$2,$3,$4,$5)";
 
-    PGResultGuard ins(m_db->execParams(sql, {
+    db.queuePrepared("sm_insert_environment", sql, {
         to_string(saveId),
         to_string(payload.worldWidth),
         to_string(payload.worldHeight),
         to_string(payload.totalEnergy),
         "{}"   // extensible JSON for future env fields
-    }));
+    });
 }
 
-void SaveManager::saveHistory(int saveId, const CircularBuffer<SimulationState>* hist) {
+void SaveManager::saveHistory(DBConnector& db, int saveId, const CircularBuffer<SimulationState>* hist) {
     if (!hist || hist->empty()) return;
 
     const string sql =
@@ -286,7 +327,7 @@ void SaveManager::saveHistory(int saveId, const CircularBuffer<SimulationState>*
 
     for (size_t i = 0; i < hist->size(); ++i) {
         const SimulationState& s = hist->get(i);
-        PGResultGuard ins(m_db->execParams(sql, {
+        db.queuePrepared("sm_insert_history", sql, {
             to_string(saveId),
             to_string(s.tick),
             to_string(s.timestamp),
@@ -295,14 +336,57 @@ void SaveManager::saveHistory(int saveId, const CircularBuffer<SimulationState>*
             to_string(s.totalResources),
             to_string(s.averageAgentEnergy),
             to_string(s.averageFitness)
-        }));
+        });
     }
 }
 
+// Blocks are already compressed — one BYTEA row each, nothing to re-encode
+void SaveManager::saveHistoryBlocks(DBConnector& db, int saveId, const HistoryStore& history) {
+    const string sql =
+        "INSERT INTO simulation_history_blocks "
+        "(save_id, block_index, first_tick, last_tick, tick_count, data) "
+        "VALUES ($1,$2,$3,$4,$5,$6)";
+
+    string p1 = to_string(saveId);
+    for (size_t i = 0; i < history.blockCount(); ++i) {
+        uint64_t first, last;
+        uint32_t count;
+        history.blockBounds(i, first, last, count);
+        vector<uint8_t> block = history.encodedBlock(i);
+        string p2 = to_string(i);
+        string p3 = to_string(first);
+        string p4 = to_string(last);
+        string p5 = to_string(count);
+
+        const char* vals[6] = { p1.c_str(), p2.c_str(), p3.c_str(), p4.c_str(), p5.c_str(),
+                                reinterpret_cast<const char*>(block.data()) };
+        int         lens[6] = { 0, 0, 0, 0, 0, static_cast<int>(block.size()) };
+        int         fmts[6] = { 0, 0, 0, 0, 0, 1 };
+        db.queuePreparedBinary("sm_insert_history_block", sql, 6, vals, lens, fmts);
+    }
+}
+
+// PostgreSQL text-mode BYTEA comes back as "\xdeadbeef" — decode to raw bytes
+static vector<uint8_t> pgHexDecode(const char* p, int textLen) {
+    vector<uint8_t> out;
+    if (!p || textLen < 2 || p[0] != '\\' || p[1] != 'x') return out;
+    out.reserve((textLen - 2) / 2);
+    auto h = [](char c) -> uint8_t {
+        if (c >= '0' && c <= '9') return static_cast<uint8_t>(c - '0');
+        if (c >= 'a' && c <= 'f') return static_cast<uint8_t>(c - 'a' + 10);
+        if (c >= 'A' && c <= 'F') return static_cast<uint8_t>(c - 'A' + 10);
+        return 0;
+    };
+    for (int i = 2; i + 1 < textLen; i += 2)
+        out.push_back(static_cast<uint8_t>((h(p[i]) << 4) | h(p[i + 1])));
+    return out;
+}
+
 bool SaveManager::load(const string& slotName, SimulationSavePayload& out) {
-    PGResultGuard meta(m_db->execParams(
+    auto db = m_pool->acquire();
+    PGResultGuard meta(db->execPrepared("sm_load_meta",
         "SELECT id, slot_name, description, tick, real_timestamp, "
-        "       agent_count, resource_count, total_energy "
+        "       agent_count, resource_count, total_energy, genome_codec "
         "FROM   simulation_saves "
         "WHERE  slot_name = $1",
         {slotName}
@@ -318,7 +402,7 @@ bool SaveManager::load(const string& slotName, SimulationSavePayload& out) {
     out.totalEnergy    = stod  (meta.val(0, 7));
 
     {
-        PGResultGuard env(m_db->execParams(
+        PGResultGuard env(db->execPrepared("sm_load_environment",
             "SELECT world_width, world_height, total_energy "
             "FROM   simulation_environment_state WHERE save_id = $1",
             {to_string(saveId)}
@@ -330,38 +414,62 @@ bool SaveManager::load(const string& slotName, SimulationSavePayload& out) {
         }
     }
 
-    loadAgents(saveId, out.agents);
-    loadResources(saveId, out);
+    // NULL codec = written before codecs existed, genomes are plain zlib blobs
+    unique_ptr<GenomeCodec> codec;
+    if (!meta.isNull(0, 8)) {
+        codec = GenomeCodec::create(static_cast<GenomeCodecType>(stoi(meta.val(0, 8))));
+        PGResultGuard dict(db->execPrepared("sm_load_dictionary",
+            "SELECT dictionary FROM simulation_genome_dictionaries WHERE save_id = $1",
+            {to_string(saveId)}
+        ));
+        if (dict.rows() > 0)
+            codec->setDictionary(pgHexDecode(dict.rawBytes(0, 0), dict.byteLen(0, 0)));
+    }
+
+    loadAgents(*db, saveId, codec.get(), out);
+    loadResources(*db, saveId, out);
     return true;
 }
 
-// PostgreSQL text-mode BYTEA comes back as "\xdeadbeef" — decode to raw bytes
-static vector<uint8_t> pgHexDecode(const char* p, int textLen) {
-    vector<uint8_t> out;
-    if (!p || textLen < 2 || p[0] != '\\' || p[1] != 'x') return out;
-    out.reserve((textLen - 2) / 2);
-    auto h = [](char c) -> uint8_t {
-        if (c >= '0' && c <= '9') return static_cast<uint8_t>(c - '0');
-        if (c >= 'a' && c <= 'f') return static_cast<uint8_t>(c - 'a' + 10);
-        if (c >= 'A' && c <= 'F') return static_cast<uint8_t>(c - 'A' + 10);
-        return 0;
-    };
-    for (int i = 2; i + 1 < textLen; i += 2)
-        out.push_back(static_cast<uint8_t>((h(p[i]) << 4) | h(p[i + 1])));
-    return out;
+bool SaveManager::loadHistory(const string& slotName, HistoryStore& out,
+                              uint64_t fromTick, uint64_t toTick) {
+    auto db = m_pool->acquire();
+    PGResultGuard meta(db->execPrepared("sm_slot_id",
+        "SELECT id FROM simulation_saves WHERE slot_name = $1", {slotName}));
+    if (meta.rows() == 0) return false;
+
+    // Only blocks overlapping the range leave the database
+    PGResultGuard res(db->execPrepared("sm_load_history_blocks",
+        "SELECT data FROM simulation_history_blocks "
+        "WHERE  save_id = $1 AND last_tick >= $2 AND first_tick <= $3 "
+        "ORDER  BY block_index",
+        {meta.val(0, 0), to_string(fromTick), to_string(min<uint64_t>(toTick, static_cast<uint64_t>(INT64_MAX)))}
+    ));
+
+    out.clear();
+    for (int row = 0; row < res.rows(); ++row) {
+        vector<uint8_t> block = pgHexDecode(res.rawBytes(row, 0), res.byteLen(row, 0));
+        for (const SimulationState& s : HistoryStore::decodeBlock(block))
+            if (s.tick >= fromTick && s.tick <= toTick) out.push(s);
+    }
+    return true;
 }
 
-void SaveManager::loadAgents(int saveId, vector<AgentSaveData>& outAgents) {
-    PGResultGuard res(m_db->execParams(
+void SaveManager::loadAgents(DBConnector& db, int saveId, GenomeCodec* codec,
+                             SimulationSavePayload& out) {
+    PGResultGuard res(db.execPrepared("sm_load_agents",
         "SELECT agent_id, pos_x, pos_y, energy, max_energy, age, "
         "       energy_gained, energy_spent, offspring, fitness, "
-        "       genome_data, genome_length "
+        "       genome_data, genome_length, "
+        "       parent_id, generation, genome_is_delta, is_lineage "
         "FROM   simulation_agent_states "
         "WHERE  save_id = $1 ORDER BY agent_id",
         {to_string(saveId)}
     ));
 
-    outAgents.reserve(static_cast<size_t>(res.rows()));
+    vector<AgentSaveData> rows;
+    vector<bool> isDelta, isLineage;
+    rows.reserve(static_cast<size_t>(res.rows()));
     for (int row = 0; row < res.rows(); ++row) {
         AgentSaveData a;
         a.agentId      = stoull(res.val(row, 0));
@@ -374,8 +482,10 @@ void SaveManager::loadAgents(int saveId, vector<AgentSaveData>& outAgents) {
         a.energySpent  = stod  (res.val(row, 7));
         a.offspring    = stoul (res.val(row, 8));
         a.fitness      = stod  (res.val(row, 9));
+        a.parentId     = res.isNull(row, 12) ? -1 : stoll(res.val(row, 12));
+        a.generation   = static_cast<uint32_t>(stoul(res.val(row, 13)));
 
-        // Decode hex BYTEA text, then decompress
+        // Decode hex BYTEA text, then decompress — deltas are resolved below
         int blobLen = res.byteLen(row, 10);
         if (blobLen > 0 && res.rawBytes(row, 10)) {
             size_t hint = 0;
@@ -384,15 +494,48 @@ void SaveManager::loadAgents(int saveId, vector<AgentSaveData>& outAgents) {
 
             vector<uint8_t> compressed = pgHexDecode(res.rawBytes(row, 10), blobLen);
             if (!compressed.empty())
-                a.genomeBytes = decompressBytes(compressed, hint);
+                a.genomeBytes = codec ? codec->decompress(compressed, hint)
+                                      : decompressBytes(compressed, hint);
         }
 
-        outAgents.push_back(move(a));
+        isDelta.push_back(res.val(row, 14) == "t" || res.val(row, 14) == "true");
+        isLineage.push_back(res.val(row, 15) == "t" || res.val(row, 15) == "true");
+        rows.push_back(move(a));
     }
+
+    // Walk each delta back to its nearest full ancestor, then replay forward.
+    // Resolved rows are marked full, so every chain is only walked once.
+    unordered_map<uint64_t, size_t> rowById;
+    for (size_t i = 0; i < rows.size(); ++i) rowById.emplace(rows[i].agentId, i);
+
+    for (size_t i = 0; i < rows.size(); ++i) {
+        vector<size_t> chain;
+        size_t cur = i;
+        while (isDelta[cur]) {
+            if (chain.size() > rows.size())
+                throw runtime_error("SaveManager::loadAgents: genome delta cycle at agent " +
+                                    to_string(rows[i].agentId));
+            chain.push_back(cur);
+            auto parent = rowById.find(static_cast<uint64_t>(rows[cur].parentId));
+            if (rows[cur].parentId < 0 || parent == rowById.end())
+                throw runtime_error("SaveManager::loadAgents: delta base " +
+                                    to_string(rows[cur].parentId) + " missing from save");
+            cur = parent->second;
+        }
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            size_t child = *it;
+            size_t base  = rowById.at(static_cast<uint64_t>(rows[child].parentId));
+            rows[child].genomeBytes = GenomeDelta::apply(rows[base].genomeBytes, rows[child].genomeBytes);
+            isDelta[child] = false;
+        }
+    }
+
+    for (size_t i = 0; i < rows.size(); ++i)
+        (isLineage[i] ? out.lineage : out.agents).push_back(move(rows[i]));
 }
 
-void SaveManager::loadResources(int saveId, SimulationSavePayload& out) {
-    PGResultGuard res(m_db->execParams(
+void SaveManager::loadResources(DBConnector& db, int saveId, SimulationSavePayload& out) {
+    PGResultGuard res(db.execPrepared("sm_load_resources",
         "SELECT resource_id, pos_x, pos_y, resource_type, "
         "       current_energy, max_energy, renewable "
         "FROM   simulation_resource_states "
@@ -417,10 +560,7 @@ void SaveManager::loadResources(int saveId, SimulationSavePayload& out) {
 }
 
 bool SaveManager::deleteSave(const string& slotName) {
-    PGResultGuard r(m_db->execParams(
-        "DELETE FROM simulation_saves WHERE slot_name = $1",
-        {slotName}
-    ));
+    PGResultGuard r(m_pool->acquire()->execPrepared("sm_delete_slot", kDeleteSlotSql, {slotName}));
     return PQcmdTuples(r) && string(PQcmdTuples(r)) != "0";
 }
 
@@ -450,7 +590,7 @@ static const char* kListSql =
     "ORDER  BY created_at DESC";
 
 vector<SaveSlotInfo> SaveManager::listSaves() const {
-    PGResultGuard r(m_db->execParams(
+    PGResultGuard r(m_pool->acquire()->execPrepared("sm_list_saves",
         "SELECT id, slot_name, description, tick, real_timestamp, "
         "       agent_count, resource_count, total_energy, average_fitness, "
         "       is_auto_save, created_at::text "
@@ -465,7 +605,7 @@ vector<SaveSlotInfo> SaveManager::listSaves() const {
 }
 
 vector<SaveSlotInfo> SaveManager::listAutoSaves() const {
-    PGResultGuard r(m_db->execParams(kListSql, {"true"}));
+    PGResultGuard r(m_pool->acquire()->execPrepared("sm_list_by_kind", kListSql, {"true"}));
     vector<SaveSlotInfo> out;
     out.reserve(static_cast<size_t>(r.rows()));
     for (int i = 0; i < r.rows(); ++i)
@@ -474,7 +614,7 @@ vector<SaveSlotInfo> SaveManager::listAutoSaves() const {
 }
 
 bool SaveManager::slotExists(const string& slotName) const {
-    PGResultGuard r(m_db->execParams(
+    PGResultGuard r(m_pool->acquire()->execPrepared("sm_slot_exists",
         "SELECT 1 FROM simulation_saves WHERE slot_name = $1",
         {slotName}
     ));
@@ -13,6 +13,7 @@
 #include <cassert>
 #include <stdexcept>
 #include <string>
+#include <thread>
 
 using namespace std;
 
@@ -320,6 +321,147 @@ void testConsistencyAfterManyOperations() {
     END_TEST()
 }
 
+// Test 13: SPSC ring rounds capacity up and drops (not overwrites) when full
+void testSpscCapacityAndDrops() {
+    TEST("SpscCircularBuffer - Power-of-two capacity, drop on full")
+
+    CHECK_THROWS(SpscCircularBuffer<int>(0), invalid_argument);
+
+    SpscCircularBuffer<int> ring(5);
+    CHECK(ring.capacity() == 8);
+    CHECK(ring.empty());
+
+    for (int i = 0; i < 8; i++) CHECK(ring.push(i));
+    CHECK(ring.full());
+    CHECK(!ring.push(99));
+    CHECK(ring.dropped() == 1);
+
+    int v = -1;
+    CHECK(ring.pop(v) && v == 0);     // Oldest survived, 99 was the one dropped
+    CHECK(ring.push(8));
+    CHECK(ring.size() == 8);
+
+    END_TEST()
+}
+
+// Test 14: drainTo moves everything into a history buffer in order
+void testSpscDrainTo() {
+    TEST("SpscCircularBuffer - Drain into CircularBuffer")
+
+    SpscCircularBuffer<SimulationState> ring(16);
+    for (uint64_t t = 1; t <= 10; t++) {
+        SimulationState s;
+        s.tick = t;
+        ring.push(s);
+    }
+
+    CircularBuffer<SimulationState> history(4);
+    CHECK(ring.drainTo(history, 3) == 3);
+    CHECK(history.latest().tick == 3);
+    CHECK(ring.drainTo(history) == 7);
+    CHECK(ring.empty());
+    CHECK(history.get(0).tick == 7);
+    CHECK(history.latest().tick == 10);
+
+    SimulationState s;
+    CHECK(!ring.pop(s));
+
+    END_TEST()
+}
+
+// Test 15: One producer thread, one consumer thread, nothing lost or reordered
+void testSpscCrossThread() {
+    TEST("SpscCircularBuffer - Cross-thread FIFO order")
+
+    const uint64_t count = 200000;
+    SpscCircularBuffer<uint64_t> ring(64);
+
+    thread producer([&] {
+        for (uint64_t i = 0; i < count; ) {
+            if (ring.push(i)) i++;
+            else this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    bool inOrder = true;
+    while (expected < count) {
+        uint64_t v;
+        if (ring.pop(v)) {
+            inOrder &= (v == expected);
+            expected++;
+        }
+    }
+    producer.join();
+
+    CHECK(inOrder);
+    CHECK(ring.empty());
+
+    END_TEST()
+}
+
+// Test 16: Static ring matches CircularBuffer's overwrite and rewind behaviour
+void testStaticMatchesDynamic() {
+    TEST("StaticCircularBuffer - Same contents as CircularBuffer")
+
+    StaticCircularBuffer<int, 8> ring;
+    CircularBuffer<int> ref(8);
+    CHECK(ring.capacity() == 8);
+    CHECK_THROWS(ring.latest(), runtime_error);
+    CHECK_THROWS(ring.get(0), out_of_range);
+
+    bool same = true;
+    for (int i = 0; i < 21; i++) {
+        ring.push(i);
+        ref.push(i);
+        same &= ring.size() == ref.size() && ring.latest() == ref.latest();
+        for (size_t k = 0; k < ref.size(); k++) same &= ring[k] == ref.get(k);
+    }
+    CHECK(same);
+    CHECK(ring.full());
+    CHECK(ring.get(0) == 13);
+    CHECK(ring.rewind(2) == 18);
+    CHECK_THROWS(ring.rewind(8), out_of_range);
+
+    ring.clear();
+    CHECK(ring.empty());
+
+    END_TEST()
+}
+
+// Test 17: push_n / copy_out across the wrap point and with oversized input
+void testStaticBulkOps() {
+    TEST("StaticCircularBuffer - push_n and copy_out spans")
+
+    StaticCircularBuffer<int, 8> ring;
+    int a[5] = {1, 2, 3, 4, 5};
+    ring.push_n(a, 5);
+    int b[6] = {6, 7, 8, 9, 10, 11};
+    ring.push_n(b, 6);              // Wraps; 1..3 overwritten
+
+    int out[8] = {};
+    CHECK(ring.copy_out(out) == 8);
+    bool inOrder = true;
+    for (int i = 0; i < 8; i++) inOrder &= out[i] == 4 + i;
+    CHECK(inOrder);
+
+    int big[20];
+    for (int i = 0; i < 20; i++) big[i] = 100 + i;
+    ring.push_n(big, 20);           // Only the last 8 survive
+    CHECK(ring.size() == 8);
+    CHECK(ring.get(0) == 112);
+    CHECK(ring.latest() == 119);
+
+    StaticCircularBuffer<SimulationState, 4> states;
+    SimulationState s;
+    s.tick = 42;
+    states.push(s);
+    SimulationState one[4];
+    CHECK(states.copy_out(one) == 1 && one[0].tick == 42);
+
+    END_TEST()
+}
+
 int main() {
     cout << "========================================" << endl;
     cout << "CIRCULAR BUFFER ADVANCED TEST SUITE" << endl;
@@ -337,6 +479,11 @@ int main() {
     testComplexObjectStorage();
     testIndexAccessPatterns();
     testConsistencyAfterManyOperations();
+    testSpscCapacityAndDrops();
+    testSpscDrainTo();
+    testSpscCrossThread();
+    testStaticMatchesDynamic();
+    testStaticBulkOps();
     
     cout << endl << "========================================" << endl;
     cout << "Results: " << passedTests << "/" << totalTests << " tests passed";
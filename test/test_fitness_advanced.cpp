@@ -12,6 +12,8 @@
 #include <cassert>
 #include <cmath>
 #include <limits>
+#include <random>
+#include <vector>
 
 using namespace std;
 
@@ -368,6 +370,70 @@ void testRealisticLifecycleScenarios() {
     END_TEST()
 }
 
+// Test 13: fastLog stays within its documented error
+void testFastLogAccuracy() {
+    TEST("FitnessCalculator - fastLog accuracy")
+    
+    double worst = 0.0;
+    for (double x = 1.0; x < 1e6; x *= 1.001) {
+        worst = max(worst, abs(FitnessCalculator::fastLog(x) - log(x)));
+    }
+    CHECK(worst < 1e-9);
+    CHECK(FitnessCalculator::fastLog(1.0) == 0.0);
+    
+    END_TEST()
+}
+
+// Test 14: Batch results match the scalar path, edge inputs included
+void testBatchMatchesScalar() {
+    TEST("FitnessCalculator - Batch matches calculateFitness")
+    
+    mt19937 rng(7);
+    uniform_real_distribution<double> u(0.0, 1.0);
+    const size_t n = 1003;    // Odd size exercises any vector tail
+    vector<double> energy(n), maxE(n), gained(n), spent(n), out(n);
+    vector<uint64_t> age(n);
+    vector<uint32_t> offspring(n);
+    for (size_t i = 0; i < n; i++) {
+        energy[i]    = u(rng) * 150.0 - 10.0;
+        maxE[i]      = i % 17 == 0 ? 0.0 : 100.0;
+        gained[i]    = i % 5 == 0 ? 0.0 : u(rng) * 20.0;
+        spent[i]     = i % 7 == 0 ? 0.0 : u(rng) * 20.0;
+        age[i]       = i % 11 == 0 ? 0 : static_cast<uint64_t>(u(rng) * 100000);
+        offspring[i] = static_cast<uint32_t>(u(rng) * 30);
+    }
+    
+    FitnessCalculator::FitnessWeights w;
+    w.survivalWeight = 0.5;
+    FitnessCalculator::calculateFitnessBatch(energy.data(), maxE.data(), age.data(), gained.data(),
+                                             spent.data(), offspring.data(), out.data(), n, w);
+    
+    double worst = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double ref = FitnessCalculator::calculateFitness(energy[i], maxE[i], age[i], gained[i],
+                                                         spent[i], offspring[i], w);
+        worst = max(worst, abs(ref - out[i]));
+    }
+    CHECK(worst < 1e-9);
+    
+    END_TEST()
+}
+
+// Test 15: Top-k gives the same leaders as a full sort
+void testSelectTopK() {
+    TEST("FitnessCalculator - selectTopK")
+    
+    vector<double> f = {0.2, 0.9, 0.5, 0.9, 0.1, 0.7, 0.3};
+    auto top = FitnessCalculator::selectTopK(f.data(), f.size(), 3);
+    CHECK(top.size() == 3);
+    CHECK(top[0] == 1 && top[1] == 3 && top[2] == 5);    // Tie broken by lower index
+    
+    CHECK(FitnessCalculator::selectTopK(f.data(), f.size(), 0).empty());
+    CHECK(FitnessCalculator::selectTopK(f.data(), f.size(), 50).size() == f.size());
+    
+    END_TEST()
+}
+
 int main() {
     cout << "========================================" << endl;
     cout << "FITNESS CALCULATOR ADVANCED TEST SUITE" << endl;
@@ -385,6 +451,9 @@ int main() {
     testWeightSumValidation();
     testPrecisionAndRounding();
     testRealisticLifecycleScenarios();
+    testFastLogAccuracy();
+    testBatchMatchesScalar();
+    testSelectTopK();
     
     cout << endl << "========================================" << endl;
     cout << "Results: " << passedTests << "/" << totalTests << " tests passed";
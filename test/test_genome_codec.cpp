@@ -0,0 +1,257 @@
+/*
+  GenomeCodec / GenomeDelta Tests
+  Coverage: round-trips per codec, shared dictionaries, batch compression, legacy zlib blobs,
+            sparse parent deltas
+  Runs without a database — codecs not compiled into this build are skipped
+*/
+
+#include "../include/genome_codec.h"
+#include "../include/genome_delta.h"
+#include "../include/save_manager.h"
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace std;
+
+int totalTests = 0, passedTests = 0;
+
+#define TEST(name) totalTests++; cout << "[TEST] " << name << "... "; bool ok = true;
+#define CHECK(cond) if (!(cond)) { ok = false; cout << "\n  FAIL at line " << __LINE__ << ": " #cond; }
+#define CHECK_THROWS(expr, exception) try { expr; ok = false; cout << "\n  FAIL at line " << __LINE__ << ": Expected exception not thrown"; } \
+    catch (const exception&) { } catch (...) { ok = false; cout << "\n  FAIL: Wrong exception type"; }
+#define END_TEST() if (ok) { cout << "PASS"; passedTests++; } else { cout << endl; } cout << endl;
+
+// One random founder plus children that each differ in ~1% of bytes, like an inherited population
+static vector<vector<uint8_t>> makePopulation(size_t count, size_t genomeBytes) {
+    mt19937 rng(1234);
+    uniform_int_distribution<int> byte(0, 255);
+    uniform_int_distribution<size_t> pos(0, genomeBytes - 1);
+
+    vector<uint8_t> founder(genomeBytes);
+    for (auto& b : founder) b = static_cast<uint8_t>(byte(rng));
+
+    vector<vector<uint8_t>> pop(count, founder);
+    for (auto& g : pop)
+        for (size_t m = 0; m < genomeBytes / 100; ++m)
+            g[pos(rng)] = static_cast<uint8_t>(byte(rng));
+    return pop;
+}
+
+static vector<const vector<uint8_t>*> pointers(const vector<vector<uint8_t>>& pop) {
+    vector<const vector<uint8_t>*> out;
+    for (const auto& g : pop) out.push_back(&g);
+    return out;
+}
+
+static vector<GenomeCodecType> builtCodecs() {
+    vector<GenomeCodecType> out;
+    for (auto t : {GenomeCodecType::None, GenomeCodecType::Zlib, GenomeCodecType::Zstd})
+        if (GenomeCodec::isAvailable(t)) out.push_back(t);
+    return out;
+}
+
+// Test 1: Every compiled-in codec round-trips with and without a stored size
+void testRoundTrip() {
+    TEST("GenomeCodec - Round-trip for each built codec")
+
+    auto pop = makePopulation(1, 5000);
+    for (auto t : builtCodecs()) {
+        auto codec = GenomeCodec::create(t);
+        CHECK(codec->type() == t);
+        auto blob = codec->compress(pop[0]);
+        CHECK(codec->decompress(blob, pop[0].size()) == pop[0]);
+        CHECK(codec->decompress(blob) == pop[0]);           // No size hint
+        CHECK(codec->compress(nullptr, 0).empty());
+    }
+
+    END_TEST()
+}
+
+// Test 2: Too few samples gives no dictionary
+void testDictionaryNeedsSamples() {
+    TEST("GenomeCodec - Dictionary needs enough samples")
+
+    auto pop = makePopulation(GenomeCodec::kMinDictSamples - 1, 2000);
+    for (auto t : builtCodecs()) {
+        auto codec = GenomeCodec::create(t);
+        CHECK(codec->trainDictionary(pointers(pop)).empty());
+    }
+
+    END_TEST()
+}
+
+// Test 3: A trained dictionary shrinks near-identical genomes and is required to decode them
+void testDictionaryShrinksPopulation() {
+    TEST("GenomeCodec - Shared dictionary shrinks an inherited population")
+
+    auto pop = makePopulation(32, 8000);
+    for (auto t : builtCodecs()) {
+        if (t == GenomeCodecType::None) continue;
+
+        auto plain = GenomeCodec::create(t);
+        size_t plainBytes = 0;
+        for (const auto& g : pop) plainBytes += plain->compress(g).size();
+
+        auto codec = GenomeCodec::create(t);
+        auto dict  = codec->trainDictionary(pointers(pop));
+        CHECK(!dict.empty());
+        codec->setDictionary(dict);
+
+        size_t dictBytes = 0;
+        auto blobs = codec->compressBatch(pointers(pop));
+        for (const auto& b : blobs) dictBytes += b.size();
+        CHECK(dictBytes * 4 < plainBytes);     // Random founder — only the dictionary helps
+
+        // A fresh codec with the same dictionary decodes every row on its own
+        auto reader = GenomeCodec::create(t);
+        reader->setDictionary(dict);
+        for (size_t i = 0; i < pop.size(); ++i)
+            CHECK(reader->decompress(blobs[i], pop[i].size()) == pop[i]);
+
+        // Without the dictionary the rows are unreadable
+        auto noDict = GenomeCodec::create(t);
+        CHECK_THROWS(noDict->decompress(blobs[0], pop[0].size()), GenomeCodecError);
+    }
+
+    END_TEST()
+}
+
+// Test 4: Batch output lines up with input, empty genomes stay empty
+void testBatchAlignment() {
+    TEST("GenomeCodec - Batch output aligns with input")
+
+    auto pop = makePopulation(6, 1000);
+    pop[2].clear();
+    auto codec = GenomeCodec::create(GenomeCodec::bestAvailable());
+    auto blobs = codec->compressBatch(pointers(pop));
+
+    CHECK(blobs.size() == pop.size());
+    CHECK(blobs[2].empty());
+    for (size_t i = 0; i < pop.size(); ++i)
+        if (!pop[i].empty())
+            CHECK(codec->decompress(blobs[i], pop[i].size()) == pop[i]);
+
+    END_TEST()
+}
+
+// Test 5: Wrong stored size is caught instead of returning garbage
+void testSizeMismatchThrows() {
+    TEST("GenomeCodec - Stored size mismatch throws")
+
+    auto pop = makePopulation(1, 500);
+    for (auto t : builtCodecs()) {
+        auto codec = GenomeCodec::create(t);
+        auto blob  = codec->compress(pop[0]);
+        CHECK_THROWS(codec->decompress(blob, pop[0].size() + 7), GenomeCodecError);
+    }
+
+    END_TEST()
+}
+
+// Test 6: Codecs left out of the build are reported, not silently swapped
+void testUnavailableCodecThrows() {
+    TEST("GenomeCodec - Missing codec throws")
+
+    for (auto t : {GenomeCodecType::Zlib, GenomeCodecType::Zstd}) {
+        if (GenomeCodec::isAvailable(t)) continue;
+        CHECK_THROWS(GenomeCodec::create(t), GenomeCodecError);
+    }
+    CHECK(GenomeCodec::isAvailable(GenomeCodec::bestAvailable()));
+
+    END_TEST()
+}
+
+// Test 7: Pre-codec saves (plain zlib blobs) still decode through SaveManager
+void testLegacyBlobs() {
+    TEST("SaveManager - Legacy compressBytes round-trip")
+
+    auto pop  = makePopulation(1, 3000);
+    auto blob = SaveManager::compressBytes(pop[0]);
+    CHECK(SaveManager::decompressBytes(blob, pop[0].size()) == pop[0]);
+    CHECK(SaveManager::decompressBytes(blob) == pop[0]);   // Grows past the 4x guess if needed
+
+    END_TEST()
+}
+
+// Test 8: A sparsely mutated child encodes to a small delta and rebuilds exactly
+void testDeltaSparseChild() {
+    TEST("GenomeDelta - Sparse child round-trip")
+
+    auto pop = makePopulation(2, 80000);      // ~1% of bytes differ from the founder each
+    auto delta = GenomeDelta::encode(pop[0], pop[1]);
+    CHECK(!delta.empty());
+    CHECK(delta.size() * 5 < pop[1].size());
+    CHECK(GenomeDelta::apply(pop[0], delta) == pop[1]);
+
+    // Identical genome collapses to just the header
+    CHECK(GenomeDelta::encode(pop[0], pop[0]).size() < 8);
+    CHECK(GenomeDelta::apply(pop[0], GenomeDelta::encode(pop[0], pop[0])) == pop[0]);
+
+    END_TEST()
+}
+
+// Test 9: Length changes and odd-sized tails survive
+void testDeltaLengthChange() {
+    TEST("GenomeDelta - Child longer / shorter than parent")
+
+    auto pop = makePopulation(1, 1003);
+    vector<uint8_t> longer = pop[0];
+    longer.insert(longer.end(), {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11});
+    vector<uint8_t> shorter(pop[0].begin(), pop[0].begin() + 501);
+
+    CHECK(GenomeDelta::apply(pop[0], GenomeDelta::encode(pop[0], longer))  == longer);
+    CHECK(GenomeDelta::apply(pop[0], GenomeDelta::encode(pop[0], shorter)) == shorter);
+    CHECK(GenomeDelta::apply({}, GenomeDelta::encode({}, pop[0])) == pop[0]);
+
+    END_TEST()
+}
+
+// Test 10: Dense changes fall back to a full genome, bad deltas are rejected
+void testDeltaLimitsAndErrors() {
+    TEST("GenomeDelta - Size cap and malformed input")
+
+    auto a = makePopulation(1, 4000)[0];
+    vector<uint8_t> b(a.size());
+    for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<uint8_t>(a[i] ^ 0x5A);
+    CHECK(GenomeDelta::encode(a, b, b.size()).empty());
+
+    auto delta = GenomeDelta::encode(a, a);
+    vector<uint8_t> badVersion = delta;
+    badVersion[0] = 99;
+    CHECK_THROWS(GenomeDelta::apply(a, badVersion), GenomeCodecError);
+
+    vector<uint8_t> truncated = GenomeDelta::encode(a, makePopulation(2, 4000)[1]);
+    truncated.resize(truncated.size() / 2);
+    CHECK_THROWS(GenomeDelta::apply(a, truncated), GenomeCodecError);
+
+    // Corrupt headers: a child far longer than parent plus changes, and more changes than bytes
+    vector<uint8_t> hugeChild = {GenomeDelta::kVersion, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x00};
+    CHECK_THROWS(GenomeDelta::apply(a, hugeChild), GenomeCodecError);
+    vector<uint8_t> hugeChanged = {GenomeDelta::kVersion, 0x08, 0xFF, 0xFF, 0xFF, 0x0F};
+    CHECK_THROWS(GenomeDelta::apply({}, hugeChanged), GenomeCodecError);
+
+    END_TEST()
+}
+
+int main() {
+    cout << "========================================\n";
+    cout << "  GenomeCodec / GenomeDelta Tests\n";
+    cout << "  Built codecs:";
+    for (auto t : builtCodecs()) cout << " " << GenomeCodec::name(t);
+    cout << "\n========================================\n\n";
+
+    testRoundTrip();
+    testDictionaryNeedsSamples();
+    testDictionaryShrinksPopulation();
+    testBatchAlignment();
+    testSizeMismatchThrows();
+    testUnavailableCodecThrows();
+    testLegacyBlobs();
+    testDeltaSparseChild();
+    testDeltaLengthChange();
+    testDeltaLimitsAndErrors();
+
+    cout << "\n" << passedTests << " / " << totalTests << " tests passed.\n";
+    return (passedTests == totalTests) ? 0 : 1;
+}
@@ -0,0 +1,232 @@
+/*
+  HistoryStore Tests
+  Coverage: hot/cold range reads, block encoding, rollup levels and values, ordering errors
+*/
+
+#include "../include/history_store.h"
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+int totalTests = 0, passedTests = 0;
+
+#define TEST(name) totalTests++; cout << "[TEST] " << name << "... "; bool ok = true;
+#define CHECK(cond) if (!(cond)) { ok = false; cout << "\n  FAIL at line " << __LINE__ << ": " #cond; }
+#define CHECK_THROWS(expr, exception) try { expr; ok = false; cout << "\n  FAIL at line " << __LINE__ << ": Expected exception not thrown"; } \
+    catch (const exception&) { } catch (...) { ok = false; cout << "\n  FAIL: Wrong exception type"; }
+#define END_TEST() if (ok) { cout << "PASS"; passedTests++; } else { cout << endl; } cout << endl;
+
+// Slowly drifting values, the shape a real run produces
+static SimulationState makeState(uint64_t tick) {
+    SimulationState s;
+    s.tick               = tick;
+    s.timestamp          = 1700000000.0 + tick * 0.016;
+    s.totalEnergy        = 5000.0 + 250.0 * sin(tick * 0.01);
+    s.totalResources     = 40 + static_cast<uint32_t>(tick % 7);
+    s.agentCount         = 100 - static_cast<uint32_t>((tick / 50) % 20);
+    s.averageAgentEnergy = 50.0 + (tick % 13) * 0.5;
+    s.averageFitness     = tick * 0.001;
+    s.averageHealth      = 0.8 - (tick % 11) * 0.01;
+    s.varHealth          = 0.002;
+    return s;
+}
+
+static bool sameState(const SimulationState& a, const SimulationState& b) {
+    return a.tick == b.tick && a.timestamp == b.timestamp && a.totalEnergy == b.totalEnergy &&
+           a.totalResources == b.totalResources && a.agentCount == b.agentCount &&
+           a.averageAgentEnergy == b.averageAgentEnergy && a.averageFitness == b.averageFitness &&
+           a.averageHealth == b.averageHealth && a.varHealth == b.varHealth;
+}
+
+// Test 1: Cold blocks give back exactly what was pushed, hot ring serves recent ticks
+void testRangeRoundTrip() {
+    TEST("HistoryStore - Hot and cold range round-trip")
+
+    HistoryStore store(100, 256);
+    for (uint64_t t = 1; t <= 5000; ++t) store.push(makeState(t));
+
+    CHECK(store.size() == 5000);
+    CHECK(store.hot().size() == 100);
+    CHECK(store.blockCount() == 20);            // 19 sealed + the open one
+
+    auto cold = store.range(1000, 1600);       // Spans three blocks
+    CHECK(cold.size() == 601);
+    bool allSame = true;
+    for (size_t i = 0; i < cold.size(); ++i) allSame &= sameState(cold[i], makeState(1000 + i));
+    CHECK(allSame);
+
+    auto hot = store.range(4950, 6000);
+    CHECK(hot.size() == 51);
+    CHECK(hot.back().tick == 5000);
+
+    CHECK(store.range(6000, 7000).empty());
+
+    END_TEST()
+}
+
+// Test 2: Encoded blocks survive a round trip and are much smaller than raw rows
+void testBlockEncoding() {
+    TEST("HistoryStore - Block encode/decode and footprint")
+
+    HistoryStore store(10, 1024);
+    for (uint64_t t = 1; t <= 3000; ++t) store.push(makeState(t));
+
+    auto rows = HistoryStore::decodeBlock(store.encodedBlock(1));
+    CHECK(rows.size() == 1024);
+    CHECK(sameState(rows.front(), makeState(1025)));
+    CHECK(sameState(rows.back(),  makeState(2048)));
+
+    auto open = HistoryStore::decodeBlock(store.encodedBlock(2));   // Partially filled
+    CHECK(open.size() == 3000 - 2048);
+
+    CHECK(store.compressedBytes() * 2 < 3000 * sizeof(SimulationState));
+    CHECK_THROWS(store.encodedBlock(3), out_of_range);
+    CHECK_THROWS(HistoryStore::decodeBlock({1, 2, 3}), runtime_error);
+
+    END_TEST()
+}
+
+// Test 3: Wider ranges drop to coarser rollup levels
+void testLevelSelection() {
+    TEST("HistoryStore - Query picks the rollup level")
+
+    HistoryStore store(100, 512);
+    for (uint64_t t = 1; t <= 20000; ++t) store.push(makeState(t));
+
+    CHECK(store.levelFor(1, 500, 1000)    == 0);
+    CHECK(store.levelFor(1, 5000, 1000)   == 1);
+    CHECK(store.levelFor(1, 20000, 1000)  == 2);
+    CHECK(store.levelFor(1, 20000, 50)    == 2);   // Capped at the coarsest level
+
+    auto raw = store.query(HistoryMetric::AgentCount, 101, 300, 1000);
+    CHECK(raw.size() == 200);
+    CHECK(raw[0].ticks == 1);
+
+    auto tens = store.query(HistoryMetric::AgentCount, 1, 5000, 1000);
+    CHECK(tens.size() == 500);
+    CHECK(tens[0].ticks == 10);
+
+    auto hundreds = store.query(HistoryMetric::AgentCount, 1, 20000, 1000);
+    CHECK(hundreds.size() == 200);
+    CHECK(hundreds[0].ticks == 100);
+
+    END_TEST()
+}
+
+// Test 4: Rollup min/max/mean match a brute-force pass
+void testRollupValues() {
+    TEST("HistoryStore - Rollup min/max/mean")
+
+    HistoryStore store(50, 256);
+    for (uint64_t t = 1; t <= 1000; ++t) store.push(makeState(t));
+
+    auto pts = store.query(HistoryMetric::TotalEnergy, 1, 1000, 10);   // 100x level
+    CHECK(pts.size() == 10);
+
+    const HistorySample& p = pts[3];    // ticks 301..400
+    CHECK(p.firstTick == 301 && p.lastTick == 400);
+    double lo = 1e300, hi = -1e300, sum = 0;
+    for (uint64_t t = 301; t <= 400; ++t) {
+        double v = makeState(t).totalEnergy;
+        lo = min(lo, v); hi = max(hi, v); sum += v;
+    }
+    CHECK(p.min == lo);
+    CHECK(p.max == hi);
+    CHECK(fabs(p.mean - sum / 100.0) < 1e-9);
+
+    END_TEST()
+}
+
+// Test 5: Ticks still filling a bucket show up as a partial last point
+void testPartialBucket() {
+    TEST("HistoryStore - Partial rollup bucket is returned")
+
+    HistoryStore store(50, 256);
+    for (uint64_t t = 1; t <= 1234; ++t) store.push(makeState(t));
+
+    auto pts = store.query(HistoryMetric::AverageFitness, 1, 1234, 20);
+    CHECK(pts.size() == 13);
+    CHECK(pts.back().firstTick == 1201);
+    CHECK(pts.back().lastTick  == 1234);
+    CHECK(pts.back().ticks     == 34);
+
+    uint32_t covered = 0;
+    for (const auto& p : pts) covered += p.ticks;
+    CHECK(covered == 1234);
+
+    END_TEST()
+}
+
+// Test 6: Out-of-order ticks are rejected, clear() starts over
+void testOrderingAndClear() {
+    TEST("HistoryStore - Tick ordering and clear")
+
+    HistoryStore store(10, 64);
+    store.push(makeState(5));
+    CHECK_THROWS(store.push(makeState(5)), invalid_argument);
+    CHECK_THROWS(store.push(makeState(3)), invalid_argument);
+    CHECK_THROWS(HistoryStore(10, 0), invalid_argument);
+
+    store.clear();
+    CHECK(store.empty());
+    CHECK(store.blockCount() == 0);
+    store.push(makeState(1));
+    CHECK(store.firstTick() == 1);
+    CHECK(store.query(HistoryMetric::TotalResources, 0, 10).size() == 1);
+
+    END_TEST()
+}
+
+// Test 7: Blocks written before the population-spread columns still decode
+void testVersion1Blocks() {
+    TEST("HistoryStore - Version 1 blocks decode with zeroed new fields")
+
+    HistoryStore store(10, 64);
+    for (uint64_t t = 1; t <= 40; ++t) store.push(makeState(t));
+    vector<uint8_t> v2 = store.encodedBlock(0);
+
+    // Rewrite as version 1: same header, only the first seven columns
+    const size_t header = 1 + 1 + 4 + 8 + 8;
+    vector<uint8_t> v1(v2.begin(), v2.begin() + header);
+    v1[1] = 1;
+    v1.push_back(7);
+    size_t pos = header + 1;
+    for (int c = 0; c < 7; ++c) {
+        uint32_t len = v2[pos] | (v2[pos + 1] << 8) | (v2[pos + 2] << 16) | (v2[pos + 3] << 24);
+        v1.insert(v1.end(), v2.begin() + pos, v2.begin() + pos + 4 + len);
+        pos += 4 + len;
+    }
+
+    auto rows = HistoryStore::decodeBlock(v1);
+    CHECK(rows.size() == 40);
+    CHECK(rows[9].averageFitness == makeState(10).averageFitness);
+    CHECK(rows[9].averageHealth == 0.0);
+
+    auto pts = store.query(HistoryMetric::AverageHealth, 1, 40);
+    CHECK(pts.size() == 40 && pts[4].mean == makeState(5).averageHealth);
+
+    v1[1] = 9;
+    CHECK_THROWS(HistoryStore::decodeBlock(v1), runtime_error);
+
+    END_TEST()
+}
+
+int main() {
+    cout << "========================================\n";
+    cout << "  HistoryStore Tests\n";
+    cout << "========================================\n\n";
+
+    testRangeRoundTrip();
+    testBlockEncoding();
+    testLevelSelection();
+    testRollupValues();
+    testPartialBucket();
+    testOrderingAndClear();
+    testVersion1Blocks();
+
+    cout << "\n" << passedTests << " / " << totalTests << " tests passed.\n";
+    return (passedTests == totalTests) ? 0 : 1;
+}
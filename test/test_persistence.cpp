@@ -21,10 +21,13 @@
 #include "../include/resource_node.h"
 #include "../include/circular_buffer.h"
 #include "../include/fitness_calculator.h"
+#include "../include/history_store.h"
 
 #include <iostream>
 #include <cassert>
+#include <chrono>
 #include <ctime>
+#include <future>
 #include <memory>
 
 using namespace std;
@@ -180,6 +183,48 @@ void testStateHistoryPersisted() {
     END_TEST()
 }
 
+void testHistoryBlocksRoundTrip() {
+    TEST("SaveManager - HistoryStore blocks round-trip")
+    try {
+        auto db = makeDB();
+        SaveManager sm(db);
+        sm.deleteSave("test_history_blocks");
+
+        HistoryStore history(100, 256);
+        for (uint64_t t = 1; t <= 2000; ++t) {
+            SimulationState s;
+            s.tick        = t;
+            s.agentCount  = static_cast<uint32_t>(50 + t % 9);
+            s.totalEnergy = 10.0 * t;
+            history.push(s);
+        }
+
+        auto payload    = makeTestPayload("test_history_blocks");
+        payload.history = &history;
+        sm.save(payload);
+
+        // Only the blocks overlapping the range come back
+        HistoryStore loaded;
+        CHECK(sm.loadHistory("test_history_blocks", loaded, 700, 900));
+        CHECK(loaded.size() == 201);
+        CHECK(loaded.firstTick() == 700 && loaded.lastTick() == 900);
+        auto rows = loaded.range(800, 800);
+        CHECK(rows.size() == 1 && rows[0].totalEnergy == 8000.0);
+
+        HistoryStore all;
+        CHECK(sm.loadHistory("test_history_blocks", all));
+        CHECK(all.size() == 2000);
+        CHECK(!sm.loadHistory("test_no_such_slot", all));
+
+        sm.deleteSave("test_history_blocks");
+
+    } catch (const exception& e) {
+        ok = false;
+        cout << "\n  Exception: " << e.what();
+    }
+    END_TEST()
+}
+
 void testSlotListing() {
     TEST("SaveManager - slot listing")
     try {
@@ -240,6 +285,171 @@ void testOverwriteSlot() {
     END_TEST()
 }
 
+void testPipelinedBulkSave() {
+    TEST("SaveManager - bulk save spans several pipeline syncs")
+    try {
+        auto params = DBConnectionParams::fromEnv();
+        params.pipelineDepth = 16;  // Force a handful of mid-save syncs
+        auto db = make_shared<DBConnector>(params);
+        SaveManager sm(db);
+        sm.deleteSave("test_pipeline_bulk");
+
+        auto payload = makeTestPayload("test_pipeline_bulk");
+        for (uint64_t i = 3; i <= 100; ++i) {
+            AgentSaveData a;
+            a.agentId = i; a.posX = static_cast<int32_t>(i); a.posY = 1;
+            a.energy = 10.0; a.maxEnergy = 100.0;
+            a.genomeBytes = {static_cast<uint8_t>(i), 0xAB, 0xCD};
+            payload.agents.push_back(a);
+        }
+        sm.save(payload);
+
+        SimulationSavePayload loaded;
+        CHECK(sm.load("test_pipeline_bulk", loaded));
+        CHECK(loaded.agents.size() == 100);
+        CHECK(loaded.agents.back().genomeBytes.size() == 3);
+
+        sm.deleteSave("test_pipeline_bulk");
+        for (auto* r : loaded.resources) delete r;
+
+    } catch (const exception& e) {
+        ok = false;
+        cout << "\n  Exception: " << e.what();
+    }
+    END_TEST()
+}
+
+void testLineageDeltaRoundTrip() {
+    TEST("SaveManager - Delta-encoded lineage round-trip")
+    try {
+        auto db = make_shared<DBConnector>(DBConnectionParams::fromEnv());
+        SaveManager sm(db);
+        sm.deleteSave("test_lineage");
+
+        // Founder (dead, kept as lineage) -> child -> grandchild, each one weight changed
+        vector<uint8_t> genome(8 * 500);
+        for (size_t i = 0; i < genome.size(); ++i) genome[i] = static_cast<uint8_t>(i * 31);
+
+        auto payload = makeTestPayload("test_lineage");
+        payload.agents.clear();
+
+        AgentSaveData founder;
+        founder.agentId = 10; founder.generation = 0; founder.genomeBytes = genome;
+        payload.lineage.push_back(founder);
+
+        AgentSaveData child;
+        child.agentId = 11; child.parentId = 10; child.generation = 1;
+        child.genomeBytes = genome; child.genomeBytes[80] ^= 0xFF;
+        payload.agents.push_back(child);
+
+        AgentSaveData grandchild;
+        grandchild.agentId = 12; grandchild.parentId = 11; grandchild.generation = 2;
+        grandchild.genomeBytes = child.genomeBytes; grandchild.genomeBytes[3999] ^= 0x0F;
+        payload.agents.push_back(grandchild);
+
+        sm.save(payload);
+
+        SimulationSavePayload loaded;
+        CHECK(sm.load("test_lineage", loaded));
+        CHECK(loaded.agents.size() == 2);
+        CHECK(loaded.lineage.size() == 1);
+        CHECK(loaded.lineage[0].genomeBytes == genome);
+        CHECK(loaded.agents[0].genomeBytes == child.genomeBytes);
+        CHECK(loaded.agents[1].genomeBytes == grandchild.genomeBytes);
+        CHECK(loaded.agents[1].parentId == 11);
+        CHECK(loaded.agents[1].generation == 2);
+
+        // Delta rows really are tiny on disk
+        PGResultGuard r(db->execParams(
+            "SELECT a.genome_is_delta, a.genome_length FROM simulation_agent_states a "
+            "JOIN simulation_saves s ON s.id = a.save_id "
+            "WHERE s.slot_name = $1 AND a.agent_id = 12", {"test_lineage"}));
+        CHECK(r.rows() == 1);
+        CHECK(r.val(0, 0) == "t");
+        CHECK(stoi(r.val(0, 1)) < 32);
+
+        sm.deleteSave("test_lineage");
+        for (auto* res : loaded.resources) delete res;
+
+    } catch (const exception& e) {
+        ok = false;
+        cout << "\n  Exception: " << e.what();
+    }
+    END_TEST()
+}
+
+void testPreparedStatementsAfterReconnect() {
+    TEST("DBConnector - prepared statements re-prepare after reconnect")
+    try {
+        auto db = make_shared<DBConnector>(DBConnectionParams::fromEnv());
+        const string sql = "SELECT $1::int + 1";
+
+        PGResultGuard a(db->execPrepared("test_add_one", sql, {"41"}));
+        CHECK(a.val(0, 0) == "42");
+        CHECK(db->isPrepared("test_add_one"));
+
+        db->reconnect();    // New session — the old statement is gone server-side
+        CHECK(!db->isPrepared("test_add_one"));
+
+        PGResultGuard b(db->execPrepared("test_add_one", sql, {"1"}));
+        CHECK(b.val(0, 0) == "2");
+
+        // Same statement under a pipeline: the prepare rides along with the first query
+        db->reconnect();
+        SaveManager sm(db);
+        sm.deleteSave("test_prepared");
+        sm.save(makeTestPayload("test_prepared"));
+        sm.save(makeTestPayload("test_prepared"));  // Second save reuses every statement
+        CHECK(db->isPrepared("sm_insert_agent"));
+        CHECK(sm.slotExists("test_prepared"));
+        sm.deleteSave("test_prepared");
+
+    } catch (const exception& e) {
+        ok = false;
+        cout << "\n  Exception: " << e.what();
+    }
+    END_TEST()
+}
+
+void testPooledConcurrentReads() {
+    TEST("DBConnectionPool - listSaves runs while a save holds a connection")
+    try {
+        auto params = DBConnectionParams::fromEnv();
+        params.poolSize = 2;
+        auto pool = make_shared<DBConnectionPool>(params);
+        SaveManager sm(pool);
+        sm.deleteSave("test_pool_writer");
+        sm.save(makeTestPayload("test_pool_writer"));
+
+        bool overlapped = false;
+        future<vector<SaveSlotInfo>> reader;
+        {
+            // Stands in for a writer mid-save: one connection stays leased the whole time
+            auto held = pool->acquire();
+            reader = async(launch::async, [&] { return sm.listSaves(); });
+
+            // The reader must finish on the second connection before the lease is returned
+            overlapped = reader.wait_for(chrono::seconds(10)) == future_status::ready;
+        }
+        auto slots = reader.get();
+
+        CHECK(overlapped);
+        CHECK(pool->openCount() == 2);
+        bool found = false;
+        for (const auto& s : slots) {
+            if (s.slotName == "test_pool_writer") found = true;
+        }
+        CHECK(found);
+
+        sm.deleteSave("test_pool_writer");
+
+    } catch (const exception& e) {
+        ok = false;
+        cout << "\n  Exception: " << e.what();
+    }
+    END_TEST()
+}
+
 // -------------------------------------------------------
 // main
 // -------------------------------------------------------
@@ -250,8 +460,13 @@ int main() {
     testDBConnection();
     testSaveAndLoad();
     testStateHistoryPersisted();
+    testHistoryBlocksRoundTrip();
     testSlotListing();
     testOverwriteSlot();
+    testPipelinedBulkSave();
+    testPooledConcurrentReads();
+    testPreparedStatementsAfterReconnect();
+    testLineageDeltaRoundTrip();
 
     cout << "\n" << passedTests << " / " << totalTests << " tests passed.\n";
     return (passedTests == totalTests) ? 0 : 1;